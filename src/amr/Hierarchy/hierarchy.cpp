@@ -121,9 +121,8 @@ std::shared_ptr<Patch> Hierarchy::addNewPatch(RefinementInfo const& refineInfo,
     uint32 refinedLevel                = refineInfo.level;
     GridLayout refinedLayout           = buildLayout_(refineInfo);
 
-    uint32 RF = refineInfo.refinementRatio;
-
-    double dt_patch = patchInfo.userTimeStep / std::pow(RF, 2 * refinedLevel);
+    double dt_patch
+        = patchInfo.userTimeStep / std::pow(timeRefinementRatio(patchInfo), refinedLevel);
 
     // we need to build a factory for PatchData to be built
     std::unique_ptr<InitializerFactory> factory{
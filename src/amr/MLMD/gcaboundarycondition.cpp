@@ -41,13 +41,14 @@ void GCABoundaryCondition::applyDensityBC(Field& Ni) const
 
 
 
-void GCABoundaryCondition::applyFluxBC(Ions& ions) const
+void GCABoundaryCondition::applyFluxBC(Ions& ions, uint32 ispe) const
 {
     (void)ions;
+    (void)ispe;
 }
 
 
-void GCABoundaryCondition::applyOutgoingParticleBC(std::vector<Particle>& GCAparticles,
+void GCABoundaryCondition::applyOutgoingParticleBC(ParticleArray& GCAparticles,
                                                    LeavingParticles const& leavingParticles)
 {
     std::vector<uint32> leavingIndexes;
@@ -76,7 +77,7 @@ void GCABoundaryCondition::applyOutgoingParticleBC(std::vector<Particle>& GCApar
     // going to the patch
     for (uint32 ipart : leavingIndexes)
     {
-        const Particle& part = GCAparticles[ipart];
+        Particle const part = GCAparticles[ipart];
 
         if (selector.pick(part, GCALayout_))
         {
@@ -95,7 +96,7 @@ void GCABoundaryCondition::applyOutgoingParticleBC(std::vector<Particle>& GCApar
 
 
 
-void GCABoundaryCondition::applyIncomingParticleBC(std::vector<Particle>& particles,
+void GCABoundaryCondition::applyIncomingParticleBC(ParticleArray& particles,
                                                    std::string const& pusher, double const& dt,
                                                    std::string const& species, bool update) const
 {
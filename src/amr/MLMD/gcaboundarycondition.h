@@ -5,7 +5,7 @@
 
 
 #include "core/BoundaryConditions/boundary_conditions.h"
-#include "data/Plasmas/particles.h"
+#include "data/Plasmas/particlearray.h"
 #include "data/grid/gridlayout.h"
 #include "data/vecfield/vecfield.h"
 
@@ -26,7 +26,7 @@ private:
     GridLayout patchLayout_;
     GridLayout GCALayout_;
 
-    std::vector<Particle> incomingParticleBucket_;
+    ParticleArray incomingParticleBucket_;
 
 public:
     GCABoundaryCondition(GridLayout const& patchLayout, GridLayout const& GCALayout);
@@ -36,16 +36,18 @@ public:
     virtual void applyElectricBC(VecField& E) const override;
     virtual void applyCurrentBC(VecField& J) const override;
     virtual void applyDensityBC(Field& N) const override;
-    virtual void applyFluxBC(Ions& ions) const override;
+    virtual void applyFluxBC(Ions& ions, uint32 ispe) const override;
 
-    virtual void applyOutgoingParticleBC(std::vector<Particle>& GCAparticles,
+    virtual void applyOutgoingParticleBC(ParticleArray& GCAparticles,
                                          LeavingParticles const& leavingParticles) override;
 
-    virtual void applyIncomingParticleBC(std::vector<Particle>& particles,
-                                         std::string const& pusher, double const& dt,
-                                         std::string const& species, bool update) const override;
+    virtual void applyIncomingParticleBC(ParticleArray& particles, std::string const& pusher,
+                                         double const& dt, std::string const& species,
+                                         bool update) const override;
 
-    std::vector<Particle>& incomingBucket() { return incomingParticleBucket_; }
+    virtual bool isPeriodic() const override { return false; }
+
+    ParticleArray& incomingBucket() { return incomingParticleBucket_; }
 
     void resetBucket() { incomingParticleBucket_.clear(); }
 
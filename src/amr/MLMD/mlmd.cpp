@@ -109,15 +109,15 @@ void MLMD::evolve_(Patch& patch, uint32 nbrSteps)
 
 
 
-void evaluateNbrSteps(uint32 refineRatio, uint32& nbrSteps_new)
+void evaluateNbrSteps(PatchInfos const& patchInfos, uint32& nbrSteps_new)
 {
     Logger::Debug << "evaluateNbrSteps(...)\n";
     Logger::Debug.flush();
 
-    uint32 CFL_coef = refineRatio * refineRatio;
-
     // CFL constraint
-    // dt < dx**2
+    // dt < dx**2, or dt < dx with the semi-implicit field solve
+    uint32 CFL_coef = timeRefinementRatio(patchInfos);
+
     nbrSteps_new = CFL_coef;
 
     // dt_new = dt / CFL_coef;
@@ -150,6 +150,10 @@ void MLMD::recursivEvolve_(Patch& patch, uint32 ilevel, uint32 refineRatio, uint
             Logger::Debug << "\t - istep/nbrSteps = " << istep + 1 << " / " << nbrSteps << "\n";
             Logger::Debug.flush();
 
+            // the GCA of all children are refilled from the particles of
+            // this patch, which are indexed by cell once for all of them
+            indexParentParticles_(patch);
+
             // MLMD mecanism step 1
             // loop over children patches
             // trigger: Part BC at tn
@@ -171,7 +175,7 @@ void MLMD::recursivEvolve_(Patch& patch, uint32 ilevel, uint32 refineRatio, uint
             evolve_(patch, 1);
 
             uint32 nbrSteps_new = 0;
-            evaluateNbrSteps(refineRatio, nbrSteps_new);
+            evaluateNbrSteps(patchInfos_, nbrSteps_new);
 
             for (uint32 ik = 0; ik < nbrChildren; ik++)
             {
@@ -217,15 +221,36 @@ void MLMD::initGCAparticlesAndMoments_(Patch& patch)
     Logger::Debug << " GCA initialization: OK\n";
     Logger::Debug.flush();
 
-    // for each species
+    // for each species and the total density, on the ghost nodes of the patch
     computeGCADensityAndFlux_(boundaryCond, patchInfos_.interpOrder);
 
-    computeGCAChargeDensity_(boundaryCond);
     if (PatchBoundaryCondition* condition = dynamic_cast<PatchBoundaryCondition*>(boundaryCond))
         condition->applyDensityBC(patch.data().ions().rho());
 
     if (PatchBoundaryCondition* condition = dynamic_cast<PatchBoundaryCondition*>(boundaryCond))
-        condition->applyFluxBC(patch.data().ions());
+    {
+        Ions& ions = patch.data().ions();
+        for (uint32 ispe = 0; ispe < ions.nbrSpecies(); ++ispe)
+            condition->applyFluxBC(ions, ispe);
+    }
+}
+
+
+
+/**
+ * @brief MLMD::indexParentParticles_ indexes the particles of each species of
+ * 'parentPatch' by cell, so that the GCA refill of each child only visits the
+ * mother particles near its GCA. The index is dropped when the parent particles
+ * are pushed.
+ */
+void MLMD::indexParentParticles_(Patch& parentPatch)
+{
+    Ions& ions = parentPatch.data().ions();
+
+    for (uint32 ispe = 0; ispe < ions.nbrSpecies(); ++ispe)
+    {
+        ions.species(ispe).indexParticleCells(parentPatch.layout());
+    }
 }
 
 
@@ -258,16 +283,6 @@ void MLMD::computeGCADensityAndFlux_(BoundaryCondition* boundaryCondition, uint3
 }
 
 
-void MLMD::computeGCAChargeDensity_(BoundaryCondition* boundaryCondition)
-{
-    if (PatchBoundaryCondition* boundaryCond
-        = dynamic_cast<PatchBoundaryCondition*>(boundaryCondition))
-    {
-        boundaryCond->computeGCAChargeDensity();
-    }
-}
-
-
 /**
  * @brief MLMD::sendCorrectedFieldsToChildrenGCA_
  * This method fills the GCAs of a child patch
@@ -43,9 +43,9 @@ private:
     void updateFieldsWithRefinedSolutions_(Patch& parentPatch);                     // MLMD step 5
 
     void initGCAparticles_(BoundaryCondition* boundaryCondition);
+    void indexParentParticles_(Patch& parentPatch);
 
     void computeGCADensityAndFlux_(BoundaryCondition* boundaryCondition, uint32 order);
-    void computeGCAChargeDensity_(BoundaryCondition* boundaryCondition);
 
     void updateGCA_EMfields_(Patch& childPatch);
 
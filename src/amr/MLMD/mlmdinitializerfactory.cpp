@@ -69,10 +69,13 @@ std::unique_ptr<IonsInitializer> MLMDInitializerFactory::createIonsInitializer()
  *
  * @param ionInit
  * @param selector
+ * @param keepLoadedParticles true when the same parent particles are split
+ * several times, see MLMDParticleInitializer::loadParticles
  */
 void MLMDInitializerFactory::buildIonsInitializer_(IonsInitializer& ionInit,
                                                    std::shared_ptr<ParticleSelector> selector,
-                                                   GridLayout const& targetLayout) const
+                                                   GridLayout const& targetLayout,
+                                                   bool keepLoadedParticles) const
 {
     Ions const& parentIons = parentPatch_->data().ions();
 
@@ -87,11 +90,13 @@ void MLMDInitializerFactory::buildIonsInitializer_(IonsInitializer& ionInit,
 
         Species const& species = parentIons.species(ispe);
 
-        std::unique_ptr<ParticleInitializer> particleInit{new MLMDParticleInitializer{
-            species, selector, std::move(splitting), parentPatch_->layout(), targetLayout}};
+        std::unique_ptr<ParticleInitializer> particleInit{
+            new MLMDParticleInitializer{species, selector, std::move(splitting),
+                                        parentPatch_->layout(), targetLayout, keepLoadedParticles}};
 
         ionInit.masses.push_back(parentIons.species(ispe).mass());
         ionInit.names.push_back(parentIons.species(ispe).name());
+        ionInit.pushIntervals.push_back(parentIons.species(ispe).pushInterval());
         ionInit.particleInitializers.push_back(std::move(particleInit));
     }
 }
@@ -111,7 +116,7 @@ std::unique_ptr<ElectromagInitializer> MLMDInitializerFactory::createElectromagI
     GridLayout const& coarseLayout     = parentPatch_->layout();
 
     // A linear interpolator is enough here (= 1)
-    Interpolator interpolator(1);
+    Interpolator<1> interpolator;
 
     std::unique_ptr<ElectromagInitializer> eminit{
         new ElectromagInitializer{refinedLayout_, "_EMField", "_EMFields"}};
@@ -129,6 +134,12 @@ std::unique_ptr<SolverInitializer> MLMDInitializerFactory::createSolverInitializ
     std::unique_ptr<SolverInitializer> solverInitPtr{new SolverInitializer{}};
     solverInitPtr->pusherType         = pusher_;
     solverInitPtr->interpolationOrder = interpolationOrder_;
+    solverInitPtr->sortEvery          = sortEvery_;
+    solverInitPtr->sortThreshold      = sortThreshold_;
+    solverInitPtr->fieldSubcycles     = fieldSubcycles_;
+    solverInitPtr->predictorChunkSize = predictorChunkSize_;
+    solverInitPtr->solverType         = solverType_;
+    solverInitPtr->fieldSolve         = fieldSolve_;
     return solverInitPtr;
 }
 
@@ -163,7 +174,7 @@ std::unique_ptr<BoundaryCondition> MLMDInitializerFactory::createBoundaryConditi
     Electromag const& parentElectromag = parentPatch_->data().EMfields();
 
     // A linear interpolator is enough here (= 1)
-    Interpolator interpolator(1);
+    Interpolator<1> interpolator;
     GCA refinedGCA{buildGCA(refinedLayout_)};
 
     // We know we are dealing with PatchBoundary objects
@@ -196,7 +207,9 @@ std::unique_ptr<BoundaryCondition> MLMDInitializerFactory::createBoundaryConditi
         std::shared_ptr<ParticleSelector> selector
             = std::make_shared<IsInBoxSelector>(selectionBox);
 
-        buildIonsInitializer_(*ionInitPtr, selector, gcaEdgeLayout);
+        // the GCA particles are refilled at each step of the parent, whose
+        // species pushed every k steps keep the same particles in between
+        buildIonsInitializer_(*ionInitPtr, selector, gcaEdgeLayout, true);
 
         // We need the electromagnetic field on the GCA layout
         // of the adequate Patch boundary
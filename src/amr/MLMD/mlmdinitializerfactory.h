@@ -41,11 +41,18 @@ private:
     uint32 interpolationOrder_;
     std::string pusher_;
     std::vector<std::string> splitMethods_;
+    uint32 sortEvery_;
+    double sortThreshold_;
+    uint32 fieldSubcycles_;
+    uint32 predictorChunkSize_;
+    std::string solverType_;
+    std::string fieldSolve_;
 
     double dt_;
 
     void buildIonsInitializer_(IonsInitializer& ionInit, std::shared_ptr<ParticleSelector> selector,
-                               GridLayout const& targetLayout) const;
+                               GridLayout const& targetLayout,
+                               bool keepLoadedParticles = false) const;
 
     GridLayout getExtendedLayout_(GridLayout const& praLayout) const;
 
@@ -60,6 +67,12 @@ public:
         , interpolationOrder_{patchInfo.interpOrder}
         , pusher_{patchInfo.pusher}
         , splitMethods_{patchInfo.splitStrategies}
+        , sortEvery_{patchInfo.sortEvery}
+        , sortThreshold_{patchInfo.sortThreshold}
+        , fieldSubcycles_{patchInfo.fieldSubcycles}
+        , predictorChunkSize_{patchInfo.predictorChunkSize}
+        , solverType_{patchInfo.solverType}
+        , fieldSolve_{patchInfo.fieldSolve}
         , dt_{dt_patch}
     {
     }
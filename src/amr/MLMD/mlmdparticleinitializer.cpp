@@ -5,14 +5,50 @@
 
 
 
-void MLMDParticleInitializer::loadParticles(std::vector<Particle>& particlesArray) const
+/**
+ * @brief MLMDParticleInitializer::loadParticles appends the children of the
+ * selected mother particles to particlesArray. When the initializer keeps the
+ * loaded particles, the mothers are split again only if the particles of the
+ * source have changed since the last call, otherwise the same children are
+ * appended.
+ */
+void MLMDParticleInitializer::loadParticles(ParticleArray& particlesArray) const
+{
+    if (!keepLoadedParticles_)
+    {
+        split_(particlesArray);
+        return;
+    }
+
+    if (!loadedValid_ || loadedVersion_ != particleSource_.particlesVersion())
+    {
+        loadedParticles_.clear();
+        split_(loadedParticles_);
+
+        loadedVersion_ = particleSource_.particlesVersion();
+        loadedValid_   = true;
+    }
+
+    particlesArray.append(loadedParticles_);
+}
+
+
+
+
+/**
+ * @brief MLMDParticleInitializer::split_ splits the mother particles
+ * picked by the selector and keeps their children in the refined layout.
+ * When the cells of the mother particles are indexed, only the particles of
+ * the cells near the selection box are visited, in the order of a full scan.
+ */
+void MLMDParticleInitializer::split_(ParticleArray& particlesArray) const
 {
     ParticleSelector& motherSelector = *selector_;
     IsInBoxSelector childSelector{refinedLayout_.getBox()};
 
-    // the ParticleInitializer has a private access to the ion of the Parent Patch
-    for (Particle const& mother : particleSource_.particles())
-    {
+    std::vector<Particle> childParticles;
+
+    auto refill = [&](Particle const& mother) {
         // look if the 'big' particle is out but near the PRA domain
         if (motherSelector.pick(mother, coarseLayout_))
         {
@@ -21,20 +57,38 @@ void MLMDParticleInitializer::loadParticles(std::vector<Particle>& particlesArra
             SplittingStrategy::normalizeMotherPosition(coarseLayout_, refinedLayout_, mother,
                                                        normalizedMother);
 
-            std::vector<Particle> childParticles;
             // We need to split particle and grab its children
+            childParticles.clear();
             strategy_->split1D(normalizedMother, childParticles);
 
             // For the considered Species
             // we fill the particle array of the new patch
             for (auto& child : childParticles)
             {
-                // if (isInRefinedBox(refinedLayout_, child))
                 if (childSelector.pick(child, refinedLayout_))
                 {
                     particlesArray.push_back(child);
                 }
             }
         } // end if mother is selected
-    }     // end loop on particles
+    };
+
+
+    ParticleArray const& mothers = particleSource_.particles();
+    Box selectionBox;
+
+    if (particleSource_.hasCellIndex() && motherSelector.boundingBox(selectionBox))
+    {
+        std::vector<uint32> candidates;
+        particleSource_.particlesNearBox(selectionBox, coarseLayout_, candidates);
+
+        for (uint32 iPart : candidates)
+            refill(mothers[iPart]);
+    }
+    else
+    {
+        // the ParticleInitializer has a private access to the ion of the Parent Patch
+        for (Particle const& mother : mothers)
+            refill(mother);
+    }
 }
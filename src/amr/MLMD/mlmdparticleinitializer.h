@@ -23,23 +23,37 @@ private:
     GridLayout coarseLayout_;
     GridLayout refinedLayout_;
 
+    // the children split from the current particles of the source, kept when
+    // the same particles may be split several times (GCA refills)
+    bool keepLoadedParticles_;
+    mutable ParticleArray loadedParticles_;
+    mutable bool loadedValid_;
+    mutable uint64 loadedVersion_;
+
+    void split_(ParticleArray& particlesArray) const;
+
 
 public:
     MLMDParticleInitializer(Species const& particleSource,
                             std::shared_ptr<ParticleSelector> selector,
                             std::unique_ptr<SplittingStrategy> strategy,
-                            GridLayout const& coarseLayout, GridLayout const& refinedLayout)
+                            GridLayout const& coarseLayout, GridLayout const& refinedLayout,
+                            bool keepLoadedParticles = false)
         : particleSource_{particleSource}
         , selector_{selector}
         , strategy_{std::move(strategy)}
         , coarseLayout_{coarseLayout}
         , refinedLayout_{refinedLayout}
+        , keepLoadedParticles_{keepLoadedParticles}
+        , loadedParticles_{}
+        , loadedValid_{false}
+        , loadedVersion_{0}
     {
     }
 
     virtual ~MLMDParticleInitializer() = default;
 
-    virtual void loadParticles(std::vector<Particle>& particles) const override;
+    virtual void loadParticles(ParticleArray& particles) const override;
 };
 
 
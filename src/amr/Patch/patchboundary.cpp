@@ -6,59 +6,68 @@
 
 #include "core/Interpolator/interpolator.h"
 #include "core/Interpolator/particlemesh.h"
+#include "core/pusher/pusherfactory.h"
 
-#include "data/vecfield/vecfieldoperations.h"
+#include "data/vecfield/vecfieldexpression.h"
 
 #include "utilities/particleutilities.h"
 #include <utilities/print/outputs.h>
 
+#include <algorithm>
 #include <iostream>
 
 
 
 void PatchBoundary::initGCAParticles()
 {
-    ions_.resetParticles();
-    ions_.loadParticles();
+    for (uint32 ispe = 0; ispe < nbrSpecies(); ++ispe)
+    {
+        particles_[ispe].clear();
+        ionsInit_->particleInitializers[ispe]->loadParticles(particles_[ispe]);
+    }
 }
 
 
 
-void PatchBoundary::applyElectricBC(VecField& E_patch, GridLayout const& patchLayout) const
+uint32 PatchBoundary::speciesID_(std::string const& name) const
 {
-    // Init E_interp on the GCA
-    VecField E_interp = EMfields_.getE();
+    std::vector<std::string> const& names = ionsInit_->names;
+
+    auto search = std::find(names.begin(), names.end(), name);
+    if (search == names.end())
+        throw std::runtime_error("PatchBoundary - No Such Species");
+
+    return static_cast<uint32>(search - names.begin());
+}
+
 
-    interpolateElectricFieldInTime_(E_interp);
+
+void PatchBoundary::applyElectricBC(VecField& E_patch, GridLayout const& patchLayout) const
+{
+    interpolateElectricFieldInTime_();
 
     switch (patchLayout.nbDimensions())
     {
-        case 1: applyGCAfieldsToPatch1D_(patchLayout, E_patch, E_interp, edge_); break;
+        case 1: applyGCAfieldsToPatch1D_(patchLayout, E_patch, Einterp_, edge_); break;
 
-        case 2: applyGCAfieldsToPatch2D_(patchLayout, E_patch, E_interp, edge_); break;
+        case 2: applyGCAfieldsToPatch2D_(patchLayout, E_patch, Einterp_, edge_); break;
 
-        case 3: applyGCAfieldsToPatch3D_(patchLayout, E_patch, E_interp, edge_); break;
+        case 3: applyGCAfieldsToPatch3D_(patchLayout, E_patch, Einterp_, edge_); break;
     }
 }
 
 
 void PatchBoundary::applyMagneticBC(VecField& B_patch, GridLayout const& patchLayout) const
 {
-    // Init B_interp on the GCA
-    VecField B_interp = EMfields_.getB();
-
-    interpolateMagneticFieldInTime_(B_interp);
-
-    // we update Jtot on the GCA
-    ampere_(B_interp, Jtot_);
+    interpolateMagneticFieldInTime_();
 
     switch (patchLayout.nbDimensions())
     {
-        case 1: applyGCAfieldsToPatch1D_(patchLayout, B_patch, B_interp, edge_); break;
+        case 1: applyGCAfieldsToPatch1D_(patchLayout, B_patch, Binterp_, edge_); break;
 
-        case 2: applyGCAfieldsToPatch2D_(patchLayout, B_patch, B_interp, edge_); break;
+        case 2: applyGCAfieldsToPatch2D_(patchLayout, B_patch, Binterp_, edge_); break;
 
-        case 3: applyGCAfieldsToPatch3D_(patchLayout, B_patch, B_interp, edge_); break;
+        case 3: applyGCAfieldsToPatch3D_(patchLayout, B_patch, Binterp_, edge_); break;
     }
 }
 
@@ -66,6 +75,9 @@ void PatchBoundary::applyMagneticBC(VecField& B_patch, GridLayout const& patchLa
 
 void PatchBoundary::applyCurrentBC(VecField& J_patch, GridLayout const& patchLayout) const
 {
+    // Jtot on the GCA comes with the interpolated B
+    interpolateMagneticFieldInTime_();
+
     switch (patchLayout.nbDimensions())
     {
         case 1: applyGCAfieldsToPatch1D_(patchLayout, J_patch, Jtot_, edge_); break;
@@ -77,21 +89,40 @@ void PatchBoundary::applyCurrentBC(VecField& J_patch, GridLayout const& patchLay
 }
 
 
-void PatchBoundary::interpolateElectricFieldInTime_(VecField& E_interp) const
+void PatchBoundary::interpolateElectricFieldInTime_() const
 {
+    if (EinterpValid_)
+        return;
+
     VecField const& Et1 = EMfields_.getE();
     VecField const& Et2 = correctedEMfields_.getE();
 
-    timeInterpolation(Et1, Et2, E_interp, dtParent_, freeEvolutionTime_);
+    Einterp_      = Et1 + (Et2 - Et1) / dtParent_ * freeEvolutionTime_;
+    EinterpValid_ = true;
 }
 
 
-void PatchBoundary::interpolateMagneticFieldInTime_(VecField& B_interp) const
+void PatchBoundary::interpolateMagneticFieldInTime_() const
 {
+    if (BinterpValid_)
+        return;
+
     VecField const& Bt1 = EMfields_.getB();
     VecField const& Bt2 = correctedEMfields_.getB();
 
-    timeInterpolation(Bt1, Bt2, B_interp, dtParent_, freeEvolutionTime_);
+    Binterp_ = Bt1 + (Bt2 - Bt1) / dtParent_ * freeEvolutionTime_;
+
+    // we update Jtot on the GCA
+    ampere_(Binterp_, Jtot_);
+    BinterpValid_ = true;
+}
+
+
+// the fields interpolated in time are recomputed at the next boundary condition
+void PatchBoundary::invalidateInterpolatedFields_()
+{
+    EinterpValid_ = false;
+    BinterpValid_ = false;
 }
 
 
@@ -222,32 +253,30 @@ void PatchBoundary::applyGCAfieldsToPatch3D_(GridLayout const& patchLayout, VecF
 
 
 
+// the moments of the GCA particles are deposited on the ghost nodes of the
+// patch by depositGCAMoments, and added to the patch moments by the
+// PatchBoundaryCondition, for all the boundaries at once. A single boundary
+// has no moments to apply, calling it is an error.
 void PatchBoundary::applyDensityBC(Field& rhoPatch, GridLayout const& patchLayout) const
 {
-    Field const& rhoGCA = ions_.rho();
-
-    switch (patchLayout.nbDimensions())
-    {
-        case 1: addGCAChargeDensityToPatch1D_(patchLayout, rhoPatch, rhoGCA, edge_); break;
-        case 2: addGCAChargeDensityToPatch2D_(patchLayout, rhoPatch, rhoGCA, edge_); break;
-        case 3: addGCAChargeDensityToPatch3D_(patchLayout, rhoPatch, rhoGCA, edge_); break;
-    }
+    (void)rhoPatch;
+    (void)patchLayout;
+    throw std::runtime_error(
+        "PatchBoundary - the density BC is applied by PatchBoundaryCondition only");
 }
 
 
 
-void PatchBoundary::applyFluxBC(Ions& ionsPatch, GridLayout const& patchLayout) const
+void PatchBoundary::applyFluxBC(Species& species, GridLayout const& patchLayout) const
 {
-    switch (patchLayout.nbDimensions())
-    {
-        case 1: addGCAFluxesToPatch1D_(patchLayout, ionsPatch, ions_, edge_); break;
-        case 2: addGCAFluxesToPatch2D_(patchLayout, ionsPatch, ions_, edge_); break;
-        case 3: addGCAFluxesToPatch3D_(patchLayout, ionsPatch, ions_, edge_); break;
-    }
+    (void)species;
+    (void)patchLayout;
+    throw std::runtime_error(
+        "PatchBoundary - the flux BC is applied by PatchBoundaryCondition only");
 }
 
 
-void PatchBoundary::applyOutgoingParticleBC(std::vector<Particle>& particleArray,
+void PatchBoundary::applyOutgoingParticleBC(ParticleArray& particleArray,
                                             LeavingParticles const& leavingParticles) const
 {
 }
@@ -256,7 +285,7 @@ void PatchBoundary::applyOutgoingParticleBC(std::vector<Particle>& particleArray
 
 /**
  * @brief PatchBoundary::applyIncomingParticleBC
- * Particles selected in member ions_ (of PatchBoundary) will be added
+ * Particles selected in member particles_ (of PatchBoundary) will be added
  * to particleArray table of the patch
  *
  * particleArray contains particles of a given species (of the patch)
@@ -268,15 +297,12 @@ void PatchBoundary::applyOutgoingParticleBC(std::vector<Particle>& particleArray
  */
 void PatchBoundary::applyIncomingParticleBC(BoundaryCondition& temporaryBC, Pusher& pusher,
                                             GridLayout const& patchLayout,
-                                            std::vector<Particle>& particleArray,
+                                            ParticleArray& particleArray,
                                             std::string const& species, bool update)
 {
-    uint32 iesp = ions_.speciesID(species);
+    uint32 iesp = speciesID_(species);
 
-    std::vector<Particle>& GCAparticles = ions_.species(iesp).particles();
-
-    // default initialization
-    std::vector<Particle> temporary_particles{GCAparticles};
+    ParticleArray& GCAparticles = particles_[iesp];
 
     // TODO: define E
     VecField const& E = EMfields_.getE();
@@ -284,31 +310,39 @@ void PatchBoundary::applyIncomingParticleBC(BoundaryCondition& temporaryBC, Push
     // TODO: define B
     VecField const& B = EMfields_.getB();
 
-    // TODO: define interpolator
-    Interpolator interpolator(patchLayout.order());
+    // GCA particles are pushed in place only if we update them, otherwise
+    // out of place into a buffer kept from one step to the next, which the
+    // pusher fills without copying them first
+    if (!update)
+        pushedGCAParticles_.resize(GCAparticles.size());
 
+    ParticleArray& pushedParticles = update ? GCAparticles : pushedGCAParticles_;
+    double mass                    = ionsInit_->masses[iesp];
 
-    if (update)
-    {
-        pusher.move(GCAparticles, GCAparticles, ions_.species(iesp).mass(), E, B, interpolator,
-                    temporaryBC);
-    }
-    else
+    switch (patchLayout.order())
     {
-        pusher.move(GCAparticles, temporary_particles, ions_.species(iesp).mass(), E, B,
-                    interpolator, temporaryBC);
+        case 1:
+            pusher.move(GCAparticles, pushedParticles, mass, E, B, Interpolator<1>{}, temporaryBC);
+            break;
+        case 2:
+            pusher.move(GCAparticles, pushedParticles, mass, E, B, Interpolator<2>{}, temporaryBC);
+            break;
+        case 3:
+            pusher.move(GCAparticles, pushedParticles, mass, E, B, Interpolator<3>{}, temporaryBC);
+            break;
+        case 4:
+            pusher.move(GCAparticles, pushedParticles, mass, E, B, Interpolator<4>{}, temporaryBC);
+            break;
+        default: throw std::runtime_error("PatchBoundary - wrong interpolation order");
     }
 
     try
     {
         GCABoundaryCondition& boundaryCond = dynamic_cast<GCABoundaryCondition&>(temporaryBC);
 
-        std::vector<Particle>& incomingBucket{boundaryCond.incomingBucket()};
+        ParticleArray& incomingBucket{boundaryCond.incomingBucket()};
 
-        for (Particle const& part : incomingBucket)
-        {
-            particleArray.push_back(part);
-        }
+        particleArray.append(incomingBucket);
 
         // we have to reset incoming particle bucket
         // before considering the next species
@@ -325,89 +359,120 @@ void PatchBoundary::applyIncomingParticleBC(BoundaryCondition& temporaryBC, Push
 
 
 /**
- * @brief PatchBoundary::computeGCAmoments
- *
+ * @brief PatchBoundary::gcaBoundaryCondition is the boundary condition used to
+ * push the GCA particles, which collects those entering the patch. It is built
+ * at the first call, 'patchLayout' being the same for all calls.
  */
-void PatchBoundary::computeGCADensityAndFlux(uint32 order)
+BoundaryCondition& PatchBoundary::gcaBoundaryCondition(GridLayout const& patchLayout)
 {
-    uint32 nbrSpecies = ions_.nbrSpecies();
+    if (!gcaBoundaryCondition_)
+        gcaBoundaryCondition_.reset(new GCABoundaryCondition{patchLayout, layout_});
+
+    return *gcaBoundaryCondition_;
+}
 
-    for (uint32 ispe = 0; ispe < nbrSpecies; ++ispe)
-    {
-        Species& species = ions_.species(ispe);
 
-        Interpolator interpolator(order);
 
-        computeChargeDensityAndFlux(interpolator, species, layout_, species.particles());
+
+/**
+ * @brief PatchBoundary::gcaPusher returns the pusher of the GCA particles of
+ * type 'pusherType' and time step 'dt', built at the first call with them
+ */
+Pusher& PatchBoundary::gcaPusher(std::string const& pusherType, double dt)
+{
+    for (std::unique_ptr<Pusher>& pusher : gcaPushers_)
+    {
+        if (pusher->pusherType() == pusherType && pusher->dt() == dt)
+            return *pusher;
     }
+
+    gcaPushers_.push_back(PusherFactory::createPusher(layout_, pusherType, dt));
+
+    return *gcaPushers_.back();
 }
 
 
 
-void PatchBoundary::computeGCAChargeDensity()
+
+/**
+ * @brief PatchBoundary::depositGCAMoments deposits the GCA particles of each
+ * species and appends the moments of the patch nodes they overlap to the ghost
+ * moments of the patch: 'ghostNodes' gets the patch node indexes, and
+ * 'ghostMoments' for each node the total density then the x, y and z fluxes of
+ * each species.
+ */
+void PatchBoundary::depositGCAMoments(uint32 order, GridLayout const& patchLayout,
+                                      std::vector<uint32>& ghostNodes,
+                                      std::vector<double>& ghostMoments)
 {
-    ions_.computeChargeDensity();
+    switch (patchLayout.nbDimensions())
+    {
+        case 1: depositGCAMoments1D_(order, patchLayout, ghostNodes, ghostMoments); break;
+        case 2: throw std::runtime_error("depositGCAMoments 2D : Not Implemented");
+        case 3: throw std::runtime_error("depositGCAMoments 3D : Not Implemented");
+    }
 }
 
 
-void PatchBoundary::addGCAChargeDensityToPatch1D_(GridLayout const& patchLayout, Field& rhoPatch,
-                                                  Field const& rhoGCA, Edge const& edge) const
+
+void PatchBoundary::depositGCAMoments1D_(uint32 order, GridLayout const& patchLayout,
+                                         std::vector<uint32>& ghostNodes,
+                                         std::vector<double>& ghostMoments)
 {
+    uint32 nbrSpe    = nbrSpecies();
+    uint32 nbrValues = 1 + 3 * nbrSpe;
+
     uint32 nbrNodes    = 0;
     uint32 iStartPatch = 0;
     uint32 iStartGCA   = 0;
 
-    getGCAandPatchStartIndexes_(patchLayout, rhoPatch, rhoGCA, edge, Direction::X, nbrNodes,
+    // all the moments are primal, they share the same nodes
+    getGCAandPatchStartIndexes_(patchLayout, HybridQuantity::rho, edge_, Direction::X, nbrNodes,
                                 iStartPatch, iStartGCA);
 
-    // HERE we add !
-    for (uint32 iNode = 0; iNode < nbrNodes; ++iNode)
-    {
-        rhoPatch(iStartPatch + iNode) += rhoGCA(iStartGCA + iNode);
-    }
-}
+    uint32 firstValue = static_cast<uint32>(ghostMoments.size());
+    ghostMoments.resize(firstValue + nbrNodes * nbrValues, 0.);
 
+    for (uint32 iNode = 0; iNode < nbrNodes; ++iNode)
+        ghostNodes.push_back(iStartPatch + iNode);
 
-void PatchBoundary::addGCAFluxesToPatch1D_(GridLayout const& patchLayout, Ions& ionsPatch,
-                                           Ions const& ionsGCA, Edge const& edge) const
-{
-    uint32 iCompX = static_cast<uint32>(Direction::X);
-    uint32 iCompY = static_cast<uint32>(Direction::Y);
-    uint32 iCompZ = static_cast<uint32>(Direction::Z);
-
-    for (uint32 ispe = 0; ispe < ionsPatch.nbrSpecies(); ++ispe)
+    for (uint32 ispe = 0; ispe < nbrSpe; ++ispe)
     {
-        uint32 nbrNodes    = 0;
-        uint32 iStartPatch = 0;
-        uint32 iStartGCA   = 0;
-
-        Species& speciesPatch     = ionsPatch.species(ispe);
-        Species const& speciesGCA = ionsGCA.species(ispe);
-
-        std::array<std::reference_wrapper<Field>, 3> fxyzPatch
-            = {{speciesPatch.flux(iCompX), speciesPatch.flux(iCompY), speciesPatch.flux(iCompZ)}};
-
-        std::array<std::reference_wrapper<Field const>, 3> fxyzGCA
-            = {{speciesGCA.flux(iCompX), speciesGCA.flux(iCompY), speciesGCA.flux(iCompZ)}};
+        ParticleArray const& particles = particles_[ispe];
 
-        for (uint32 ifield = 0; ifield < fxyzPatch.size(); ++ifield)
+        switch (order)
         {
-            Field& fluxPatch     = fxyzPatch[ifield];
-            Field const& fluxGCA = fxyzGCA[ifield];
+            case 1:
+                computeInterleavedMoments(Interpolator<1>{}, layout_, particles, gcaMoments_);
+                break;
+            case 2:
+                computeInterleavedMoments(Interpolator<2>{}, layout_, particles, gcaMoments_);
+                break;
+            case 3:
+                computeInterleavedMoments(Interpolator<3>{}, layout_, particles, gcaMoments_);
+                break;
+            case 4:
+                computeInterleavedMoments(Interpolator<4>{}, layout_, particles, gcaMoments_);
+                break;
+            default: throw std::runtime_error("PatchBoundary - wrong interpolation order");
+        }
 
-            getGCAandPatchStartIndexes_(patchLayout, fluxPatch, fluxGCA, edge, Direction::X,
-                                        nbrNodes, iStartPatch, iStartGCA);
+        for (uint32 iNode = 0; iNode < nbrNodes; ++iNode)
+        {
+            double const* gcaNode = &gcaMoments_.moments()[4 * (iStartGCA + iNode)];
+            double* ghostNode     = &ghostMoments[firstValue + iNode * nbrValues];
 
-            for (uint32 iNode = 0; iNode < nbrNodes; ++iNode)
-                fluxPatch(iStartPatch + iNode) += fluxGCA(iStartGCA + iNode);
+            ghostNode[0] += gcaNode[0];
+            ghostNode[1 + 3 * ispe] = gcaNode[1];
+            ghostNode[2 + 3 * ispe] = gcaNode[2];
+            ghostNode[3 + 3 * ispe] = gcaNode[3];
         }
     }
 }
 
 
 
-void PatchBoundary::getGCAandPatchStartIndexes_(GridLayout const& patchLayout,
-                                                Field const& fieldPatch, Field const& fieldGCA,
+void PatchBoundary::getGCAandPatchStartIndexes_(GridLayout const& patchLayout, HybridQuantity qty,
                                                 Edge const& edge, Direction const& direction,
                                                 uint32& nbrNodes, uint32& iStartPatch,
                                                 uint32& iStartGCA) const
@@ -419,64 +484,18 @@ void PatchBoundary::getGCAandPatchStartIndexes_(GridLayout const& patchLayout,
     nbrNodes = 2 * nbrGhosts + 1;
 
     // Default initialization Edge::Xmin
-    iStartPatch = patchLayout.physicalStartIndex(fieldPatch, direction) - nbrGhosts;
-    iStartGCA   = layout_.physicalEndIndex(fieldGCA, direction) - nbrGhosts;
+    iStartPatch = patchLayout.physicalStartIndex(qty, direction) - nbrGhosts;
+    iStartGCA   = layout_.physicalEndIndex(qty, direction) - nbrGhosts;
 
     if (edge == Edge::Xmax)
     {
-        iStartPatch = patchLayout.physicalEndIndex(fieldPatch, direction) - nbrGhosts;
-        iStartGCA   = layout_.physicalStartIndex(fieldGCA, direction) - nbrGhosts;
+        iStartPatch = patchLayout.physicalEndIndex(qty, direction) - nbrGhosts;
+        iStartGCA   = layout_.physicalStartIndex(qty, direction) - nbrGhosts;
     }
 }
 
 
 
-void PatchBoundary::addGCAChargeDensityToPatch2D_(GridLayout const& patchLayout, Field& rhoPatch,
-                                                  Field const& rhoGCA, Edge const& edge) const
-{
-    (void)patchLayout;
-    (void)rhoPatch;
-    (void)rhoGCA;
-    (void)edge;
-    throw std::runtime_error("addGCAChargeDensityToPatch2D_ : Not Implemented");
-}
-
-
-void PatchBoundary::addGCAFluxesToPatch2D_(GridLayout const& patchLayout, Ions& ionsPatch,
-                                           Ions const& ionsGCA, Edge const& edge) const
-{
-    (void)patchLayout;
-    (void)ionsPatch;
-    (void)ionsGCA;
-    (void)edge;
-    throw std::runtime_error("addGCAFluxesToPatch2D_ : Not Implemented");
-}
-
-
-
-void PatchBoundary::addGCAChargeDensityToPatch3D_(GridLayout const& patchLayout, Field& rhoPatch,
-                                                  Field const& rhoGCA, Edge const& edge) const
-{
-    (void)patchLayout;
-    (void)rhoPatch;
-    (void)rhoGCA;
-    (void)edge;
-    throw std::runtime_error("addGCAChargeDensityToPatch3D_ : Not Implemented");
-}
-
-
-void PatchBoundary::addGCAFluxesToPatch3D_(GridLayout const& patchLayout, Ions& ionsPatch,
-                                           Ions const& ionsGCA, Edge const& edge) const
-{
-    (void)patchLayout;
-    (void)ionsPatch;
-    (void)ionsGCA;
-    (void)edge;
-    throw std::runtime_error("addGCAFluxesToPatch3D_ : Not Implemented");
-}
-
-
-
 void PatchBoundary::updateCorrectedEMfields(GridLayout const& parentLayout,
                                             Electromag const& parentElectromag)
 {
@@ -485,7 +504,7 @@ void PatchBoundary::updateCorrectedEMfields(GridLayout const& parentLayout,
     ElectromagInitializer emInitializer{layout_, "_EMField", "_EMFields"};
 
     // A linear interpolator is enough here (= 1)
-    Interpolator interpolator(1);
+    Interpolator<1> interpolator;
 
     // Now we compute the E and B fields
     // of the ElectromagInitializer
@@ -493,6 +512,7 @@ void PatchBoundary::updateCorrectedEMfields(GridLayout const& parentLayout,
 
     // We now update the correctedEM field of the GCA
     correctedEMfields_.setFields(emInitializer);
+    invalidateInterpolatedFields_();
 }
 
 
@@ -500,16 +520,19 @@ void PatchBoundary::updateCorrectedEMfields(GridLayout const& parentLayout,
 void PatchBoundary::updateEMfields()
 {
     EMfields_ = correctedEMfields_;
+    invalidateInterpolatedFields_();
 }
 
 
 void PatchBoundary::resetFreeEvolutionTime()
 {
     freeEvolutionTime_ = 0.;
+    invalidateInterpolatedFields_();
 }
 
 
 void PatchBoundary::updateFreeEvolutionTime(double dt)
 {
     freeEvolutionTime_ += dt;
+    invalidateInterpolatedFields_();
 }
@@ -2,14 +2,20 @@
 #define PATCHBOUNDARY_H
 
 #include <iostream>
-
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "data/Electromag/electromag.h"
 #include "data/Electromag/electromaginitializer.h"
+#include "data/Plasmas/depositbuffer.h"
 #include "data/Plasmas/ions.h"
 #include "data/Plasmas/ionsinitializer.h"
+#include "data/Plasmas/particlearray.h"
 #include "data/vecfield/vecfield.h"
 
+#include "amr/MLMD/gcaboundarycondition.h"
+
 #include "core/Ampere/ampere.h"
 #include "core/BoundaryConditions/boundary.h"
 #include "core/BoundaryConditions/boundary_conditions.h"
@@ -27,15 +33,31 @@ private:
     GridLayout layout_;
     GridLayout extendedLayout_;
 
-    Ions ions_;
+    // the GCA particles of each species, refilled from the parent patch. Their
+    // moments only matter on the ghost nodes of the patch, where they are
+    // deposited by depositGCAMoments, so the GCA holds no moment field
+    std::unique_ptr<IonsInitializer> ionsInit_;
+    std::vector<ParticleArray> particles_;
+
+    // interleaved moments of one species on the GCA, reused by all species
+    DepositBuffer gcaMoments_;
 
     Electromag EMfields_;
 
-    // Jtot is computed when necessary
+    // Jtot is computed from the interpolated B
     // at any time substep of a refined patch
     Ampere ampere_;
     mutable VecField Jtot_;
 
+    // E and B interpolated in time on the GCA, kept to avoid an allocation
+    // at each boundary condition. They are computed once per substep of the
+    // patch and reused by all the boundary conditions until the clock or the
+    // fields of the parent change, see invalidateInterpolatedFields_
+    mutable VecField Einterp_;
+    mutable VecField Binterp_;
+    mutable bool EinterpValid_;
+    mutable bool BinterpValid_;
+
     Edge edge_;
 
     // corrected EM fields from the parent patch
@@ -45,25 +67,24 @@ private:
     double freeEvolutionTime_;
     double dtParent_;
 
+    // GCA push machinery, built on first use and reused at every step: the
+    // boundary condition collecting the particles entering the patch, one
+    // pusher per pusher type and time step (species pushed every k steps use
+    // k*dt), and the GCA particles pushed when they must not be updated
+    std::unique_ptr<GCABoundaryCondition> gcaBoundaryCondition_;
+    std::vector<std::unique_ptr<Pusher>> gcaPushers_;
+    ParticleArray pushedGCAParticles_;
 
-    void addGCAChargeDensityToPatch1D_(GridLayout const& patchLayout, Field& rhoPatch,
-                                       Field const& rhoGCA, Edge const& edge) const;
-    void addGCAChargeDensityToPatch2D_(GridLayout const& patchLayout, Field& rhoPatch,
-                                       Field const& rhoGCA, Edge const& edge) const;
-    void addGCAChargeDensityToPatch3D_(GridLayout const& patchLayout, Field& rhoPatch,
-                                       Field const& rhoGCA, Edge const& edge) const;
 
-    void addGCAFluxesToPatch1D_(GridLayout const& patchLayout, Ions& ionsPatch, Ions const& ionsGCA,
-                                Edge const& edge) const;
-    void addGCAFluxesToPatch2D_(GridLayout const& patchLayout, Ions& ionsPatch, Ions const& ionsGCA,
-                                Edge const& edge) const;
-    void addGCAFluxesToPatch3D_(GridLayout const& patchLayout, Ions& ionsPatch, Ions const& ionsGCA,
-                                Edge const& edge) const;
+    void depositGCAMoments1D_(uint32 order, GridLayout const& patchLayout,
+                              std::vector<uint32>& ghostNodes, std::vector<double>& ghostMoments);
 
-    void getGCAandPatchStartIndexes_(GridLayout const& patchLayout, Field const& fieldPatch,
-                                     Field const& fieldGCA, Edge const& edge,
-                                     Direction const& direction, uint32& nbrNodes,
-                                     uint32& iStartPatch, uint32& iStartGCA) const;
+    void getGCAandPatchStartIndexes_(GridLayout const& patchLayout, HybridQuantity qty,
+                                     Edge const& edge, Direction const& direction,
+                                     uint32& nbrNodes, uint32& iStartPatch,
+                                     uint32& iStartGCA) const;
+
+    uint32 speciesID_(std::string const& name) const;
 
     Edge findBoundaryEdge_(Box const& gcaBox, Box const& patchBox, uint32 nbDims) const;
     Edge findBoundaryEdge1D_(Box const& gcaBox, Box const& patchBox) const;
@@ -81,8 +102,9 @@ private:
                                                  uint32& nbrNodes, uint32& iStartPatch,
                                                  uint32& iStartGCA) const;
 
-    void interpolateElectricFieldInTime_(VecField& E_interp) const;
-    void interpolateMagneticFieldInTime_(VecField& B_interp) const;
+    void interpolateElectricFieldInTime_() const;
+    void interpolateMagneticFieldInTime_() const;
+    void invalidateInterpolatedFields_();
 
 public:
     PatchBoundary(GridLayout const& layout, GridLayout const& extendedLayout,
@@ -91,7 +113,9 @@ public:
                   double dtParent)
         : layout_{layout}
         , extendedLayout_{extendedLayout}
-        , ions_{layout, std::move(ionsInit)}
+        , ionsInit_{std::move(ionsInit)}
+        , particles_(ionsInit_->nbrSpecies)
+        , gcaMoments_{}
         , EMfields_{std::move(electromagInit)}
         , ampere_{layout}
         , Jtot_{layout.allocSize(HybridQuantity::Ex),
@@ -99,12 +123,15 @@ public:
                 layout.allocSize(HybridQuantity::Ez),
                 {{HybridQuantity::Ex, HybridQuantity::Ey, HybridQuantity::Ez}},
                 "Jtot"}
+        , Einterp_{EMfields_.getE()}
+        , Binterp_{EMfields_.getB()}
+        , EinterpValid_{false}
+        , BinterpValid_{false}
         , edge_{edge}
         , freeEvolutionTime_{0.}
         , dtParent_{dtParent}
     {
         correctedEMfields_ = EMfields_;
-        ampere_(EMfields_.getB(), Jtot_);
     }
 
     virtual ~PatchBoundary() = default;
@@ -112,16 +139,22 @@ public:
     virtual void applyElectricBC(VecField& E, GridLayout const& layout) const override;
     virtual void applyMagneticBC(VecField& B, GridLayout const& layout) const override;
     virtual void applyCurrentBC(VecField& J, GridLayout const& layout) const override;
+
+    // the GCA moments of all the boundaries are applied by PatchBoundaryCondition,
+    // these throw
     virtual void applyDensityBC(Field& J, GridLayout const& layout) const override;
-    virtual void applyFluxBC(Ions& ions, GridLayout const& layout) const override;
+    virtual void applyFluxBC(Species& species, GridLayout const& layout) const override;
 
-    virtual void applyOutgoingParticleBC(std::vector<Particle>& particleArray,
+    virtual void applyOutgoingParticleBC(ParticleArray& particleArray,
                                          LeavingParticles const& leavingParticles) const override;
 
     virtual void applyIncomingParticleBC(BoundaryCondition& temporaryBC, Pusher& pusher,
                                          GridLayout const& patchLayout,
-                                         std::vector<Particle>& particleArray,
-                                         std::string const& species, bool update) override;
+                                         ParticleArray& particleArray, std::string const& species,
+                                         bool update) override;
+
+    BoundaryCondition& gcaBoundaryCondition(GridLayout const& patchLayout);
+    Pusher& gcaPusher(std::string const& pusherType, double dt);
 
     GridLayout const& layout() { return layout_; }
     GridLayout const& layout() const { return layout_; }
@@ -131,8 +164,10 @@ public:
 
     void initGCAParticles();
 
-    void computeGCADensityAndFlux(uint32 orders);
-    void computeGCAChargeDensity();
+    uint32 nbrSpecies() const { return ionsInit_->nbrSpecies; }
+
+    void depositGCAMoments(uint32 order, GridLayout const& patchLayout,
+                           std::vector<uint32>& ghostNodes, std::vector<double>& ghostMoments);
 
     void updateCorrectedEMfields(GridLayout const& parentLayout,
                                  Electromag const& parentElectromag);
@@ -1,13 +1,7 @@
 #include "amr/Patch/patchboundarycondition.h"
 
-#include "amr/MLMD/gcaboundarycondition.h"
-#include "core/pusher/pusherfactory.h"
-
-
 #include "utilities/box.h"
-
-
-#include <algorithm>
+#include "utilities/particleutilities.h"
 
 /**
  * @brief PatchBoundaryCondition::PatchBoundaryCondition
@@ -26,6 +20,9 @@ PatchBoundaryCondition::PatchBoundaryCondition(
     , parent_{coarsePatch}
     , patchLayout_{refinedLayout}
     , boundaries_{std::move(boundaries)}
+    , ghostNodes_{}
+    , ghostMoments_{}
+    , nbrGhostValues_{0}
 {
 }
 
@@ -57,20 +54,21 @@ void PatchBoundaryCondition::initializeGCAparticles()
 
 
 
+/**
+ * @brief PatchBoundaryCondition::computeGCADensityAndFlux deposits the GCA
+ * particles of all the boundaries on the ghost nodes of the patch. These
+ * moments are added to those of the patch by applyDensityBC and applyFluxBC
+ * until the GCA particles are refilled.
+ */
 void PatchBoundaryCondition::computeGCADensityAndFlux(uint32 order)
 {
-    for (auto& boundary : boundaries_)
-    {
-        boundary->computeGCADensityAndFlux(order);
-    }
-}
-
+    ghostNodes_.clear();
+    ghostMoments_.clear();
 
-void PatchBoundaryCondition::computeGCAChargeDensity()
-{
     for (auto& boundary : boundaries_)
     {
-        boundary->computeGCAChargeDensity();
+        boundary->depositGCAMoments(order, patchLayout_, ghostNodes_, ghostMoments_);
+        nbrGhostValues_ = 1 + 3 * boundary->nbrSpecies();
     }
 }
 
@@ -124,85 +122,82 @@ void PatchBoundaryCondition::applyCurrentBC(VecField& J) const
 
 void PatchBoundaryCondition::applyDensityBC(Field& N) const
 {
-    for (auto& boundary : boundaries_)
+    for (uint32 iNode = 0; iNode < ghostNodes_.size(); ++iNode)
     {
-        boundary->applyDensityBC(N, patchLayout_);
+        N(ghostNodes_[iNode]) += ghostMoments_[iNode * nbrGhostValues_];
     }
 }
 
 
 
-void PatchBoundaryCondition::applyFluxBC(Ions& ions) const
+void PatchBoundaryCondition::applyFluxBC(Ions& ions, uint32 ispe) const
 {
-    for (auto& boundary : boundaries_)
+    Species& species = ions.species(ispe);
+
+    Field& fx = species.flux(static_cast<uint32>(Direction::X));
+    Field& fy = species.flux(static_cast<uint32>(Direction::Y));
+    Field& fz = species.flux(static_cast<uint32>(Direction::Z));
+
+    for (uint32 iNode = 0; iNode < ghostNodes_.size(); ++iNode)
     {
-        boundary->applyFluxBC(ions, patchLayout_);
+        double const* flux = &ghostMoments_[iNode * nbrGhostValues_ + 1 + 3 * ispe];
+
+        fx(ghostNodes_[iNode]) += flux[0];
+        fy(ghostNodes_[iNode]) += flux[1];
+        fz(ghostNodes_[iNode]) += flux[2];
     }
 }
 
 
-void PatchBoundaryCondition::applyOutgoingParticleBC(std::vector<Particle>& particleArray,
+void PatchBoundaryCondition::applyOutgoingParticleBC(ParticleArray& particleArray,
                                                      LeavingParticles const& leavingParticles)
 {
     removeOutgoingParticles_(particleArray, leavingParticles);
 }
 
 
-void PatchBoundaryCondition::removeOutgoingParticles_(
-    std::vector<Particle>& particleArray, LeavingParticles const& leavingParticles) const
+void PatchBoundaryCondition::removeOutgoingParticles_(ParticleArray& particleArray,
+                                                      LeavingParticles const& leavingParticles)
 {
     // loop on dimensions of leavingParticles.particleIndicesAtMin/Max
     uint32 nbDims = static_cast<uint32>(leavingParticles.particleIndicesAtMax.size());
-    std::vector<uint32> leavingIndexes;
 
-    // we need to concatenate all leaving particles to remove them all at once
+    // we need to gather all leaving particles to remove them all at once
     // if we don't then leaving indexes won't match leaving particles in the
-    // particle array any more since the remove() operation shuffles the indexes.
+    // particle array any more since the removal shifts the indexes.
+    leavingIndexes_.clear();
+
     for (uint32 dim = 0; dim < nbDims; ++dim)
     {
-        std::vector<int32> const& leavingAtMin = leavingParticles.particleIndicesAtMin[dim];
-        std::vector<int32> const& leavingAtMax = leavingParticles.particleIndicesAtMax[dim];
+        for (int32 iPart : leavingParticles.particleIndicesAtMin[dim])
+            leavingIndexes_.push_back(static_cast<uint32>(iPart));
 
-        leavingIndexes.insert(leavingIndexes.end(), leavingAtMin.begin(), leavingAtMin.end());
-        leavingIndexes.insert(leavingIndexes.end(), leavingAtMax.begin(), leavingAtMax.end());
+        for (int32 iPart : leavingParticles.particleIndicesAtMax[dim])
+            leavingIndexes_.push_back(static_cast<uint32>(iPart));
     }
 
-    // the index array should be sorted
-    std::sort(leavingIndexes.begin(), leavingIndexes.end());
-
-    // in case a particle leaves at more than 1 boundary, e.g. x AND y
-    // its index will be found several times in the concatenated array
-    // so call unique() will locate doubles.
-    auto last = std::unique(leavingIndexes.begin(), leavingIndexes.end());
-
-    // call erase() will remove doubles
-    leavingIndexes.erase(last, leavingIndexes.end());
+    if (leavingIndexes_.empty())
+        return;
 
-    // ok ready to remove particles now.
-    removeParticles(leavingIndexes, particleArray);
+    // a particle leaving at more than 1 boundary, e.g. x AND y, is indexed
+    // several times, removeParticles takes care of it
+    removeParticles(leavingIndexes_, particleArray);
 }
 
 
-void PatchBoundaryCondition::applyIncomingParticleBC(std::vector<Particle>& patchArray,
+void PatchBoundaryCondition::applyIncomingParticleBC(ParticleArray& patchArray,
                                                      std::string const& pusherType,
                                                      double const& dt, std::string const& species,
                                                      bool update) const
 {
     for (auto&& bc : boundaries_)
     {
-        // frozen boundary condition of the GCA
-        // each GCA has its frozen boundaries built here
-        // std::unique_ptr<BoundaryCondition> temporaryBC{
-        //    new DomainBoundaryCondition{bc->extendedLayout(), boundaries}};
-
-        std::unique_ptr<BoundaryCondition> temporaryBC{
-            new GCABoundaryCondition{patchLayout_, bc->layout()}};
-
-        // Declare Pusher
-        std::unique_ptr<Pusher> pusher{PusherFactory::createPusher(bc->layout(), pusherType, dt)};
+        // the GCA boundary condition and pusher are owned by the boundary
+        // and reused from one step to the next
+        BoundaryCondition& gcaBC = bc->gcaBoundaryCondition(patchLayout_);
+        Pusher& pusher           = bc->gcaPusher(pusherType, dt);
 
-        bc->applyIncomingParticleBC(*temporaryBC, *pusher, patchLayout_, patchArray, species,
-                                    update);
+        bc->applyIncomingParticleBC(gcaBC, pusher, patchLayout_, patchArray, species, update);
     }
 }
 
@@ -37,8 +37,18 @@ private:
     // We know we are dealing with PatchBoundary objects
     std::vector<std::unique_ptr<PatchBoundary>> boundaries_;
 
-    void removeOutgoingParticles_(std::vector<Particle>& particleArray,
-                                  LeavingParticles const& leavingParticles) const;
+    // moments of the GCA particles of all the boundaries on the ghost nodes of
+    // the patch: the patch node indexes and, for each of them, the total density
+    // then the x, y and z fluxes of each species
+    std::vector<uint32> ghostNodes_;
+    std::vector<double> ghostMoments_;
+    uint32 nbrGhostValues_;
+
+    // indexes of the particles leaving the patch, kept to avoid reallocating them
+    std::vector<uint32> leavingIndexes_;
+
+    void removeOutgoingParticles_(ParticleArray& particleArray,
+                                  LeavingParticles const& leavingParticles);
 
 public:
     PatchBoundaryCondition(GCA const& refinedGCA, std::shared_ptr<Patch> coarsePatch,
@@ -49,19 +59,21 @@ public:
     virtual void applyElectricBC(VecField& E) const override;
     virtual void applyCurrentBC(VecField& J) const override;
     virtual void applyDensityBC(Field& N) const override;
-    virtual void applyFluxBC(Ions& ions) const override;
+    virtual void applyFluxBC(Ions& ions, uint32 ispe) const override;
 
-    virtual void applyOutgoingParticleBC(std::vector<Particle>& particleArray,
+    virtual void applyOutgoingParticleBC(ParticleArray& particleArray,
                                          LeavingParticles const& leavingParticles) override;
 
-    virtual void applyIncomingParticleBC(std::vector<Particle>& patchArray,
-                                         std::string const& pusherType, double const& dt,
-                                         std::string const& species, bool update) const override;
+    virtual void applyIncomingParticleBC(ParticleArray& patchArray, std::string const& pusherType,
+                                         double const& dt, std::string const& species,
+                                         bool update) const override;
+
+    // the fields of the ghost nodes come from the parent patch
+    virtual bool isPeriodic() const override { return false; }
 
     void initializeGCAparticles();
 
     void computeGCADensityAndFlux(uint32 order);
-    void computeGCAChargeDensity();
 
     void updateCorrectedEMfields(GridLayout const& parentLayout,
                                  Electromag const& parentElectromag);
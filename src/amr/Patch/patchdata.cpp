@@ -35,5 +35,5 @@ uint32 PatchData::population() const
 
 void PatchData::solveStep()
 {
-    solver_.solveStepPPC(EMfields_, ions_, electrons_, *boundaryCondition_);
+    solver_.solveStep(EMfields_, ions_, electrons_, *boundaryCondition_);
 }
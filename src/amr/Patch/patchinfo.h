@@ -14,8 +14,31 @@ struct PatchInfos
     uint32 refinementRatio;
     std::vector<std::string> splitStrategies;
 
+    uint32 sortEvery;
+    double sortThreshold;
+
+    uint32 fieldSubcycles;
+    uint32 predictorChunkSize;
+    std::string solverType;
+    std::string fieldSolve;
+
     double userTimeStep; // base L0 time step
 };
 
 
+
+/**
+ * @brief timeRefinementRatio is the ratio of the time steps of a patch and
+ * of its children. The explicit field solve is limited by the whistler waves,
+ * dt < dx^2, whereas with the semi-implicit one only the particles limit dt,
+ * proportionally to dx.
+ */
+inline uint32 timeRefinementRatio(PatchInfos const& infos)
+{
+    uint32 RF = infos.refinementRatio;
+
+    return infos.fieldSolve == "semiImplicit" ? RF : RF * RF;
+}
+
+
 #endif // PATCHINFO_H
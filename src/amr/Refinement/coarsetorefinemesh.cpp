@@ -96,7 +96,7 @@ Field buildAlignedChildField1D(Field const& childField, GridLayout const& childL
  * @param newLayout
  * @param newE
  */
-void fieldAtRefinedNodes1D(Interpolator& interp, GridLayout const& coarseLayout,
+void fieldAtRefinedNodes1D(Interpolator<1> const& interp, GridLayout const& coarseLayout,
                            VecField const& Fcoarse, GridLayout const& refinedLayout,
                            VecField& Frefined)
 {
@@ -187,7 +187,7 @@ void fieldAtRefinedNodes1D(Interpolator& interp, GridLayout const& coarseLayout,
 
 
 
-void fieldAtRefinedNodes2D(Interpolator& interp, GridLayout const& coarseLayout,
+void fieldAtRefinedNodes2D(Interpolator<1> const& interp, GridLayout const& coarseLayout,
                            VecField const& Fcoarse, GridLayout const& refinedLayout,
                            VecField& Frefined)
 {
@@ -201,7 +201,7 @@ void fieldAtRefinedNodes2D(Interpolator& interp, GridLayout const& coarseLayout,
 
 
 
-void fieldAtRefinedNodes3D(Interpolator& interp, GridLayout const& coarseLayout,
+void fieldAtRefinedNodes3D(Interpolator<1> const& interp, GridLayout const& coarseLayout,
                            VecField const& Fcoarse, GridLayout const& refinedLayout,
                            VecField& Frefined)
 {
@@ -214,7 +214,7 @@ void fieldAtRefinedNodes3D(Interpolator& interp, GridLayout const& coarseLayout,
 }
 
 
-void fieldAtRefinedNodes(Interpolator& interpolator, GridLayout const& coarseLayout,
+void fieldAtRefinedNodes(Interpolator<1> const& interpolator, GridLayout const& coarseLayout,
                          Electromag const& parentElectromag, GridLayout const& refinedLayout,
                          ElectromagInitializer& eminit)
 {
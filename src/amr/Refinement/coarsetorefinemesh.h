@@ -22,7 +22,7 @@ Field buildAlignedChildField1D(Field const& childField, GridLayout const& childL
 
    ---------------------------------------------------------------------------- */
 
-void fieldAtRefinedNodes(Interpolator& interpolator, GridLayout const& coarseLayout,
+void fieldAtRefinedNodes(Interpolator<1> const& interpolator, GridLayout const& coarseLayout,
                          Electromag const& parentElectromag, GridLayout const& refinedLayout,
                          ElectromagInitializer& eminit);
 
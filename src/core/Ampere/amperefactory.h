@@ -7,6 +7,7 @@
 
 #include "ampere.h"
 #include "ampereimpl1d.h"
+#include "ampereimplmultid.h"
 #include "data/grid/gridlayout.h"
 #include "utilities/types.h"
 
@@ -23,7 +24,12 @@ public:
         {
             case 1: ampere = std::unique_ptr<AmpereImpl>(new AmpereImpl1D(layout)); break;
 
-            default: throw std::runtime_error("Error : FaradayFactory - dimension must be 1D");
+            case 2:
+            case 3: ampere = std::unique_ptr<AmpereImpl>(new AmpereImplMultiD(layout)); break;
+
+            default:
+                throw std::runtime_error(
+                    "Error : AmpereFactory - dimension must be either 1D, 2D or 3D");
         }
 
         return ampere;
@@ -0,0 +1,92 @@
+
+#include "utilities/hybridenums.h"
+
+#include "ampereimplmultid.h"
+
+
+
+AmpereImplMultiD::AmpereImplMultiD(GridLayout const& layout)
+    : AmpereImplInternals(layout)
+    , is3D_{layout.nbDimensions() == 3}
+    , dxBy_{layout, HybridQuantity::By, Direction::X}
+    , dxBz_{layout, HybridQuantity::Bz, Direction::X}
+    , dyBx_{layout, HybridQuantity::Bx, Direction::Y}
+    , dyBz_{layout, HybridQuantity::Bz, Direction::Y}
+    , dzBx_{is3D_ ? RowDerivative{layout, HybridQuantity::Bx, Direction::Z} : RowDerivative{}}
+    , dzBy_{is3D_ ? RowDerivative{layout, HybridQuantity::By, Direction::Z} : RowDerivative{}}
+{
+}
+
+
+
+
+/**
+ * @brief AmpereImplMultiD::operator() computes J = curl B on the physical nodes
+ * of each J component
+ */
+void AmpereImplMultiD::operator()(VecField const& B, VecField& Jnew)
+{
+    Field const& Bx = B.component(VecField::VecX);
+    Field const& By = B.component(VecField::VecY);
+    Field const& Bz = B.component(VecField::VecZ);
+
+    Field& Jxnew = Jnew.component(VecField::VecX);
+    Field& Jynew = Jnew.component(VecField::VecY);
+    Field& Jznew = Jnew.component(VecField::VecZ);
+
+
+    // dyBz - dzBy
+    forEachRow(physicalNodes(layout_, HybridQuantity::Jx),
+               [&](uint32 ix, uint32 iy, uint32 iz, uint32 count) {
+                   double dyBz[rowTileSize];
+                   double dzBy[rowTileSize] = {};
+
+                   dyBz_(Bz, ix, iy, iz, count, dyBz);
+                   if (is3D_)
+                       dzBy_(By, ix, iy, iz, count, dzBy);
+
+                   double* jx = &Jxnew(ix, iy, iz);
+
+                   for (uint32 i = 0; i < count; ++i)
+                   {
+                       jx[i] = dyBz[i] - dzBy[i];
+                   }
+               });
+
+
+    // dzBx - dxBz
+    forEachRow(physicalNodes(layout_, HybridQuantity::Jy),
+               [&](uint32 ix, uint32 iy, uint32 iz, uint32 count) {
+                   double dzBx[rowTileSize] = {};
+                   double dxBz[rowTileSize];
+
+                   if (is3D_)
+                       dzBx_(Bx, ix, iy, iz, count, dzBx);
+                   dxBz_(Bz, ix, iy, iz, count, dxBz);
+
+                   double* jy = &Jynew(ix, iy, iz);
+
+                   for (uint32 i = 0; i < count; ++i)
+                   {
+                       jy[i] = dzBx[i] - dxBz[i];
+                   }
+               });
+
+
+    // dxBy - dyBx
+    forEachRow(physicalNodes(layout_, HybridQuantity::Jz),
+               [&](uint32 ix, uint32 iy, uint32 iz, uint32 count) {
+                   double dxBy[rowTileSize];
+                   double dyBx[rowTileSize];
+
+                   dxBy_(By, ix, iy, iz, count, dxBy);
+                   dyBx_(Bx, ix, iy, iz, count, dyBx);
+
+                   double* jz = &Jznew(ix, iy, iz);
+
+                   for (uint32 i = 0; i < count; ++i)
+                   {
+                       jz[i] = dxBy[i] - dyBx[i];
+                   }
+               });
+}
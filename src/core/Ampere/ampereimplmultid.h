@@ -0,0 +1,45 @@
+#ifndef AMPEREIMPLMULTID_H
+#define AMPEREIMPLMULTID_H
+
+#include "ampere.h"
+
+#include "data/grid/gridrows.h"
+
+
+
+/**
+ * @brief AmpereImplMultiD is the Ampere implementation for 2D and 3D layouts.
+ *
+ * Like FaradayImplMultiD, it computes the derivatives of B by rows and combines
+ * them directly into J. In 2D the Z derivatives are zero and are not computed.
+ */
+class AmpereImplMultiD : public AmpereImpl, private AmpereImplInternals
+{
+private:
+    bool is3D_;
+
+    RowDerivative dxBy_;
+    RowDerivative dxBz_;
+    RowDerivative dyBx_;
+    RowDerivative dyBz_;
+    RowDerivative dzBx_;
+    RowDerivative dzBy_;
+
+
+public:
+    AmpereImplMultiD(GridLayout const& layout);
+
+    AmpereImplMultiD(AmpereImplMultiD const& source) = delete;
+    AmpereImplMultiD& operator=(AmpereImplMultiD const& source) = delete;
+
+    AmpereImplMultiD(AmpereImplMultiD&& source) = default;
+    AmpereImplMultiD& operator=(AmpereImplMultiD&& source) = default;
+
+    ~AmpereImplMultiD() = default;
+
+    virtual void operator()(VecField const& B, VecField& Jnew) override;
+};
+
+
+
+#endif // AMPEREIMPLMULTID_H
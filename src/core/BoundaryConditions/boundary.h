@@ -3,7 +3,7 @@
 
 #include "core/BoundaryConditions/boundary_conditions.h"
 #include "core/pusher/pusher.h"
-#include "data/Plasmas/particles.h"
+#include "data/Plasmas/particlearray.h"
 #include "data/grid/gridlayout.h"
 #include "data/vecfield/vecfield.h"
 #include "leavingparticles.h"
@@ -17,20 +17,19 @@
 class Boundary
 {
 public:
-    virtual void applyMagneticBC(VecField& B, GridLayout const& layout) const = 0;
-    virtual void applyElectricBC(VecField& E, GridLayout const& layout) const = 0;
-    virtual void applyCurrentBC(VecField& J, GridLayout const& layout) const  = 0;
-    virtual void applyDensityBC(Field& J, GridLayout const& layout) const     = 0;
-    virtual void applyFluxBC(Ions& ions, GridLayout const& layout) const      = 0;
+    virtual void applyMagneticBC(VecField& B, GridLayout const& layout) const  = 0;
+    virtual void applyElectricBC(VecField& E, GridLayout const& layout) const  = 0;
+    virtual void applyCurrentBC(VecField& J, GridLayout const& layout) const   = 0;
+    virtual void applyDensityBC(Field& J, GridLayout const& layout) const      = 0;
+    virtual void applyFluxBC(Species& species, GridLayout const& layout) const = 0;
 
-    virtual void applyOutgoingParticleBC(std::vector<Particle>& particleArray,
+    virtual void applyOutgoingParticleBC(ParticleArray& particleArray,
                                          LeavingParticles const& leavingParticles) const = 0;
 
     virtual void applyIncomingParticleBC(BoundaryCondition& temporaryBC, Pusher& pusher,
                                          GridLayout const& patchLayout,
-                                         std::vector<Particle>& patchParticles,
-                                         std::string const& species, bool update)
-        = 0;
+                                         ParticleArray& patchParticles, std::string const& species,
+                                         bool update) = 0;
 };
 
 #endif // BOUNDARY_H
@@ -6,7 +6,7 @@
 
 #include "data/Field/field.h"
 #include "data/Plasmas/ions.h"
-#include "data/Plasmas/particles.h"
+#include "data/Plasmas/particlearray.h"
 #include "data/vecfield/vecfield.h"
 #include "leavingparticles.h"
 
@@ -30,15 +30,19 @@ public:
     virtual void applyElectricBC(VecField& E) const = 0;
     virtual void applyCurrentBC(VecField& J) const  = 0;
     virtual void applyDensityBC(Field& N) const     = 0;
-    virtual void applyFluxBC(Ions& ions) const      = 0;
 
-    virtual void applyOutgoingParticleBC(std::vector<Particle>& particleArray,
-                                         LeavingParticles const& leavingParticles)
-        = 0;
+    //! applies the flux boundary condition to the species 'ispe' of 'ions'
+    virtual void applyFluxBC(Ions& ions, uint32 ispe) const = 0;
 
-    virtual void applyIncomingParticleBC(std::vector<Particle>& particles,
-                                         std::string const& pusher, double const& dt,
-                                         std::string const& species, bool update) const = 0;
+    virtual void applyOutgoingParticleBC(ParticleArray& particleArray,
+                                         LeavingParticles const& leavingParticles) = 0;
+
+    virtual void applyIncomingParticleBC(ParticleArray& particles, std::string const& pusher,
+                                         double const& dt, std::string const& species,
+                                         bool update) const = 0;
+
+    //! true if opposite edges are connected, as implicit field solves must then know
+    virtual bool isPeriodic() const = 0;
 };
 
 
@@ -14,10 +14,12 @@
 DomainBoundaryCondition::DomainBoundaryCondition(GridLayout layout,
                                                  std::vector<BoundaryInfo> boundaryInfos)
     : layout_{std::move(layout)}
+    , periodic_{true}
 {
     for (BoundaryInfo boundary : boundaryInfos)
     {
         boundaries_.push_back(DomainBoundaryFactory::makeBoundary(boundary));
+        periodic_ = periodic_ && boundary.second == BoundaryType::Periodic;
     }
 }
 
@@ -61,16 +63,16 @@ void DomainBoundaryCondition::applyDensityBC(Field& Ni) const
 
 
 
-void DomainBoundaryCondition::applyFluxBC(Ions& ions) const
+void DomainBoundaryCondition::applyFluxBC(Ions& ions, uint32 ispe) const
 {
     for (auto&& bc : boundaries_)
     {
-        bc->applyFluxBC(ions, layout_);
+        bc->applyFluxBC(ions.species(ispe), layout_);
     }
 }
 
 
-void DomainBoundaryCondition::applyOutgoingParticleBC(std::vector<Particle>& particleArray,
+void DomainBoundaryCondition::applyOutgoingParticleBC(ParticleArray& particleArray,
                                                       LeavingParticles const& leavingParticles)
 {
     for (auto&& bc : boundaries_)
@@ -80,7 +82,7 @@ void DomainBoundaryCondition::applyOutgoingParticleBC(std::vector<Particle>& par
 }
 
 
-void DomainBoundaryCondition::applyIncomingParticleBC(std::vector<Particle>& particles,
+void DomainBoundaryCondition::applyIncomingParticleBC(ParticleArray& particles,
                                                       std::string const& pusher, double const& dt,
                                                       std::string const& species, bool update) const
 {
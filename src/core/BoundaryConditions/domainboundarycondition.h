@@ -7,7 +7,7 @@
 #include "boundary.h"
 #include "boundary_conditions.h"
 
-#include "data/Plasmas/particles.h"
+#include "data/Plasmas/particlearray.h"
 #include "data/grid/gridlayout.h"
 #include "data/vecfield/vecfield.h"
 
@@ -28,6 +28,7 @@ private:
     // these boundaries know what they are : periodic, etc.
     std::vector<std::unique_ptr<Boundary>> boundaries_;
     GridLayout layout_;
+    bool periodic_;
 
 public:
     //! says what kind of boundary each boundary is
@@ -39,14 +40,16 @@ public:
     virtual void applyElectricBC(VecField& E) const override;
     virtual void applyCurrentBC(VecField& J) const override;
     virtual void applyDensityBC(Field& N) const override;
-    virtual void applyFluxBC(Ions& ions) const override;
+    virtual void applyFluxBC(Ions& ions, uint32 ispe) const override;
 
-    virtual void applyOutgoingParticleBC(std::vector<Particle>& particleArray,
+    virtual void applyOutgoingParticleBC(ParticleArray& particleArray,
                                          LeavingParticles const& leavingParticles) override;
 
-    virtual void applyIncomingParticleBC(std::vector<Particle>& particles,
-                                         std::string const& pusher, double const& dt,
-                                         std::string const& species, bool update) const override;
+    virtual void applyIncomingParticleBC(ParticleArray& particles, std::string const& pusher,
+                                         double const& dt, std::string const& species,
+                                         bool update) const override;
+
+    virtual bool isPeriodic() const override { return periodic_; }
 
     virtual ~DomainBoundaryCondition();
 };
@@ -93,6 +93,21 @@ public:
         }
     }
 
+    //! append the indexes stored in 'other' after ours, in each direction
+    void append(LeavingParticles const& other)
+    {
+        for (uint32 iDim = 0; iDim < particleIndicesAtMin.size(); ++iDim)
+        {
+            std::vector<int32> const& atMin = other.particleIndicesAtMin[iDim];
+            std::vector<int32> const& atMax = other.particleIndicesAtMax[iDim];
+
+            particleIndicesAtMin[iDim].insert(particleIndicesAtMin[iDim].end(), atMin.begin(),
+                                              atMin.end());
+            particleIndicesAtMax[iDim].insert(particleIndicesAtMax[iDim].end(), atMax.begin(),
+                                              atMax.end());
+        }
+    }
+
     std::vector<std::vector<int32>> const& indexesAtMin() const { return particleIndicesAtMin; }
     std::vector<std::vector<int32>> const& indexesAtMax() const { return particleIndicesAtMax; }
 
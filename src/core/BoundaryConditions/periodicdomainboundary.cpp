@@ -114,16 +114,11 @@ void PeriodicDomainBoundary::applyDensityBC(Field& Ni, GridLayout const& layout)
 
 
 
-void PeriodicDomainBoundary::applyFluxBC(Ions& ions, GridLayout const& layout) const
+void PeriodicDomainBoundary::applyFluxBC(Species& species, GridLayout const& layout) const
 {
-    for (uint32 ispe = 0; ispe < ions.nbrSpecies(); ++ispe)
+    for (Field& component : species.flux().components())
     {
-        Species& species = ions.species(ispe);
-
-        for (Field& component : species.flux().components())
-        {
-            makeMomentPeriodic_(component, layout);
-        }
+        makeMomentPeriodic_(component, layout);
     }
 }
 
@@ -204,8 +199,7 @@ void PeriodicDomainBoundary::makeMomentPeriodic3D_(Field& moment, GridLayout con
 
 
 
-void makeParticlesPeriodic(std::vector<Particle>& particleArray,
-                           LeavingParticles const& leavingParticles)
+void makeParticlesPeriodic(ParticleArray& particleArray, LeavingParticles const& leavingParticles)
 {
     // loop on dimensions of leavingParticles.particleIndicesAtMin/Max
     uint32 nbDims = leavingParticles.particleIndicesAtMax.size();
@@ -214,24 +208,25 @@ void makeParticlesPeriodic(std::vector<Particle>& particleArray,
     {
         std::vector<int32> const& leavingAtMin = leavingParticles.particleIndicesAtMin[dim];
         std::vector<int32> const& leavingAtMax = leavingParticles.particleIndicesAtMax[dim];
+        std::vector<int32>& icell              = particleArray.icell(dim);
 
         // loop on all particles leaving at Min
         for (auto index : leavingAtMin)
         {
-            particleArray[index].icell[dim] = leavingParticles.startEndIndices[dim].lastCellIndex;
+            icell[index] = leavingParticles.startEndIndices[dim].lastCellIndex;
         }
 
         // now at max
         for (auto index : leavingAtMax)
         {
-            particleArray[index].icell[dim] = leavingParticles.startEndIndices[dim].firstCellIndex;
+            icell[index] = leavingParticles.startEndIndices[dim].firstCellIndex;
         }
     }
 }
 
 
 
-void PeriodicDomainBoundary::applyOutgoingParticleBC(std::vector<Particle>& particleArray,
+void PeriodicDomainBoundary::applyOutgoingParticleBC(ParticleArray& particleArray,
                                                      LeavingParticles const& leavingParticles) const
 {
     if (edge_ == Edge::Xmin || edge_ == Edge::Ymin || edge_ == Edge::Zmin)
@@ -243,7 +238,7 @@ void PeriodicDomainBoundary::applyOutgoingParticleBC(std::vector<Particle>& part
 
 void PeriodicDomainBoundary::applyIncomingParticleBC(BoundaryCondition& temporaryBC, Pusher& pusher,
                                                      GridLayout const& patchLayout,
-                                                     std::vector<Particle>& patchParticles,
+                                                     ParticleArray& patchParticles,
                                                      std::string const& species, bool update)
 {
 }
@@ -41,14 +41,14 @@ public:
     virtual void applyMagneticBC(VecField& B, GridLayout const& layout) const override;
     virtual void applyCurrentBC(VecField& J, GridLayout const& layout) const override;
     virtual void applyDensityBC(Field& J, GridLayout const& layout) const override;
-    virtual void applyFluxBC(Ions& ions, GridLayout const& layout) const override;
+    virtual void applyFluxBC(Species& species, GridLayout const& layout) const override;
 
-    virtual void applyOutgoingParticleBC(std::vector<Particle>& particleArray,
+    virtual void applyOutgoingParticleBC(ParticleArray& particleArray,
                                          LeavingParticles const& leavingParticles) const override;
     virtual void applyIncomingParticleBC(BoundaryCondition& temporaryBC, Pusher& pusher,
                                          GridLayout const& patchLayout,
-                                         std::vector<Particle>& patchParticles,
-                                         std::string const& species, bool update) override;
+                                         ParticleArray& patchParticles, std::string const& species,
+                                         bool update) override;
 };
 
 
@@ -7,6 +7,7 @@
 
 #include "faraday.h"
 #include "faradayimpl1d.h"
+#include "faradayimplmultid.h"
 
 #include "data/grid/gridlayout.h"
 
@@ -22,11 +23,8 @@ public:
         {
             case 1: return std::unique_ptr<FaradayImpl>(new FaradayImpl1D(dt, layout));
 
-#if 0
             case 2:
-                std::cout << "not yet implemented\n";
-                break;
-#endif
+            case 3: return std::unique_ptr<FaradayImpl>(new FaradayImplMultiD(dt, layout));
 
             default:
                 throw std::runtime_error(
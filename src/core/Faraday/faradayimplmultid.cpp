@@ -0,0 +1,99 @@
+
+#include "utilities/hybridenums.h"
+
+#include "faradayimplmultid.h"
+
+
+
+FaradayImplMultiD::FaradayImplMultiD(double dt, GridLayout const& layout)
+    : FaradayImplInternals(dt, layout)
+    , is3D_{layout.nbDimensions() == 3}
+    , dxEy_{layout, HybridQuantity::Ey, Direction::X}
+    , dxEz_{layout, HybridQuantity::Ez, Direction::X}
+    , dyEx_{layout, HybridQuantity::Ex, Direction::Y}
+    , dyEz_{layout, HybridQuantity::Ez, Direction::Y}
+    , dzEx_{is3D_ ? RowDerivative{layout, HybridQuantity::Ex, Direction::Z} : RowDerivative{}}
+    , dzEy_{is3D_ ? RowDerivative{layout, HybridQuantity::Ey, Direction::Z} : RowDerivative{}}
+{
+}
+
+
+
+
+/**
+ * @brief FaradayImplMultiD::operator() computes Bnew = B - dt curl E on the
+ * physical nodes of each B component. Bnew can be B since each node of Bnew
+ * only depends on the same node of B.
+ */
+void FaradayImplMultiD::operator()(VecField const& E, VecField const& B, VecField& Bnew)
+{
+    Field const& Ex = E.component(VecField::VecX);
+    Field const& Ey = E.component(VecField::VecY);
+    Field const& Ez = E.component(VecField::VecZ);
+    Field const& Bx = B.component(VecField::VecX);
+    Field const& By = B.component(VecField::VecY);
+    Field const& Bz = B.component(VecField::VecZ);
+
+    Field& Bxnew = Bnew.component(VecField::VecX);
+    Field& Bynew = Bnew.component(VecField::VecY);
+    Field& Bznew = Bnew.component(VecField::VecZ);
+
+
+    // Bx - dt (dyEz - dzEy)
+    forEachRow(physicalNodes(layout_, HybridQuantity::Bx),
+               [&](uint32 ix, uint32 iy, uint32 iz, uint32 count) {
+                   double dyEz[rowTileSize];
+                   double dzEy[rowTileSize] = {};
+
+                   dyEz_(Ez, ix, iy, iz, count, dyEz);
+                   if (is3D_)
+                       dzEy_(Ey, ix, iy, iz, count, dzEy);
+
+                   double const* bx = &Bx(ix, iy, iz);
+                   double* bxnew    = &Bxnew(ix, iy, iz);
+
+                   for (uint32 i = 0; i < count; ++i)
+                   {
+                       bxnew[i] = bx[i] - dt_ * (dyEz[i] - dzEy[i]);
+                   }
+               });
+
+
+    // By - dt (dzEx - dxEz)
+    forEachRow(physicalNodes(layout_, HybridQuantity::By),
+               [&](uint32 ix, uint32 iy, uint32 iz, uint32 count) {
+                   double dzEx[rowTileSize] = {};
+                   double dxEz[rowTileSize];
+
+                   if (is3D_)
+                       dzEx_(Ex, ix, iy, iz, count, dzEx);
+                   dxEz_(Ez, ix, iy, iz, count, dxEz);
+
+                   double const* by = &By(ix, iy, iz);
+                   double* bynew    = &Bynew(ix, iy, iz);
+
+                   for (uint32 i = 0; i < count; ++i)
+                   {
+                       bynew[i] = by[i] - dt_ * (dzEx[i] - dxEz[i]);
+                   }
+               });
+
+
+    // Bz - dt (dxEy - dyEx)
+    forEachRow(physicalNodes(layout_, HybridQuantity::Bz),
+               [&](uint32 ix, uint32 iy, uint32 iz, uint32 count) {
+                   double dxEy[rowTileSize];
+                   double dyEx[rowTileSize];
+
+                   dxEy_(Ey, ix, iy, iz, count, dxEy);
+                   dyEx_(Ex, ix, iy, iz, count, dyEx);
+
+                   double const* bz = &Bz(ix, iy, iz);
+                   double* bznew    = &Bznew(ix, iy, iz);
+
+                   for (uint32 i = 0; i < count; ++i)
+                   {
+                       bznew[i] = bz[i] - dt_ * (dxEy[i] - dyEx[i]);
+                   }
+               });
+}
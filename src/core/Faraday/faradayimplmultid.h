@@ -0,0 +1,48 @@
+#ifndef FARADAYIMPLMULTID_H
+#define FARADAYIMPLMULTID_H
+
+
+#include "faraday.h"
+
+#include "data/grid/gridrows.h"
+
+
+
+/**
+ * @brief FaradayImplMultiD is the Faraday implementation for 2D and 3D layouts.
+ *
+ * It works by rows of the contiguous direction (see gridrows.h): the
+ * derivatives of E are computed in row buffers and directly combined into
+ * Bnew, without whole derivative fields. In 2D the Z derivatives are zero and
+ * are not computed.
+ */
+class FaradayImplMultiD : public FaradayImpl, private FaradayImplInternals
+{
+private:
+    bool is3D_;
+
+    RowDerivative dxEy_;
+    RowDerivative dxEz_;
+    RowDerivative dyEx_;
+    RowDerivative dyEz_;
+    RowDerivative dzEx_;
+    RowDerivative dzEy_;
+
+
+public:
+    FaradayImplMultiD(double dt, GridLayout const& layout);
+
+    FaradayImplMultiD(FaradayImplMultiD const& source) = delete;
+    FaradayImplMultiD& operator=(FaradayImplMultiD const& source) = delete;
+
+    FaradayImplMultiD(FaradayImplMultiD&& source) = default;
+    FaradayImplMultiD& operator=(FaradayImplMultiD&& source) = default;
+
+    ~FaradayImplMultiD() = default;
+
+    virtual void operator()(VecField const& E, VecField const& B, VecField& Bnew) override;
+};
+
+
+
+#endif // FARADAYIMPLMULTID_H
@@ -76,10 +76,38 @@ public:
     }
 
 
+    /**
+     * @brief IndexesAndWeights::indexes is the compile-time counterpart of
+     * computeIndexes, used by the Interpolator to fill a fixed size index list
+     */
+    template<uint32 order, typename IndexList>
+    static inline void indexes(double reducedCoord, IndexList& indexList)
+    {
+        uint64 i_min
+            = static_cast<uint64>((reducedCoord - (static_cast<double>(order) - 1.) / 2.));
+
+        for (uint64 ik = 0; ik < order + 1; ik++)
+        {
+            indexList[ik] = i_min + ik;
+        }
+    }
+
+
     // this method depends on the interpolation order
     virtual void computeWeights(double reducedCoord, std::vector<uint32> const& indexList,
                                 std::vector<double>& weightList)
         = 0;
 };
 
+
+
+/**
+ * @brief IndexesAndWeightsOfOrder<order>::type is the IndexesAndWeights
+ * subclass whose static weights() kernel computes the weights at that order.
+ * It is specialized in each indexesandweightsoX.h header.
+ */
+template<uint32 order>
+struct IndexesAndWeightsOfOrder;
+
+
 #endif // INDEXESANDWEIGHTS_H
@@ -17,7 +17,7 @@ public:
     }
 
     /**
-     * @brief IndexesAndWeightsO1::computeWeights computes
+     * @brief IndexesAndWeightsO1::weights computes
      * the weights (or ponderations) associated to each point
      * of indexList_
      *
@@ -37,12 +37,27 @@ public:
      * Some tricks are used to optimize computation
      *
      */
-    inline virtual void computeWeights(double reducedCoord, std::vector<uint32> const& indexList,
-                                       std::vector<double>& weightList) final
+    template<typename IndexList, typename WeightList>
+    static inline void weights(double reducedCoord, IndexList const& indexList,
+                               WeightList& weightList)
     {
         weightList[1] = reducedCoord - static_cast<double>(indexList[0]);
         weightList[0] = 1. - weightList[1];
     }
+
+
+    virtual void computeWeights(double reducedCoord, std::vector<uint32> const& indexList,
+                                std::vector<double>& weightList) final
+    {
+        weights(reducedCoord, indexList, weightList);
+    }
+};
+
+
+template<>
+struct IndexesAndWeightsOfOrder<1>
+{
+    using type = IndexesAndWeightsO1;
 };
 
 
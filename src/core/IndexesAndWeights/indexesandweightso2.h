@@ -17,7 +17,7 @@ public:
     }
 
     /**
-     * @brief IndexesAndWeightsO2::computeWeights computes
+     * @brief IndexesAndWeightsO2::weights computes
      * the weights (or ponderations) associated to each point
      * of indexList_
      *
@@ -38,8 +38,9 @@ public:
      *
      *
      */
-    virtual void computeWeights(double reducedCoord, std::vector<uint32> const& indexList,
-                                std::vector<double>& weightList) final
+    template<typename IndexList, typename WeightList>
+    static inline void weights(double reducedCoord, IndexList const& indexList,
+                               WeightList& weightList)
     {
         double coef1, coef2, coef3;
 
@@ -51,6 +52,20 @@ public:
         weightList[1] = 0.75 - coef2 * coef2;
         weightList[2] = 0.5 * coef3 * coef3;
     }
+
+
+    virtual void computeWeights(double reducedCoord, std::vector<uint32> const& indexList,
+                                std::vector<double>& weightList) final
+    {
+        weights(reducedCoord, indexList, weightList);
+    }
+};
+
+
+template<>
+struct IndexesAndWeightsOfOrder<2>
+{
+    using type = IndexesAndWeightsO2;
 };
 
 
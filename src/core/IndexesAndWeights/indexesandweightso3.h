@@ -18,7 +18,7 @@ public:
 
     // the formulas ruling the weights are specific to a given order
     /**
-     * @brief IndexesAndWeightsO3::computeWeights computes
+     * @brief IndexesAndWeightsO3::weights computes
      * the weights (or ponderations) associated to each point
      * of indexList_
      *
@@ -39,8 +39,9 @@ public:
      *
      *
      */
-    virtual void computeWeights(double reducedCoord, std::vector<uint32> const& indexList,
-                                std::vector<double>& weightList) final
+    template<typename IndexList, typename WeightList>
+    static inline void weights(double reducedCoord, IndexList const& indexList,
+                               WeightList& weightList)
     {
         double coef1, coef2, coef3, coef4;
 
@@ -59,8 +60,22 @@ public:
         weightList[2] = 2. / 3. - coef3_sq + 0.5 * coef3_cub;
         weightList[3] = (4. / 3.) * coef4 * coef4 * coef4;
     }
+
+
+    virtual void computeWeights(double reducedCoord, std::vector<uint32> const& indexList,
+                                std::vector<double>& weightList) final
+    {
+        weights(reducedCoord, indexList, weightList);
+    }
 };
 
 
 
+template<>
+struct IndexesAndWeightsOfOrder<3>
+{
+    using type = IndexesAndWeightsO3;
+};
+
+
 #endif // INDEXESANDWEIGHTSO3_H
@@ -18,7 +18,7 @@ public:
 
     // the formulas ruling the weights are specific to a given order
     /**
-     * @brief IndexesAndWeightsO4::computeWeights computes
+     * @brief IndexesAndWeightsO4::weights computes
      * the weights (or ponderations) associated to each point
      * of indexList_
      *
@@ -41,8 +41,9 @@ public:
      * \f]
      *
      */
-    virtual void computeWeights(double reducedCoord, std::vector<uint32> const& indexList,
-                                std::vector<double>& weightList) final
+    template<typename IndexList, typename WeightList>
+    static inline void weights(double reducedCoord, IndexList const& indexList,
+                               WeightList& weightList)
     {
         double w0_c = 5. / 2. + static_cast<double>(indexList[0]) - reducedCoord;
 
@@ -69,6 +70,20 @@ public:
         weightList[3] = (1. / 96.) * (55. + 20 * w3_c - 120 * w3_c2 + 80 * w3_c3 - 16 * w3_c4);
         weightList[4] = (1. / 24.) * w4_c4;
     }
+
+
+    virtual void computeWeights(double reducedCoord, std::vector<uint32> const& indexList,
+                                std::vector<double>& weightList) final
+    {
+        weights(reducedCoord, indexList, weightList);
+    }
+};
+
+
+template<>
+struct IndexesAndWeightsOfOrder<4>
+{
+    using type = IndexesAndWeightsO4;
 };
 
 
@@ -1,12 +1,16 @@
 #ifndef INTERPOLATOR_H
 #define INTERPOLATOR_H
 
+#include <array>
 #include <cassert>
-#include <memory>
 
 #include "core/IndexesAndWeights/indexesandweights.h"
+#include "core/IndexesAndWeights/indexesandweightso1.h"
+#include "core/IndexesAndWeights/indexesandweightso2.h"
+#include "core/IndexesAndWeights/indexesandweightso3.h"
+#include "core/IndexesAndWeights/indexesandweightso4.h"
 #include "data/Field/field.h"
-#include "data/Plasmas/particles.h"
+#include "data/Plasmas/particlearray.h"
 #include "data/Plasmas/species.h"
 #include "data/grid/gridlayout.h"
 #include "data/grid/gridlayoutdefs.h"
@@ -14,20 +18,76 @@
 
 
 
+/**
+ * @brief The Interpolator class interpolates fields onto particles and
+ * projects particles onto moments, with a shape function of order 'order'.
+ *
+ * The order is a template parameter so that the indexes and weights are
+ * computed by inlined kernels into fixed size arrays and the loops on the
+ * interpolation stencil are fully unrolled. Code that only knows the order
+ * at runtime switches on it once and then works with an Interpolator<order>.
+ */
+template<uint32 order>
 class Interpolator
 {
 private:
-    uint32 order_;
-    double dualOffset_;
-    std::vector<uint32> xIndexes_;
-    std::vector<uint32> yIndexes_;
-    std::vector<uint32> zIndexes_;
+    static_assert(order >= 1 && order <= 4, "Interpolator - wrong interpolation order");
 
-    std::vector<double> xWeights_;
-    std::vector<double> yWeights_;
-    std::vector<double> zWeights_;
+    using ShapeFunction = typename IndexesAndWeightsOfOrder<order>::type;
 
-    std::unique_ptr<IndexesAndWeights> impl_;
+    static const uint32 nbrPoints = order + 1;
+
+    using IndexList  = std::array<uint32, nbrPoints>;
+    using WeightList = std::array<double, nbrPoints>;
+
+    // shift applied to the reduced coordinate of a quantity, indexed by its
+    // centering, so that picking it does not branch on the centering.
+    // Indexes for dual quantities must be incremented by dualOffset, which
+    // depends on the interpolation order.
+    std::array<double, 2> centeringOffset_;
+
+
+    //! position of the particle 'iPart' in 'direction', in units of the mesh size
+    inline double reducedCoord_(ParticleArray const& particles, ParticleArray::size_type iPart,
+                                uint32 direction) const
+    {
+        return particles.icell(direction)[iPart]
+               + static_cast<double>(particles.delta(direction)[iPart]);
+    }
+
+
+    //! shift 'reducedCoord' according to 'centering'
+    inline double centered_(double reducedCoord, QtyCentering centering) const
+    {
+        return reducedCoord + centeringOffset_[static_cast<uint32>(centering)];
+    }
+
+
+    inline void indexesAndWeights_(double reducedCoord, IndexList& indexes,
+                                   WeightList& weights) const
+    {
+        IndexesAndWeights::indexes<order>(reducedCoord, indexes);
+        ShapeFunction::weights(reducedCoord, indexes, weights);
+    }
+
+
+public:
+    /**
+     * @brief Stencil holds the indexes and the weights of the mesh points
+     * contributing to the value of a field at a point, in one direction
+     */
+    struct Stencil
+    {
+        IndexList indexes;
+        WeightList weights;
+    };
+
+
+private:
+    inline void stencil_(double reducedCoord, QtyCentering centering, Stencil& stencil) const
+    {
+        indexesAndWeights_(centered_(reducedCoord, centering), stencil.indexes, stencil.weights);
+    }
 
 
 
@@ -42,25 +102,14 @@ private:
      * @return
      */
     inline double interpolateFieldOnto1DPoint_(double reducedCoord, Field const& meshField,
-                                               QtyCentering const& centering)
+                                               QtyCentering const& centering) const
     {
         // we might interpolate a field from
         // a primal or a dual mesh
-        if (centering == QtyCentering::dual) // TODO this if is probably slowing us down
-        {
-            reducedCoord += dualOffset_;
-        }
-
-        impl_->computeIndexes(reducedCoord, xIndexes_);
-        impl_->computeWeights(reducedCoord, xIndexes_, xWeights_);
+        Stencil xStencil;
+        stencil_(reducedCoord, centering, xStencil);
 
-        double particleField = 0;
-
-        for (uint32 ik = 0; ik < xIndexes_.size(); ++ik)
-        {
-            particleField += meshField(xIndexes_[ik]) * xWeights_[ik];
-        }
-        return particleField;
+        return interpolate(meshField, xStencil);
     }
 
 
@@ -69,31 +118,14 @@ private:
     inline double interpolateFieldOnto2DPoint_(double Xreduced, double Yreduced,
                                                Field const& meshField,
                                                QtyCentering const& Xcentering,
-                                               QtyCentering const& Ycentering)
+                                               QtyCentering const& Ycentering) const
     {
         // we might interpolate a field from a primal or a dual mesh
-        if (Xcentering == QtyCentering::dual)
-            Xreduced += dualOffset_;
-        if (Ycentering == QtyCentering::dual)
-            Yreduced += dualOffset_;
-
-        impl_->computeIndexes(Xreduced, xIndexes_);
-        impl_->computeIndexes(Yreduced, yIndexes_);
-        impl_->computeWeights(Xreduced, xIndexes_, xWeights_);
-        impl_->computeWeights(Yreduced, yIndexes_, yWeights_);
-
-        double fieldAtParticle = 0.;
-        for (uint32 ix = 0; ix < xIndexes_.size(); ++ix)
-        {
-            double Yinterp = 0.;
-            for (uint32 iy = 0; iy < yIndexes_.size(); ++iy)
-            {
-                Yinterp += meshField(xIndexes_[ix], yIndexes_[iy]) * yWeights_[iy];
-            }
-            fieldAtParticle += Yinterp * xWeights_[ix];
-        }
+        Stencil xStencil, yStencil;
+        stencil_(Xreduced, Xcentering, xStencil);
+        stencil_(Yreduced, Ycentering, yStencil);
 
-        return fieldAtParticle;
+        return interpolate(meshField, xStencil, yStencil);
     }
 
 
@@ -103,52 +135,104 @@ private:
                                                Field const& meshField,
                                                QtyCentering const& Xcentering,
                                                QtyCentering const& Ycentering,
-                                               QtyCentering const& Zcentering)
+                                               QtyCentering const& Zcentering) const
     {
         // we might interpolate a field from
         // a primal or a dual mesh
-        if (Xcentering == QtyCentering::dual)
-            Xreduced += dualOffset_;
-        if (Ycentering == QtyCentering::dual)
-            Yreduced += dualOffset_;
-        if (Zcentering == QtyCentering::dual)
-            Zreduced += dualOffset_;
-
-        impl_->computeIndexes(Xreduced, xIndexes_);
-        impl_->computeIndexes(Yreduced, yIndexes_);
-        impl_->computeIndexes(Zreduced, zIndexes_);
-        impl_->computeWeights(Xreduced, xIndexes_, xWeights_);
-        impl_->computeWeights(Yreduced, yIndexes_, yWeights_);
-        impl_->computeWeights(Zreduced, zIndexes_, zWeights_);
-
-        double fieldAtParticle = 0.;
-        for (uint32 ix = 0; ix < xIndexes_.size(); ++ix)
+        Stencil xStencil, yStencil, zStencil;
+        stencil_(Xreduced, Xcentering, xStencil);
+        stencil_(Yreduced, Ycentering, yStencil);
+        stencil_(Zreduced, Zcentering, zStencil);
+
+        return interpolate(meshField, xStencil, yStencil, zStencil);
+    }
+
+
+
+
+public:
+    Interpolator()
+        : centeringOffset_{{0., (order == 3) ? +0.5 : -0.5}}
+    {
+    }
+
+
+
+    /**
+     * @brief particleStencils computes the stencils of the particle 'iPart'
+     * of 'particles' in 'direction', for a primal and for a dual quantity.
+     * They are indexed by QtyCentering, so that all the fields living on the
+     * same mesh can be interpolated with the same stencils.
+     */
+    inline void particleStencils(ParticleArray const& particles, ParticleArray::size_type iPart,
+                                 uint32 direction, std::array<Stencil, 2>& stencils) const
+    {
+        double reducedCoord = reducedCoord_(particles, iPart, direction);
+
+        stencil_(reducedCoord, QtyCentering::primal,
+                 stencils[static_cast<uint32>(QtyCentering::primal)]);
+        stencil_(reducedCoord, QtyCentering::dual,
+                 stencils[static_cast<uint32>(QtyCentering::dual)]);
+    }
+
+
+
+    //! interpolate 'meshField' with the 1D stencil 'x'
+    inline double interpolate(Field const& meshField, Stencil const& x) const
+    {
+        double fieldAtPoint = 0;
+
+        for (uint32 ik = 0; ik < nbrPoints; ++ik)
+        {
+            fieldAtPoint += meshField(x.indexes[ik]) * x.weights[ik];
+        }
+        return fieldAtPoint;
+    }
+
+
+
+    //! interpolate 'meshField' with the tensor product of the stencils 'x' and 'y'
+    inline double interpolate(Field const& meshField, Stencil const& x, Stencil const& y) const
+    {
+        double fieldAtPoint = 0.;
+        for (uint32 ix = 0; ix < nbrPoints; ++ix)
         {
             double Yinterp = 0.;
-            for (uint32 iy = 0; iy < yIndexes_.size(); ++iy)
+            for (uint32 iy = 0; iy < nbrPoints; ++iy)
             {
-                double Zinterp = 0.;
-                for (uint32 iz = 0; iz < zIndexes_.size(); ++iz)
-                {
-                    Zinterp
-                        += meshField(xIndexes_[ix], yIndexes_[iy], zIndexes_[iz]) * zWeights_[iz];
-                }
-                Yinterp += Zinterp * yWeights_[iy];
+                Yinterp += meshField(x.indexes[ix], y.indexes[iy]) * y.weights[iy];
             }
-            fieldAtParticle += Yinterp * xWeights_[ix];
+            fieldAtPoint += Yinterp * x.weights[ix];
         }
 
-        return fieldAtParticle;
+        return fieldAtPoint;
     }
 
 
 
+    //! interpolate 'meshField' with the tensor product of the stencils 'x', 'y' and 'z'
+    inline double interpolate(Field const& meshField, Stencil const& x, Stencil const& y,
+                              Stencil const& z) const
+    {
+        double fieldAtPoint = 0.;
+        for (uint32 ix = 0; ix < nbrPoints; ++ix)
+        {
+            double Yinterp = 0.;
+            for (uint32 iy = 0; iy < nbrPoints; ++iy)
+            {
+                double Zinterp = 0.;
+                for (uint32 iz = 0; iz < nbrPoints; ++iz)
+                {
+                    Zinterp
+                        += meshField(x.indexes[ix], y.indexes[iy], z.indexes[iz]) * z.weights[iz];
+                }
+                Yinterp += Zinterp * y.weights[iy];
+            }
+            fieldAtPoint += Yinterp * x.weights[ix];
+        }
 
-public:
-    Interpolator(uint32 order);
-
-    uint32 order() { return order_; }
-
+        return fieldAtPoint;
+    }
 
 
 
@@ -158,7 +242,8 @@ public:
      *
      * @return the meshField interpolated at the particle position
      */
-    inline double operator()(double reducedCoord, Field const& meshField, QtyCentering centering)
+    inline double operator()(double reducedCoord, Field const& meshField,
+                             QtyCentering centering) const
     {
         return interpolateFieldOnto1DPoint_(reducedCoord, meshField, centering);
     }
@@ -167,18 +252,18 @@ public:
 
     /**
      * @brief operator () this 1D overload is used to interpolate
-     * 'meshField' onto 'particle'
+     * 'meshField' onto the particle 'iPart' of 'particles'
      *
      * @param centering 1st direction centering
      *
      * @return
      */
-    inline double operator()(Particle const& particle, Field const& meshField,
-                             QtyCentering Xcentering)
+    inline double operator()(ParticleArray const& particles, ParticleArray::size_type iPart,
+                             Field const& meshField, QtyCentering Xcentering) const
     {
         uint32 dirX = static_cast<uint32>(Direction::X);
 
-        double Xreduced = particle.icell[dirX] + static_cast<double>(particle.delta[dirX]);
+        double Xreduced = reducedCoord_(particles, iPart, dirX);
 
         return interpolateFieldOnto1DPoint_(Xreduced, meshField, Xcentering);
     }
@@ -187,21 +272,22 @@ public:
 
     /**
      * @brief operator () this 2D overload is used to interpolate
-     * 'meshField' onto 'particle'
+     * 'meshField' onto the particle 'iPart' of 'particles'
      *
      * @param centering 1st direction centering
      * @param centering 2nd direction centering
      *
      * @return the meshField interpolated at the particle position
      */
-    inline double operator()(Particle const& particle, Field const& meshField,
-                             QtyCentering Xcentering, QtyCentering Ycentering)
+    inline double operator()(ParticleArray const& particles, ParticleArray::size_type iPart,
+                             Field const& meshField, QtyCentering Xcentering,
+                             QtyCentering Ycentering) const
     {
         uint32 dirX = static_cast<uint32>(Direction::X);
         uint32 dirY = static_cast<uint32>(Direction::Y);
 
-        double Xreduced = particle.icell[dirX] + static_cast<double>(particle.delta[dirX]);
-        double Yreduced = particle.icell[dirY] + static_cast<double>(particle.delta[dirY]);
+        double Xreduced = reducedCoord_(particles, iPart, dirX);
+        double Yreduced = reducedCoord_(particles, iPart, dirY);
 
         return interpolateFieldOnto2DPoint_(Xreduced, Yreduced, meshField, Xcentering, Ycentering);
     }
@@ -210,9 +296,10 @@ public:
 
     /**
      * @brief operator () this 3D overload is used to interpolate
-     * 'meshField' onto 'particle'
+     * 'meshField' onto the particle 'iPart' of 'particles'
      *
-     * @param particle
+     * @param particles
+     * @param iPart
      * @param meshField
      * @param centering 1st direction centering
      * @param centering 2nd direction centering
@@ -220,17 +307,17 @@ public:
      *
      * @return the meshField interpolated at the particle position
      */
-    inline double operator()(Particle const& particle, Field const& meshField,
-                             QtyCentering Xcentering, QtyCentering Ycentering,
-                             QtyCentering Zcentering)
+    inline double operator()(ParticleArray const& particles, ParticleArray::size_type iPart,
+                             Field const& meshField, QtyCentering Xcentering,
+                             QtyCentering Ycentering, QtyCentering Zcentering) const
     {
         uint32 dirX = static_cast<uint32>(Direction::X);
         uint32 dirY = static_cast<uint32>(Direction::Y);
         uint32 dirZ = static_cast<uint32>(Direction::Z);
 
-        double Xreduced = particle.icell[dirX] + static_cast<double>(particle.delta[dirX]);
-        double Yreduced = particle.icell[dirY] + static_cast<double>(particle.delta[dirY]);
-        double Zreduced = particle.icell[dirZ] + static_cast<double>(particle.delta[dirZ]);
+        double Xreduced = reducedCoord_(particles, iPart, dirX);
+        double Yreduced = reducedCoord_(particles, iPart, dirY);
+        double Zreduced = reducedCoord_(particles, iPart, dirZ);
 
         return interpolateFieldOnto3DPoint_(Xreduced, Yreduced, Zreduced, meshField, Xcentering,
                                             Ycentering, Zcentering);
@@ -238,33 +325,69 @@ public:
 
 
     /**
-     * @brief operator () this overload projects 'particle' onto rho and fluxes
+     * @brief operator () this overload projects the particle 'iPart' of 'particles'
+     * onto rho and fluxes
      */
-    inline void operator()(Particle const& particle, double cellVolumeInverse, Field& rho,
-                           Field& xFlux, Field& yFlux, Field& zFlux, Direction direction)
+    inline void operator()(ParticleArray const& particles, ParticleArray::size_type iPart,
+                           double cellVolumeInverse, Field& rho, Field& xFlux, Field& yFlux,
+                           Field& zFlux, Direction direction) const
     {
         uint32 idir                 = static_cast<uint32>(direction);
-        double weightOverCellVolume = particle.weight * cellVolumeInverse;
-        double reducedCoord = particle.icell[idir] + static_cast<double>(particle.delta[idir]);
+        double weightOverCellVolume = particles.weight()[iPart] * cellVolumeInverse;
+        double reducedCoord         = reducedCoord_(particles, iPart, idir);
 
 
-        double partRho = weightOverCellVolume * particle.charge;
-        double partVx  = weightOverCellVolume * particle.v[0];
-        double partVy  = weightOverCellVolume * particle.v[1];
-        double partVz  = weightOverCellVolume * particle.v[2];
+        double partRho = weightOverCellVolume * particles.charge()[iPart];
+        double partVx  = weightOverCellVolume * particles.v(0)[iPart];
+        double partVy  = weightOverCellVolume * particles.v(1)[iPart];
+        double partVz  = weightOverCellVolume * particles.v(2)[iPart];
 
-        impl_->computeIndexes(reducedCoord, xIndexes_);
-        impl_->computeWeights(reducedCoord, xIndexes_, xWeights_);
+        IndexList xIndexes;
+        WeightList xWeights;
+        indexesAndWeights_(reducedCoord, xIndexes, xWeights);
 
-        for (uint32 ik = 0; ik < xIndexes_.size(); ++ik)
+        for (uint32 ik = 0; ik < nbrPoints; ++ik)
         {
-            assert(xIndexes_[ik] < rho.shape()[idir]
+            assert(xIndexes[ik] < rho.shape()[idir]
                    && "Wrong index for interpolation - index bigger than rho.shape()");
-            assert(xIndexes_[ik] >= 0 && "Wrong index for interpolation - index lower than 0");
-            rho(xIndexes_[ik]) += partRho * xWeights_[ik];
-            xFlux(xIndexes_[ik]) += partVx * xWeights_[ik];
-            yFlux(xIndexes_[ik]) += partVy * xWeights_[ik];
-            zFlux(xIndexes_[ik]) += partVz * xWeights_[ik];
+            rho(xIndexes[ik]) += partRho * xWeights[ik];
+            xFlux(xIndexes[ik]) += partVx * xWeights[ik];
+            yFlux(xIndexes[ik]) += partVy * xWeights[ik];
+            zFlux(xIndexes[ik]) += partVz * xWeights[ik];
+        }
+    }
+
+
+
+    /**
+     * @brief operator () this overload projects the particle 'iPart' of 'particles'
+     * onto 'moments', where rho and the x, y and z fluxes of each node are contiguous,
+     * so that the four moments of a stencil point share a cache line
+     */
+    inline void operator()(ParticleArray const& particles, ParticleArray::size_type iPart,
+                           double cellVolumeInverse, double* moments, Direction direction) const
+    {
+        uint32 idir                 = static_cast<uint32>(direction);
+        double weightOverCellVolume = particles.weight()[iPart] * cellVolumeInverse;
+        double reducedCoord         = reducedCoord_(particles, iPart, idir);
+
+
+        double partRho = weightOverCellVolume * particles.charge()[iPart];
+        double partVx  = weightOverCellVolume * particles.v(0)[iPart];
+        double partVy  = weightOverCellVolume * particles.v(1)[iPart];
+        double partVz  = weightOverCellVolume * particles.v(2)[iPart];
+
+        IndexList xIndexes;
+        WeightList xWeights;
+        indexesAndWeights_(reducedCoord, xIndexes, xWeights);
+
+        for (uint32 ik = 0; ik < nbrPoints; ++ik)
+        {
+            double* node = moments + 4 * xIndexes[ik];
+            node[0] += partRho * xWeights[ik];
+            node[1] += partVx * xWeights[ik];
+            node[2] += partVy * xWeights[ik];
+            node[3] += partVz * xWeights[ik];
         }
     }
 };
@@ -1,190 +1,83 @@
+#include <algorithm>
+
 #include "particlemesh.h"
 
 
 
 /* ----------------------------------------------------------------------------
 
-                      Field interpolations at particles
+                      Interpolations from particles to moments
 
    ---------------------------------------------------------------------------- */
 
 
-void fieldAtParticle1D(Interpolator& interp, VecField const& E, VecField const& B,
-                       GridLayout const& layout, std::vector<Particle>& particles)
-{
-    uint32 idirX = static_cast<uint32>(Direction::X);
-    uint32 idirY = static_cast<uint32>(Direction::Y);
-    uint32 idirZ = static_cast<uint32>(Direction::Z);
-
-    Field const& Ex = E.component(idirX);
-    Field const& Ey = E.component(idirY);
-    Field const& Ez = E.component(idirZ);
 
-    Field const& Bx = B.component(idirX);
-    Field const& By = B.component(idirY);
-    Field const& Bz = B.component(idirZ);
+// number of particles deposited by one thread at a time. The chunks do not
+// depend on the number of threads, so that the moments are the same whatever
+// the number of threads
+static const uint32 depositChunkSize = 16384;
 
-    QtyCentering ctrEx_x = layout.fieldCentering(Ex, Direction::X);
-    QtyCentering ctrEy_x = layout.fieldCentering(Ey, Direction::X);
-    QtyCentering ctrEz_x = layout.fieldCentering(Ez, Direction::X);
-    QtyCentering ctrBx_x = layout.fieldCentering(Bx, Direction::X);
-    QtyCentering ctrBy_x = layout.fieldCentering(By, Direction::X);
-    QtyCentering ctrBz_x = layout.fieldCentering(Bz, Direction::X);
 
 
-    for (Particle& part : particles)
-    {
-        part.Ex = interp(part, Ex, ctrEx_x);
-        part.Ey = interp(part, Ey, ctrEy_x);
-        part.Ez = interp(part, Ez, ctrEz_x);
-        part.Bx = interp(part, Bx, ctrBx_x);
-        part.By = interp(part, By, ctrBy_x);
-        part.Bz = interp(part, Bz, ctrBz_x);
-    } // end loop on particles
-}
-
-
-
-void fieldAtParticle2D(Interpolator& interp, VecField const& E, VecField const& B,
-                       GridLayout const& layout, std::vector<Particle>& particles)
+/**
+ * @brief depositInterleaved calls 'deposit(iPart, moments)' for all particles,
+ * by chunks of 'depositChunkSize' particles, possibly on several threads, and
+ * adds their contributions to the slabs of 'buffer'.
+ *
+ * Chunk 'iChunk' goes to slab iChunk % DepositBuffer::nbrSlabs, and each slab
+ * gets its chunks in increasing order. A single chunk is therefore deposited
+ * directly into the moments, as a serial deposition would, and the moments do
+ * not depend on the number of threads once the slabs are reduced.
+ */
+template<typename Deposit>
+void depositInterleaved(DepositBuffer& buffer, uint32 nbrParticles, Deposit deposit)
 {
-    uint32 idirX = static_cast<uint32>(Direction::X);
-    uint32 idirY = static_cast<uint32>(Direction::Y);
-    uint32 idirZ = static_cast<uint32>(Direction::Z);
-
-    Field const& Ex = E.component(idirX);
-    Field const& Ey = E.component(idirY);
-    Field const& Ez = E.component(idirZ);
-
-    Field const& Bx = B.component(idirX);
-    Field const& By = B.component(idirY);
-    Field const& Bz = B.component(idirZ);
-
-    QtyCentering ctrEx_x = layout.fieldCentering(Ex, Direction::X);
-    QtyCentering ctrEy_x = layout.fieldCentering(Ey, Direction::X);
-    QtyCentering ctrEz_x = layout.fieldCentering(Ez, Direction::X);
-    QtyCentering ctrBx_x = layout.fieldCentering(Bx, Direction::X);
-    QtyCentering ctrBy_x = layout.fieldCentering(By, Direction::X);
-    QtyCentering ctrBz_x = layout.fieldCentering(Bz, Direction::X);
-
-    QtyCentering ctrEx_y = layout.fieldCentering(Ex, Direction::Y);
-    QtyCentering ctrEy_y = layout.fieldCentering(Ey, Direction::Y);
-    QtyCentering ctrEz_y = layout.fieldCentering(Ez, Direction::Y);
-    QtyCentering ctrBx_y = layout.fieldCentering(Bx, Direction::Y);
-    QtyCentering ctrBy_y = layout.fieldCentering(By, Direction::Y);
-    QtyCentering ctrBz_y = layout.fieldCentering(Bz, Direction::Y);
-
-
-    for (Particle& part : particles)
-    {
-        part.Ex = interp(part, Ex, ctrEx_x, ctrEx_y);
-        part.Ey = interp(part, Ey, ctrEy_x, ctrEy_y);
-        part.Ez = interp(part, Ez, ctrEz_x, ctrEz_y);
-
-        part.Bx = interp(part, Bx, ctrBx_x, ctrBx_y);
-        part.By = interp(part, By, ctrBy_x, ctrBy_y);
-        part.Bz = interp(part, Bz, ctrBz_x, ctrBz_y);
-    } // end loop on particles
-}
+    uint32 nbrChunks = (nbrParticles + depositChunkSize - 1) / depositChunkSize;
+    uint32 nbrSlabs  = std::min(nbrChunks, DepositBuffer::nbrSlabs);
 
+    buffer.useSlabs(nbrSlabs);
 
-
-void fieldAtParticle3D(Interpolator& interp, VecField const& E, VecField const& B,
-                       GridLayout const& layout, std::vector<Particle>& particles)
-{
-    uint32 idirX = static_cast<uint32>(Direction::X);
-    uint32 idirY = static_cast<uint32>(Direction::Y);
-    uint32 idirZ = static_cast<uint32>(Direction::Z);
-
-    Field const& Ex = E.component(idirX);
-    Field const& Ey = E.component(idirY);
-    Field const& Ez = E.component(idirZ);
-
-    Field const& Bx = B.component(idirX);
-    Field const& By = B.component(idirY);
-    Field const& Bz = B.component(idirZ);
-
-    QtyCentering ctrEx_x = layout.fieldCentering(Ex, Direction::X);
-    QtyCentering ctrEy_x = layout.fieldCentering(Ey, Direction::X);
-    QtyCentering ctrEz_x = layout.fieldCentering(Ez, Direction::X);
-    QtyCentering ctrBx_x = layout.fieldCentering(Bx, Direction::X);
-    QtyCentering ctrBy_x = layout.fieldCentering(By, Direction::X);
-    QtyCentering ctrBz_x = layout.fieldCentering(Bz, Direction::X);
-
-    QtyCentering ctrEx_y = layout.fieldCentering(Ex, Direction::Y);
-    QtyCentering ctrEy_y = layout.fieldCentering(Ey, Direction::Y);
-    QtyCentering ctrEz_y = layout.fieldCentering(Ez, Direction::Y);
-    QtyCentering ctrBx_y = layout.fieldCentering(Bx, Direction::Y);
-    QtyCentering ctrBy_y = layout.fieldCentering(By, Direction::Y);
-    QtyCentering ctrBz_y = layout.fieldCentering(Bz, Direction::Y);
-
-    QtyCentering ctrEx_z = layout.fieldCentering(Ex, Direction::Z);
-    QtyCentering ctrEy_z = layout.fieldCentering(Ey, Direction::Z);
-    QtyCentering ctrEz_z = layout.fieldCentering(Ez, Direction::Z);
-    QtyCentering ctrBx_z = layout.fieldCentering(Bx, Direction::Z);
-    QtyCentering ctrBy_z = layout.fieldCentering(By, Direction::Z);
-    QtyCentering ctrBz_z = layout.fieldCentering(Bz, Direction::Z);
-
-
-    for (Particle& part : particles)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (nbrSlabs > 1)
+#endif
+    for (uint32 iSlab = 0; iSlab < nbrSlabs; ++iSlab)
     {
-        part.Ex = interp(part, Ex, ctrEx_x, ctrEx_y, ctrEx_z);
-        part.Ey = interp(part, Ey, ctrEy_x, ctrEy_y, ctrEy_z);
-        part.Ez = interp(part, Ez, ctrEz_x, ctrEz_y, ctrEz_z);
-
-        part.Bx = interp(part, Bx, ctrBx_x, ctrBx_y, ctrBx_z);
-        part.By = interp(part, By, ctrBy_x, ctrBy_y, ctrBy_z);
-        part.Bz = interp(part, Bz, ctrBz_x, ctrBz_y, ctrBz_z);
-    } // end loop on particles
-}
+        double* target = buffer.slab(iSlab);
 
+        for (uint32 iChunk = iSlab; iChunk < nbrChunks; iChunk += DepositBuffer::nbrSlabs)
+        {
+            uint32 first = iChunk * depositChunkSize;
+            uint32 last  = std::min(nbrParticles, first + depositChunkSize);
 
-
-void fieldsAtParticles(Interpolator& interp, VecField const& E, VecField const& B,
-                       GridLayout const& layout, std::vector<Particle>& particles)
-{
-    switch (layout.nbDimensions())
-    {
-        case 1: fieldAtParticle1D(interp, E, B, layout, particles); break;
-        case 2: fieldAtParticle2D(interp, E, B, layout, particles); break;
-        case 3: fieldAtParticle3D(interp, E, B, layout, particles); break;
-        default: throw std::runtime_error("fieldsAtParticles - wrong dimensionality");
+            for (uint32 iPart = first; iPart < last; ++iPart)
+                deposit(iPart, target);
+        }
     }
 }
 
 
 
-/* ----------------------------------------------------------------------------
-
-                      Interpolations from particles to moments
-
-   ---------------------------------------------------------------------------- */
-
-
-
-void update1DChargeDensityAndFlux(Interpolator& interpolator, Species& species,
-                                  GridLayout const& layout, std::vector<Particle>& particles)
+template<uint32 order>
+void deposit1DChargeDensityAndFlux(Interpolator<order> const& interpolator, Species& species,
+                                   GridLayout const& layout, ParticleArray& particles)
 {
-    uint32 idirX = static_cast<uint32>(Direction::X);
-    uint32 idirY = static_cast<uint32>(Direction::Y);
-    uint32 idirZ = static_cast<uint32>(Direction::Z);
+    DepositBuffer& buffer = species.depositBuffer();
 
-    Field& fx  = species.flux(idirX);
-    Field& fy  = species.flux(idirY);
-    Field& fz  = species.flux(idirZ);
-    Field& rho = species.rho();
+    if (buffer.moments().size() != DepositBuffer::nbrMoments * species.rho().size())
+        throw std::runtime_error("depositChargeDensityAndFlux - no deposit phase started");
 
     double odx = layout.odx();
 
-    for (const Particle& part : particles)
-    {
-        interpolator(part, odx, rho, fx, fy, fz, Direction::X);
-    }
+    depositInterleaved(buffer, static_cast<uint32>(particles.size()),
+                       [&](uint32 iPart, double* target) {
+                           interpolator(particles, iPart, odx, target, Direction::X);
+                       });
 }
 
 
-void update2DChargeDensityAndFlux(Interpolator& interpolator, Species& species,
-                                  GridLayout const& layout, std::vector<Particle>& particles)
+template<uint32 order>
+void deposit2DChargeDensityAndFlux(Interpolator<order> const& interpolator, Species& species,
+                                   GridLayout const& layout, ParticleArray& particles)
 {
     // not implemented function
     // void unused variables
@@ -196,8 +89,9 @@ void update2DChargeDensityAndFlux(Interpolator& interpolator, Species& species,
 }
 
 
-void update3DChargeDensityAndFlux(Interpolator& interpolator, Species& species,
-                                  GridLayout const& layout, std::vector<Particle>& particles)
+template<uint32 order>
+void deposit3DChargeDensityAndFlux(Interpolator<order> const& interpolator, Species& species,
+                                   GridLayout const& layout, ParticleArray& particles)
 {
     // not implemented function
     // void unused variables
@@ -209,49 +103,59 @@ void update3DChargeDensityAndFlux(Interpolator& interpolator, Species& species,
 }
 
 
-void updateChargeDensityAndFlux(Interpolator& interpolator, Species& species,
-                                GridLayout const& layout, std::vector<Particle>& particles)
+/**
+ * @brief depositChargeDensityAndFlux adds the moments of 'particles' to the
+ * deposit buffer of 'species', between Species::startDeposit and
+ * Species::finishDeposit. The species moments are only set by the latter.
+ */
+template<uint32 order>
+void depositChargeDensityAndFlux(Interpolator<order> const& interpolator, Species& species,
+                                 GridLayout const& layout, ParticleArray& particles)
 {
     switch (layout.nbDimensions())
     {
-        case 1: update1DChargeDensityAndFlux(interpolator, species, layout, particles); break;
-        case 2: update2DChargeDensityAndFlux(interpolator, species, layout, particles); break;
-        case 3: update3DChargeDensityAndFlux(interpolator, species, layout, particles); break;
+        case 1: deposit1DChargeDensityAndFlux(interpolator, species, layout, particles); break;
+        case 2: deposit2DChargeDensityAndFlux(interpolator, species, layout, particles); break;
+        case 3: deposit3DChargeDensityAndFlux(interpolator, species, layout, particles); break;
         default: throw std::runtime_error("wrong dimensionality");
     }
 }
 
 
 
-void compute1DChargeDensityAndFlux(Interpolator& interpolator, Species& species,
-                                   GridLayout const& layout, std::vector<Particle>& particles)
+template<uint32 order>
+void compute1DChargeDensityAndFlux(Interpolator<order> const& interpolator, Species& species,
+                                   GridLayout const& layout, ParticleArray& particles)
 {
-    species.resetMoments();
-
-    update1DChargeDensityAndFlux(interpolator, species, layout, particles);
+    species.startDeposit();
+    deposit1DChargeDensityAndFlux(interpolator, species, layout, particles);
+    species.finishDeposit();
 }
 
 
-void compute2DChargeDensityAndFlux(Interpolator& interpolator, Species& species,
-                                   GridLayout const& layout, std::vector<Particle>& particles)
+template<uint32 order>
+void compute2DChargeDensityAndFlux(Interpolator<order> const& interpolator, Species& species,
+                                   GridLayout const& layout, ParticleArray& particles)
 {
-    species.resetMoments();
-
-    update2DChargeDensityAndFlux(interpolator, species, layout, particles);
+    species.startDeposit();
+    deposit2DChargeDensityAndFlux(interpolator, species, layout, particles);
+    species.finishDeposit();
 }
 
 
-void compute3DChargeDensityAndFlux(Interpolator& interpolator, Species& species,
-                                   GridLayout const& layout, std::vector<Particle>& particles)
+template<uint32 order>
+void compute3DChargeDensityAndFlux(Interpolator<order> const& interpolator, Species& species,
+                                   GridLayout const& layout, ParticleArray& particles)
 {
-    species.resetMoments();
-
-    update3DChargeDensityAndFlux(interpolator, species, layout, particles);
+    species.startDeposit();
+    deposit3DChargeDensityAndFlux(interpolator, species, layout, particles);
+    species.finishDeposit();
 }
 
 
-void computeChargeDensityAndFlux(Interpolator& interpolator, Species& species,
-                                 GridLayout const& layout, std::vector<Particle>& particles)
+template<uint32 order>
+void computeChargeDensityAndFlux(Interpolator<order> const& interpolator, Species& species,
+                                 GridLayout const& layout, ParticleArray& particles)
 {
     switch (layout.nbDimensions())
     {
@@ -261,3 +165,61 @@ void computeChargeDensityAndFlux(Interpolator& interpolator, Species& species,
         default: throw std::runtime_error("wrong dimensionality");
     }
 }
+
+
+
+/**
+ * @brief computeInterleavedMoments deposits 'particles' in 'moments', which
+ * hold rho and the x, y and z fluxes of each node of 'layout' contiguously, as
+ * the species moments would be after computeChargeDensityAndFlux. It is used
+ * when only a few nodes of the moments are needed, without species fields.
+ */
+template<uint32 order>
+void computeInterleavedMoments(Interpolator<order> const& interpolator, GridLayout const& layout,
+                               ParticleArray const& particles, DepositBuffer& moments)
+{
+    if (layout.nbDimensions() != 1)
+        throw std::runtime_error("computeInterleavedMoments : Not Implemented");
+
+    AllocSizeT size = layout.allocSize(HybridQuantity::rho);
+    moments.reset(size.nx_);
+
+    double odx = layout.odx();
+
+    depositInterleaved(moments, static_cast<uint32>(particles.size()),
+                       [&](uint32 iPart, double* target) {
+                           interpolator(particles, iPart, odx, target, Direction::X);
+                       });
+    moments.reduce();
+}
+
+
+
+// the interpolation order is only known at runtime, these are the
+// instantiations the callers dispatch to
+template void computeChargeDensityAndFlux(Interpolator<1> const&, Species&, GridLayout const&,
+                                          ParticleArray&);
+template void computeChargeDensityAndFlux(Interpolator<2> const&, Species&, GridLayout const&,
+                                          ParticleArray&);
+template void computeChargeDensityAndFlux(Interpolator<3> const&, Species&, GridLayout const&,
+                                          ParticleArray&);
+template void computeChargeDensityAndFlux(Interpolator<4> const&, Species&, GridLayout const&,
+                                          ParticleArray&);
+
+template void depositChargeDensityAndFlux(Interpolator<1> const&, Species&, GridLayout const&,
+                                          ParticleArray&);
+template void depositChargeDensityAndFlux(Interpolator<2> const&, Species&, GridLayout const&,
+                                          ParticleArray&);
+template void depositChargeDensityAndFlux(Interpolator<3> const&, Species&, GridLayout const&,
+                                          ParticleArray&);
+template void depositChargeDensityAndFlux(Interpolator<4> const&, Species&, GridLayout const&,
+                                          ParticleArray&);
+
+template void computeInterleavedMoments(Interpolator<1> const&, GridLayout const&,
+                                        ParticleArray const&, DepositBuffer&);
+template void computeInterleavedMoments(Interpolator<2> const&, GridLayout const&,
+                                        ParticleArray const&, DepositBuffer&);
+template void computeInterleavedMoments(Interpolator<3> const&, GridLayout const&,
+                                        ParticleArray const&, DepositBuffer&);
+template void computeInterleavedMoments(Interpolator<4> const&, GridLayout const&,
+                                        ParticleArray const&, DepositBuffer&);
@@ -1,11 +1,13 @@
 #ifndef PARTICLEMESH_H
 #define PARTICLEMESH_H
 
+#include <array>
 #include <vector>
 
 #include "core/Interpolator/interpolator.h"
 #include "data/Electromag/electromag.h"
-#include "data/Plasmas/particles.h"
+#include "data/Plasmas/depositbuffer.h"
+#include "data/Plasmas/particlearray.h"
 #include "data/grid/gridlayout.h"
 #include "data/vecfield/vecfield.h"
 
@@ -17,8 +19,98 @@
 
    ---------------------------------------------------------------------------- */
 
-void fieldsAtParticles(Interpolator& interp, VecField const& E, VecField const& B,
-                       GridLayout const& layout, std::vector<Particle>& particles);
+/**
+ * @brief ElectromagAtParticle interpolates E and B at the position of one
+ * particle and returns them by value, so that a pusher can gather the fields
+ * and use them right away instead of storing them in the particle array.
+ *
+ * The field centerings are computed once at construction. The dimension and
+ * the interpolation order are template parameters so that the per-particle
+ * interpolation does not branch on them.
+ *
+ * On a given layout the six components of E and B only live on primal or
+ * dual points, so for each particle the primal and dual stencils are computed
+ * once per direction and shared by all the components.
+ */
+template<uint32 dimension, uint32 order>
+class ElectromagAtParticle
+{
+private:
+    static const uint32 nbrComponents = 3;
+
+    using Stencil = typename Interpolator<order>::Stencil;
+
+    // primal and dual stencils of a particle, in each direction
+    using ParticleStencils = std::array<std::array<Stencil, 2>, 3>;
+
+    Interpolator<order> const& interp_;
+    std::array<Field const*, nbrComponents> E_;
+    std::array<Field const*, nbrComponents> B_;
+
+    // centering of each component of E and B in each direction,
+    // used to index the particle stencils
+    std::array<std::array<uint32, 3>, nbrComponents> ctrE_;
+    std::array<std::array<uint32, 3>, nbrComponents> ctrB_;
+
+
+    inline double interpolate_(Field const& field, std::array<uint32, 3> const& centering,
+                               ParticleStencils const& stencils) const
+    {
+        if (dimension == 1)
+            return interp_.interpolate(field, stencils[0][centering[0]]);
+        else if (dimension == 2)
+            return interp_.interpolate(field, stencils[0][centering[0]],
+                                       stencils[1][centering[1]]);
+        else
+            return interp_.interpolate(field, stencils[0][centering[0]],
+                                       stencils[1][centering[1]], stencils[2][centering[2]]);
+    }
+
+
+public:
+    ElectromagAtParticle(Interpolator<order> const& interp, VecField const& E, VecField const& B,
+                         GridLayout const& layout)
+        : interp_{interp}
+    {
+        static_assert(dimension >= 1 && dimension <= 3, "wrong dimensionality");
+
+        for (uint32 iComp = 0; iComp < nbrComponents; ++iComp)
+        {
+            E_[iComp] = &E.component(iComp);
+            B_[iComp] = &B.component(iComp);
+
+            for (uint32 dir = 0; dir < dimension; ++dir)
+            {
+                Direction direction = static_cast<Direction>(dir);
+
+                ctrE_[iComp][dir]
+                    = static_cast<uint32>(layout.fieldCentering(*E_[iComp], direction));
+                ctrB_[iComp][dir]
+                    = static_cast<uint32>(layout.fieldCentering(*B_[iComp], direction));
+            }
+        }
+    }
+
+
+    /**
+     * @brief operator () interpolates E and B at the position of the particle
+     * 'iPart' of 'particles' and writes their components in Epart and Bpart
+     */
+    inline void operator()(ParticleArray const& particles, ParticleArray::size_type iPart,
+                           std::array<double, 3>& Epart, std::array<double, 3>& Bpart) const
+    {
+        ParticleStencils stencils;
+
+        for (uint32 dir = 0; dir < dimension; ++dir)
+            interp_.particleStencils(particles, iPart, dir, stencils[dir]);
+
+        for (uint32 iComp = 0; iComp < nbrComponents; ++iComp)
+            Epart[iComp] = interpolate_(*E_[iComp], ctrE_[iComp], stencils);
+
+        for (uint32 iComp = 0; iComp < nbrComponents; ++iComp)
+            Bpart[iComp] = interpolate_(*B_[iComp], ctrB_[iComp], stencils);
+    }
+};
 
 
 
@@ -28,11 +120,17 @@ void fieldsAtParticles(Interpolator& interp, VecField const& E, VecField const&
 
    ---------------------------------------------------------------------------- */
 
-void computeChargeDensityAndFlux(Interpolator& interpolator, Species& species,
-                                 GridLayout const& layout, std::vector<Particle>& particles);
+template<uint32 order>
+void computeChargeDensityAndFlux(Interpolator<order> const& interpolator, Species& species,
+                                 GridLayout const& layout, ParticleArray& particles);
 
-void updateChargeDensityAndFlux(Interpolator& interpolator, Species& species,
-                                GridLayout const& layout, std::vector<Particle>& particles);
+template<uint32 order>
+void depositChargeDensityAndFlux(Interpolator<order> const& interpolator, Species& species,
+                                 GridLayout const& layout, ParticleArray& particles);
+
+template<uint32 order>
+void computeInterleavedMoments(Interpolator<order> const& interpolator, GridLayout const& layout,
+                               ParticleArray const& particles, DepositBuffer& moments);
 
 
 
@@ -1,6 +1,11 @@
 
 
+#include <stdexcept>
+
 #include "ohmimpl1d.h"
+
+#include "data/Field/fieldview.h"
+#include "data/grid/yeestencils.h"
 #include "utilities/types.h"
 
 
@@ -8,6 +13,8 @@
 OhmImpl1D::OhmImpl1D(GridLayout const& layout, double eta, double nu)
     : OhmImpl{layout, eta, nu}
 {
+    if (layout.layoutName() != "yee")
+        throw std::runtime_error("OhmImpl1D - only the Yee layout is supported");
 }
 
 
@@ -36,47 +43,42 @@ OhmImpl1D::~OhmImpl1D()
  */
 void OhmImpl1D::ideal_(VecField const& Ve, VecField const& B)
 {
-    // in the function we calculate the VexB term
-    // since we don't know which layout we're in
-    // we can't, here, put Ve on E, B on E and calculate VexB on E.
+    switch (layout_.order())
+    {
+        case 1: ideal_<1>(Ve, B); break;
+        case 2: ideal_<2>(Ve, B); break;
+        case 3: ideal_<3>(Ve, B); break;
+        case 4: ideal_<4>(Ve, B); break;
+        default: throw std::runtime_error("OhmImpl1D - wrong interpolation order");
+    }
+}
+
 
-    // We we will therefore write the cross product in the most general way
-    // where Ve and B are linear combinations of nodes
-    // linear combinations being given by the GridLayout
+
+template<uint32 InterpOrder>
+void OhmImpl1D::ideal_(VecField const& Ve, VecField const& B)
+{
+    // Ve and B are not on the electric field nodes, we project them with
+    // the Yee stencils of the layout. They are compile-time constants so
+    // that the projections are unrolled in the loops below.
+    using Stencils = YeeStencils<1, InterpOrder>;
 
 
     // this function is 1D therefore loop only in the X direction:
 
-    Field const& Vex = Ve.component(VecField::VecX);
-    Field const& Vey = Ve.component(VecField::VecY);
-    Field const& Vez = Ve.component(VecField::VecZ);
+    ConstFieldView<1> Vex{Ve.component(VecField::VecX)};
+    ConstFieldView<1> Vey{Ve.component(VecField::VecY)};
+    ConstFieldView<1> Vez{Ve.component(VecField::VecZ)};
 
-    Field const& Bx = B.component(VecField::VecX);
-    Field const& By = B.component(VecField::VecY);
-    Field const& Bz = B.component(VecField::VecZ);
+    ConstFieldView<1> Bx{B.component(VecField::VecX)};
+    ConstFieldView<1> By{B.component(VecField::VecY)};
+    ConstFieldView<1> Bz{B.component(VecField::VecZ)};
 
     Field& VexB_x = idealTerm_.component(VecField::VecX);
     Field& VexB_y = idealTerm_.component(VecField::VecY);
     Field& VexB_z = idealTerm_.component(VecField::VecZ);
 
 
-
-
-    // here we get the relative indices and weights to average the moments
-    // and the magnetic field components onto the electric field
-    LinearCombination const& avgPointsMomentsEx = layout_.momentsToEx();
-    LinearCombination const& avgPointsBzEx      = layout_.BzToEx();
-    LinearCombination const& avgPointsByEx      = layout_.ByToEx();
-
-    LinearCombination const& avgPointsMomentsEy = layout_.momentsToEy();
-    LinearCombination const& avgPointsBxEy      = layout_.BxToEy();
-    LinearCombination const& avgPointsBzEy      = layout_.BzToEy();
-
-    LinearCombination const& avgPointsMomentsEz = layout_.momentsToEz();
-    LinearCombination const& avgPointsBxEz      = layout_.BxToEz();
-    LinearCombination const& avgPointsByEz      = layout_.ByToEz();
-
-
     // ------------------------------------------------------------------------
     //
     //                              Ve x B _ x
@@ -86,33 +88,16 @@ void OhmImpl1D::ideal_(VecField const& Ve, VecField const& B)
         uint32 const iStart = layout_.physicalStartIndex(VexB_x, Direction::X);
         uint32 const iEnd   = layout_.physicalEndIndex(VexB_x, Direction::X);
 
+        FieldView<1> result{VexB_x};
+
         for (uint32 ix = iStart; ix <= iEnd; ++ix)
         {
-            // get Vz at 'ix'
-            // and Vy at 'ix'
-            double vyloc = 0;
-            double vzloc = 0;
-            for (WeightPoint const& wp : avgPointsMomentsEx)
-            {
-                vyloc += wp.coef * Vey(ix + wp.ix);
-                vzloc += wp.coef * Vez(ix + wp.ix);
-            }
-
-            // get Bz at 'ix'
-            double bzloc = 0;
-            for (WeightPoint const& wp : avgPointsBzEx)
-            {
-                bzloc += wp.coef * Bz(ix + wp.ix);
-            }
-
-            // get By at 'ix'
-            double byloc = 0;
-            for (WeightPoint const& wp : avgPointsByEx)
-            {
-                byloc += wp.coef * By(ix + wp.ix);
-            }
-
-            VexB_x(ix) = vzloc * byloc - vyloc * bzloc;
+            double vyloc = project<typename Stencils::MomentsToEx>(Vey, ix);
+            double vzloc = project<typename Stencils::MomentsToEx>(Vez, ix);
+            double bzloc = project<typename Stencils::BzToEx>(Bz, ix);
+            double byloc = project<typename Stencils::ByToEx>(By, ix);
+
+            result(ix) = vzloc * byloc - vyloc * bzloc;
         }
     }
 
@@ -127,37 +112,16 @@ void OhmImpl1D::ideal_(VecField const& Ve, VecField const& B)
         uint32 const iStart = layout_.physicalStartIndex(VexB_y, Direction::X);
         uint32 const iEnd   = layout_.physicalEndIndex(VexB_y, Direction::X);
 
+        FieldView<1> result{VexB_y};
+
         for (uint32 ix = iStart; ix <= iEnd; ++ix)
         {
-            // get Vz at 'ix'
-            double vzloc = 0;
-            for (WeightPoint const& wp : avgPointsMomentsEy)
-            {
-                vzloc += wp.coef * Vez(ix + wp.ix);
-            }
-
-            // get Bx at 'ix'
-            double bxloc = 0;
-            for (WeightPoint const& wp : avgPointsBxEy)
-            {
-                bxloc += wp.coef * Bx(ix + wp.ix);
-            }
-
-            // get Vx at 'ix'
-            double vxloc = 0;
-            for (WeightPoint const& wp : avgPointsMomentsEy)
-            {
-                vxloc += wp.coef * Vex(ix + wp.ix);
-            }
-
-            // get Bz at 'ix'
-            double bzloc = 0;
-            for (WeightPoint const& wp : avgPointsBzEy)
-            {
-                bzloc += wp.coef * Bz(ix + wp.ix);
-            }
-
-            VexB_y(ix) = -vzloc * bxloc + vxloc * bzloc;
+            double vzloc = project<typename Stencils::MomentsToEy>(Vez, ix);
+            double bxloc = project<typename Stencils::BxToEy>(Bx, ix);
+            double vxloc = project<typename Stencils::MomentsToEy>(Vex, ix);
+            double bzloc = project<typename Stencils::BzToEy>(Bz, ix);
+
+            result(ix) = -vzloc * bxloc + vxloc * bzloc;
         }
     }
 
@@ -172,37 +136,16 @@ void OhmImpl1D::ideal_(VecField const& Ve, VecField const& B)
         uint32 const iStart = layout_.physicalStartIndex(VexB_z, Direction::X);
         uint32 const iEnd   = layout_.physicalEndIndex(VexB_z, Direction::X);
 
+        FieldView<1> result{VexB_z};
+
         for (uint32 ix = iStart; ix <= iEnd; ++ix)
         {
-            // get Vx at 'ix'
-            double vxloc = 0;
-            for (WeightPoint const& wp : avgPointsMomentsEz)
-            {
-                vxloc += wp.coef * Vex(ix + wp.ix);
-            }
-
-            // get By at 'ix'
-            double byloc = 0;
-            for (WeightPoint const& wp : avgPointsByEz)
-            {
-                byloc += wp.coef * By(ix + wp.ix);
-            }
-
-            // get Vy at 'ix'
-            double vyloc = 0;
-            for (WeightPoint const& wp : avgPointsMomentsEz)
-            {
-                vyloc += wp.coef * Vey(ix + wp.ix);
-            }
-
-            // get Bx at 'ix'
-            double bxloc = 0;
-            for (WeightPoint const& wp : avgPointsBxEz)
-            {
-                bxloc += wp.coef * Bx(ix + wp.ix);
-            }
-
-            VexB_z(ix) = -vxloc * byloc + vyloc * bxloc;
+            double vxloc = project<typename Stencils::MomentsToEz>(Vex, ix);
+            double byloc = project<typename Stencils::ByToEz>(By, ix);
+            double vyloc = project<typename Stencils::MomentsToEz>(Vey, ix);
+            double bxloc = project<typename Stencils::BxToEz>(Bx, ix);
+
+            result(ix) = -vxloc * byloc + vyloc * bxloc;
         }
     }
 }
@@ -264,17 +207,32 @@ void OhmImpl1D::resistive_(VecField const& J)
  * @param Pe is the electron pressure field (scalar)
  */
 void OhmImpl1D::pressure_(Field const& Pe, Field const& Ne)
+{
+    switch (layout_.order())
+    {
+        case 1: pressure_<1>(Pe, Ne); break;
+        case 2: pressure_<2>(Pe, Ne); break;
+        case 3: pressure_<3>(Pe, Ne); break;
+        case 4: pressure_<4>(Pe, Ne); break;
+        default: throw std::runtime_error("OhmImpl1D - wrong interpolation order");
+    }
+}
+
+
+
+template<uint32 InterpOrder>
+void OhmImpl1D::pressure_(Field const& Pe, Field const& Ne)
 {
     Field& gradPx = pressureTerm_.component(VecField::VecX);
     layout_.deriv(Pe, Direction::X, gradPx);
 
     // we need now to divide the gradPe by the electron density Ne
     // Ne is on primal^3 and gradPx is on the electric field
-    // since we don't know here where the electric field is
-    // we will express Ne in terms of a linear combination
-    // of surrounding points the coefficients and nodes
-    // indexes will be given by:
-    LinearCombination const& avgPointsMomentsEx = layout_.momentsToEx();
+    // so Ne is projected on Ex
+    using MomentsToEx = typename YeeStencils<1, InterpOrder>::MomentsToEx;
+
+    ConstFieldView<1> NeView{Ne};
+    FieldView<1> gradPxView{gradPx};
 
     uint32 iStart = layout_.physicalStartIndex(gradPx, Direction::X);
     uint32 iEnd   = layout_.physicalEndIndex(gradPx, Direction::X);
@@ -284,11 +242,7 @@ void OhmImpl1D::pressure_(Field const& Pe, Field const& Ne)
     // on the electric field
     for (uint32 ix = iStart; ix <= iEnd; ++ix)
     {
-        double ne_loc = 0;
-        for (WeightPoint const& wp : avgPointsMomentsEx)
-        {
-            ne_loc += wp.coef * Ne(ix + wp.ix);
-        }
-        gradPx(ix) = -gradPx(ix) / ne_loc;
+        double ne_loc  = project<MomentsToEx>(NeView, ix);
+        gradPxView(ix) = -gradPxView(ix) / ne_loc;
     }
 }
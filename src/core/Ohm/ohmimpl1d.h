@@ -13,6 +13,13 @@ private:
     virtual void resistive_(VecField const& J) override;
     virtual void pressure_(Field const& Pe, Field const& Ne) override;
 
+    // versions for the Yee stencils of the interpolation order
+    template<uint32 InterpOrder>
+    void ideal_(VecField const& Ve, VecField const& B);
+
+    template<uint32 InterpOrder>
+    void pressure_(Field const& Pe, Field const& Ne);
+
 public:
     explicit OhmImpl1D(GridLayout const& layout, double eta, double nu);
 
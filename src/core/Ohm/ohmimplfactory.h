@@ -4,6 +4,7 @@
 #include "data/grid/gridlayout.h"
 #include "ohm.h"
 #include "ohmimpl1d.h"
+#include "ohmimplmultid.h"
 #include "utilities/types.h"
 
 
@@ -16,15 +17,12 @@ public:
         {
             case 1: return std::unique_ptr<OhmImpl>(new OhmImpl1D(layout, 1e-3, 1e-4));
 
-#if 0
             case 2:
-                std::cout << "not yet implemented\n";
-                break;
-#endif
+            case 3: return std::unique_ptr<OhmImpl>(new OhmImplMultiD(layout, 1e-3, 1e-4));
 
             default:
                 throw std::runtime_error(
-                    "Error : FaradayFactory - dimension must be either 1D, 2D or 3D");
+                    "Error : OhmFactory - dimension must be either 1D, 2D or 3D");
         }
     }
 };
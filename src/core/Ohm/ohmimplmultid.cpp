@@ -0,0 +1,199 @@
+
+
+#include "ohmimplmultid.h"
+#include "utilities/types.h"
+
+
+
+OhmImplMultiD::OhmImplMultiD(GridLayout const& layout, double eta, double nu)
+    : OhmImpl{layout, eta, nu}
+{
+    for (uint32 iDim = 0; iDim < layout.nbDimensions(); ++iDim)
+    {
+        gradPe_[iDim] = RowDerivative{layout, HybridQuantity::P, static_cast<Direction>(iDim)};
+    }
+}
+
+
+void OhmImplMultiD::computeTerms(VecField const& B, Field const& Ne, VecField const& Ve,
+                                 Field const& Pe, VecField const& J)
+{
+    ideal_(Ve, B);
+    resistive_(J);
+    pressure_(Pe, Ne);
+}
+
+
+
+OhmImplMultiD::~OhmImplMultiD()
+{
+}
+
+
+
+
+/**
+ * @brief calculate the -Ve x B term, see OhmImpl1D::ideal_
+ * @param Ve is the electron bulk velocity field
+ * @param B is the magnetic field
+ */
+void OhmImplMultiD::ideal_(VecField const& Ve, VecField const& B)
+{
+    Field const& Vex = Ve.component(VecField::VecX);
+    Field const& Vey = Ve.component(VecField::VecY);
+    Field const& Vez = Ve.component(VecField::VecZ);
+
+    Field const& Bx = B.component(VecField::VecX);
+    Field const& By = B.component(VecField::VecY);
+    Field const& Bz = B.component(VecField::VecZ);
+
+    Field& VexB_x = idealTerm_.component(VecField::VecX);
+    Field& VexB_y = idealTerm_.component(VecField::VecY);
+    Field& VexB_z = idealTerm_.component(VecField::VecZ);
+
+
+    LinearCombination const& avgPointsMomentsEx = layout_.momentsToEx();
+    LinearCombination const& avgPointsBzEx      = layout_.BzToEx();
+    LinearCombination const& avgPointsByEx      = layout_.ByToEx();
+
+    LinearCombination const& avgPointsMomentsEy = layout_.momentsToEy();
+    LinearCombination const& avgPointsBxEy      = layout_.BxToEy();
+    LinearCombination const& avgPointsBzEy      = layout_.BzToEy();
+
+    LinearCombination const& avgPointsMomentsEz = layout_.momentsToEz();
+    LinearCombination const& avgPointsBxEz      = layout_.BxToEz();
+    LinearCombination const& avgPointsByEz      = layout_.ByToEz();
+
+
+    // -(VyBz - VzBy)
+    forEachRow(physicalNodes(layout_, HybridQuantity::Ex),
+               [&](uint32 ix, uint32 iy, uint32 iz, uint32 count) {
+                   double vyloc[rowTileSize];
+                   double vzloc[rowTileSize];
+                   double bzloc[rowTileSize];
+                   double byloc[rowTileSize];
+
+                   projectRow(avgPointsMomentsEx, Vey, ix, iy, iz, count, vyloc);
+                   projectRow(avgPointsMomentsEx, Vez, ix, iy, iz, count, vzloc);
+                   projectRow(avgPointsBzEx, Bz, ix, iy, iz, count, bzloc);
+                   projectRow(avgPointsByEx, By, ix, iy, iz, count, byloc);
+
+                   double* vexB = &VexB_x(ix, iy, iz);
+
+                   for (uint32 i = 0; i < count; ++i)
+                   {
+                       vexB[i] = vzloc[i] * byloc[i] - vyloc[i] * bzloc[i];
+                   }
+               });
+
+
+    // -(VzBx - VxBz)
+    forEachRow(physicalNodes(layout_, HybridQuantity::Ey),
+               [&](uint32 ix, uint32 iy, uint32 iz, uint32 count) {
+                   double vzloc[rowTileSize];
+                   double bxloc[rowTileSize];
+                   double vxloc[rowTileSize];
+                   double bzloc[rowTileSize];
+
+                   projectRow(avgPointsMomentsEy, Vez, ix, iy, iz, count, vzloc);
+                   projectRow(avgPointsBxEy, Bx, ix, iy, iz, count, bxloc);
+                   projectRow(avgPointsMomentsEy, Vex, ix, iy, iz, count, vxloc);
+                   projectRow(avgPointsBzEy, Bz, ix, iy, iz, count, bzloc);
+
+                   double* vexB = &VexB_y(ix, iy, iz);
+
+                   for (uint32 i = 0; i < count; ++i)
+                   {
+                       vexB[i] = -vzloc[i] * bxloc[i] + vxloc[i] * bzloc[i];
+                   }
+               });
+
+
+    // -(VxBy - VyBx)
+    forEachRow(physicalNodes(layout_, HybridQuantity::Ez),
+               [&](uint32 ix, uint32 iy, uint32 iz, uint32 count) {
+                   double vxloc[rowTileSize];
+                   double byloc[rowTileSize];
+                   double vyloc[rowTileSize];
+                   double bxloc[rowTileSize];
+
+                   projectRow(avgPointsMomentsEz, Vex, ix, iy, iz, count, vxloc);
+                   projectRow(avgPointsByEz, By, ix, iy, iz, count, byloc);
+                   projectRow(avgPointsMomentsEz, Vey, ix, iy, iz, count, vyloc);
+                   projectRow(avgPointsBxEz, Bx, ix, iy, iz, count, bxloc);
+
+                   double* vexB = &VexB_z(ix, iy, iz);
+
+                   for (uint32 i = 0; i < count; ++i)
+                   {
+                       vexB[i] = -vxloc[i] * byloc[i] + vyloc[i] * bxloc[i];
+                   }
+               });
+}
+
+
+
+/**
+ * @brief Calculates the resistive term eta*J of the Ohm's law assuming constant eta
+ * @param J is the total current density
+ */
+void OhmImplMultiD::resistive_(VecField const& J)
+{
+    std::array<HybridQuantity, 3> qties{{HybridQuantity::Ex, HybridQuantity::Ey, HybridQuantity::Ez}};
+
+    for (uint32 iComp = 0; iComp < 3; ++iComp)
+    {
+        Field const& Jcomp = J.component(iComp);
+        Field& Rcomp       = resistivityTerm_.component(iComp);
+
+        forEachRow(physicalNodes(layout_, qties[iComp]),
+                   [&](uint32 ix, uint32 iy, uint32 iz, uint32 count) {
+                       double const* j = &Jcomp(ix, iy, iz);
+                       double* r       = &Rcomp(ix, iy, iz);
+
+                       for (uint32 i = 0; i < count; ++i)
+                       {
+                           r[i] = j[i] * eta_;
+                       }
+                   });
+    }
+}
+
+
+
+
+/**
+ * @brief calculates the term -grad Pe / Ne, the component in the invariant
+ * direction of 2D layouts being zero.
+ * @param Pe is the electron pressure field (scalar)
+ */
+void OhmImplMultiD::pressure_(Field const& Pe, Field const& Ne)
+{
+    std::array<HybridQuantity, 3> qties{{HybridQuantity::Ex, HybridQuantity::Ey, HybridQuantity::Ez}};
+
+    std::array<LinearCombination const*, 3> avgPointsMoments{
+        {&layout_.momentsToEx(), &layout_.momentsToEy(), &layout_.momentsToEz()}};
+
+    for (uint32 iComp = 0; iComp < layout_.nbDimensions(); ++iComp)
+    {
+        Field& gradP                 = pressureTerm_.component(iComp);
+        RowDerivative const& gradPe  = gradPe_[iComp];
+        LinearCombination const& avg = *avgPointsMoments[iComp];
+
+        forEachRow(physicalNodes(layout_, qties[iComp]),
+                   [&](uint32 ix, uint32 iy, uint32 iz, uint32 count) {
+                       double dPe[rowTileSize];
+                       double ne_loc[rowTileSize];
+
+                       gradPe(Pe, ix, iy, iz, count, dPe);
+                       projectRow(avg, Ne, ix, iy, iz, count, ne_loc);
+
+                       double* grad = &gradP(ix, iy, iz);
+
+                       for (uint32 i = 0; i < count; ++i)
+                       {
+                           grad[i] = -dPe[i] / ne_loc[i];
+                       }
+                   });
+    }
+}
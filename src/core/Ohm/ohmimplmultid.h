@@ -0,0 +1,42 @@
+#ifndef OHMIMPLMULTID_H
+#define OHMIMPLMULTID_H
+
+
+#include "core/Ohm/ohm.h"
+
+#include "data/grid/gridrows.h"
+
+
+
+/**
+ * @brief OhmImplMultiD is the Ohm implementation for 2D and 3D layouts.
+ *
+ * The terms are computed by rows of the contiguous direction (see gridrows.h):
+ * the moments and the magnetic field are projected on the electric field
+ * nodes with row-wide LinearCombination projections, before the terms are
+ * computed from the row buffers.
+ */
+class OhmImplMultiD : public OhmImpl
+{
+private:
+    // pressure gradient in each non invariant direction
+    std::array<RowDerivative, 3> gradPe_;
+
+    virtual void ideal_(VecField const& Ve, VecField const& B) override;
+    virtual void resistive_(VecField const& J) override;
+    virtual void pressure_(Field const& Pe, Field const& Ne) override;
+
+public:
+    explicit OhmImplMultiD(GridLayout const& layout, double eta, double nu);
+
+
+    virtual void computeTerms(VecField const& B, Field const& Ne, VecField const& Ve,
+                              Field const& Pe, VecField const& J) override;
+
+    ~OhmImplMultiD();
+};
+
+
+
+
+#endif // OHMIMPLMULTID_H
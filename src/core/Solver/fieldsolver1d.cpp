@@ -0,0 +1,278 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "core/Solver/fieldsolver1d.h"
+#include "data/Field/fieldview.h"
+#include "data/grid/yeestencils.h"
+#include "utilities/hybridenums.h"
+
+
+
+FieldSolver1D::FieldSolver1D(double dt, GridLayout const& layout)
+    : dt_{dt}
+    , layout_{layout}
+    , momentStart_{layout.physicalStartIndex(HybridQuantity::V, Direction::X)}
+    , momentEnd_{layout.physicalEndIndex(HybridQuantity::V, Direction::X)}
+    , Ve_{layout.allocSize(HybridQuantity::V),
+          layout.allocSize(HybridQuantity::V),
+          layout.allocSize(HybridQuantity::V),
+          {{HybridQuantity::V, HybridQuantity::V, HybridQuantity::V}},
+          "_VeOhm"}
+{
+    if (layout.nbDimensions() != 1 || layout.layoutName() != "yee")
+        throw std::runtime_error("FieldSolver1D - only the 1D Yee layout is supported");
+}
+
+
+
+
+/**
+ * @brief FieldSolver1D::derivativeStart_ mirrors the indexing of
+ * GridLayout::deriv, where the derivative at its first physical node
+ * uses the first physical node of a primal operand and the last ghost node
+ * of a dual one.
+ */
+uint32 FieldSolver1D::derivativeStart_(Field const& operand) const
+{
+    uint32 iOp = layout_.physicalStartIndex(operand, Direction::X);
+
+    if (layout_.fieldCentering(operand, Direction::X) == QtyCentering::dual)
+        --iOp;
+
+    return iOp;
+}
+
+
+
+
+/**
+ * @brief FieldSolver1D::faraday computes Bnew = B - dt curl E.
+ *
+ * In 1D Yee, By and Bz have the same centering, so both are updated in the
+ * same sweep, the derivatives of Ez and Ey being computed on the fly.
+ */
+void FieldSolver1D::faraday(VecField const& E, VecField const& B, VecField& Bnew) const
+{
+    Field const& Ey = E.component(VecField::VecY);
+    Field const& Ez = E.component(VecField::VecZ);
+    Field const& Bx = B.component(VecField::VecX);
+    Field const& By = B.component(VecField::VecY);
+    Field const& Bz = B.component(VecField::VecZ);
+
+    Field& Bxnew = Bnew.component(VecField::VecX);
+    Field& Bynew = Bnew.component(VecField::VecY);
+    Field& Bznew = Bnew.component(VecField::VecZ);
+
+    double odx = layout_.odx();
+
+    uint32 iStart = layout_.physicalStartIndex(Bx, Direction::X);
+    uint32 iEnd   = layout_.physicalEndIndex(Bx, Direction::X);
+
+    for (uint32 ix = iStart; ix <= iEnd; ++ix)
+    {
+        Bxnew(ix) = Bx(ix);
+    }
+
+
+    iStart = layout_.physicalStartIndex(By, Direction::X);
+    iEnd   = layout_.physicalEndIndex(By, Direction::X);
+
+    uint32 iOp = derivativeStart_(Ez);
+
+    for (uint32 ix = iStart; ix <= iEnd; ++ix, ++iOp)
+    {
+        double dxEz = odx * (Ez(iOp + 1) - Ez(iOp));
+        double dxEy = odx * (Ey(iOp + 1) - Ey(iOp));
+
+        Bynew(ix) = By(ix) + dt_ * dxEz;
+        Bznew(ix) = Bz(ix) - dt_ * dxEy;
+    }
+}
+
+
+
+
+/**
+ * @brief FieldSolver1D::ampere computes J = curl B. In 1D Jx is zero and
+ * Jy and Jz, which have the same centering, are computed in the same sweep.
+ */
+void FieldSolver1D::ampere(VecField const& B, VecField& J) const
+{
+    Field const& By = B.component(VecField::VecY);
+    Field const& Bz = B.component(VecField::VecZ);
+
+    Field& Jy = J.component(VecField::VecY);
+    Field& Jz = J.component(VecField::VecZ);
+
+    double odx = layout_.odx();
+
+    uint32 iStart = layout_.physicalStartIndex(Jy, Direction::X);
+    uint32 iEnd   = layout_.physicalEndIndex(Jy, Direction::X);
+
+    uint32 iOp = derivativeStart_(Bz);
+
+    for (uint32 ix = iStart; ix <= iEnd; ++ix, ++iOp)
+    {
+        double dxBz = odx * (Bz(iOp + 1) - Bz(iOp));
+        double dxBy = odx * (By(iOp + 1) - By(iOp));
+
+        Jy(ix) = -dxBz;
+        Jz(ix) = dxBy;
+    }
+}
+
+
+
+
+/**
+ * @brief FieldSolver1D::electronVelocity_ computes Ve = Vi - J/Ni on the
+ * moment nodes, J being averaged on the moment node.
+ *
+ * Like the electron bulk velocity of Electrons, it is only defined on the
+ * physical moment nodes and is zero on the ghost nodes.
+ */
+template<uint32 InterpOrder>
+void FieldSolver1D::electronVelocity_(VecField const& Vi, Field const& Ni,
+                                      VecField const& J) const
+{
+    using Stencils = YeeStencils<1, InterpOrder>;
+
+    ConstFieldView<1> Jx{J.component(VecField::VecX)};
+    ConstFieldView<1> Jy{J.component(VecField::VecY)};
+    ConstFieldView<1> Jz{J.component(VecField::VecZ)};
+
+    Field const& Vix = Vi.component(VecField::VecX);
+    Field const& Viy = Vi.component(VecField::VecY);
+    Field const& Viz = Vi.component(VecField::VecZ);
+
+    Field& Vex = Ve_.component(VecField::VecX);
+    Field& Vey = Ve_.component(VecField::VecY);
+    Field& Vez = Ve_.component(VecField::VecZ);
+
+    for (uint32 ix = 0; ix < momentStart_; ++ix)
+    {
+        Vex(ix) = 0.;
+        Vey(ix) = 0.;
+        Vez(ix) = 0.;
+    }
+
+    for (uint32 ix = momentStart_; ix <= momentEnd_; ++ix)
+    {
+        double jxloc = project<typename Stencils::ExToMoment>(Jx, ix);
+        double jyloc = project<typename Stencils::EyToMoment>(Jy, ix);
+        double jzloc = project<typename Stencils::EzToMoment>(Jz, ix);
+
+        Vex(ix) = Vix(ix) - jxloc / Ni(ix);
+        Vey(ix) = Viy(ix) - jyloc / Ni(ix);
+        Vez(ix) = Viz(ix) - jzloc / Ni(ix);
+    }
+
+    for (uint32 ix = momentEnd_ + 1; ix < Vex.size(); ++ix)
+    {
+        Vex(ix) = 0.;
+        Vey(ix) = 0.;
+        Vez(ix) = 0.;
+    }
+}
+
+
+
+/**
+ * @brief FieldSolver1D::ohm computes E = -Ve x B in one sweep over the grid.
+ *
+ * As in Ohm, only the ideal term is kept, so the electron pressure and the
+ * resistive term are not computed, and E is zero on the ghost nodes until the
+ * boundary condition is applied.
+ */
+void FieldSolver1D::ohm(VecField const& B, Field const& Ni, VecField const& Vi,
+                        VecField const& J, VecField& Enew) const
+{
+    switch (layout_.order())
+    {
+        case 1: ohm_<1>(B, Ni, Vi, J, Enew); break;
+        case 2: ohm_<2>(B, Ni, Vi, J, Enew); break;
+        case 3: ohm_<3>(B, Ni, Vi, J, Enew); break;
+        case 4: ohm_<4>(B, Ni, Vi, J, Enew); break;
+        default: throw std::runtime_error("FieldSolver1D - wrong interpolation order");
+    }
+}
+
+
+
+// zero the nodes of 'field' out of [iStart, iEnd]
+static void zeroGhostNodes(Field& field, uint32 iStart, uint32 iEnd)
+{
+    for (uint32 ix = 0; ix < iStart; ++ix)
+        field(ix) = 0.;
+
+    for (uint32 ix = iEnd + 1; ix < field.size(); ++ix)
+        field(ix) = 0.;
+}
+
+
+
+// Ve is computed once per moment node in Ve_, then averaged on the E nodes.
+// In 1D Yee, Ey and Ez have the same centering and are computed in the same
+// sweep, and the ghost nodes of E are zeroed apart.
+template<uint32 InterpOrder>
+void FieldSolver1D::ohm_(VecField const& B, Field const& Ni, VecField const& Vi,
+                         VecField const& J, VecField& Enew) const
+{
+    using Stencils    = YeeStencils<1, InterpOrder>;
+    using MomentsToEx = typename Stencils::MomentsToEx;
+    using MomentsToEy = typename Stencils::MomentsToEy;
+    using MomentsToEz = typename Stencils::MomentsToEz;
+
+    electronVelocity_<InterpOrder>(Vi, Ni, J);
+
+    ConstFieldView<1> Vex{Ve_.component(VecField::VecX)};
+    ConstFieldView<1> Vey{Ve_.component(VecField::VecY)};
+    ConstFieldView<1> Vez{Ve_.component(VecField::VecZ)};
+
+    ConstFieldView<1> Bx{B.component(VecField::VecX)};
+    ConstFieldView<1> By{B.component(VecField::VecY)};
+    ConstFieldView<1> Bz{B.component(VecField::VecZ)};
+
+    Field& Ex = Enew.component(VecField::VecX);
+    Field& Ey = Enew.component(VecField::VecY);
+    Field& Ez = Enew.component(VecField::VecZ);
+
+    uint32 const iStartEx = layout_.physicalStartIndex(Ex, Direction::X);
+    uint32 const iEndEx   = layout_.physicalEndIndex(Ex, Direction::X);
+    uint32 const iStartEy = layout_.physicalStartIndex(Ey, Direction::X);
+    uint32 const iEndEy   = layout_.physicalEndIndex(Ey, Direction::X);
+
+    zeroGhostNodes(Ex, iStartEx, iEndEx);
+    zeroGhostNodes(Ey, iStartEy, iEndEy);
+    zeroGhostNodes(Ez, iStartEy, iEndEy);
+
+    // -(VyBz - VzBy)
+    for (uint32 ix = iStartEx; ix <= iEndEx; ++ix)
+    {
+        double vyloc = project<MomentsToEx>(Vey, ix);
+        double vzloc = project<MomentsToEx>(Vez, ix);
+
+        double bzloc = project<typename Stencils::BzToEx>(Bz, ix);
+        double byloc = project<typename Stencils::ByToEx>(By, ix);
+
+        Ex(ix) = vzloc * byloc - vyloc * bzloc;
+    }
+
+    // -(VzBx - VxBz) and -(VxBy - VyBx)
+    for (uint32 ix = iStartEy; ix <= iEndEy; ++ix)
+    {
+        double vxEy = project<MomentsToEy>(Vex, ix);
+        double vzEy = project<MomentsToEy>(Vez, ix);
+        double bxEy = project<typename Stencils::BxToEy>(Bx, ix);
+        double bzEy = project<typename Stencils::BzToEy>(Bz, ix);
+
+        Ey(ix) = -vzEy * bxEy + vxEy * bzEy;
+
+        double vxEz = project<MomentsToEz>(Vex, ix);
+        double vyEz = project<MomentsToEz>(Vey, ix);
+        double byEz = project<typename Stencils::ByToEz>(By, ix);
+        double bxEz = project<typename Stencils::BxToEz>(Bx, ix);
+
+        Ez(ix) = -vxEz * byEz + vyEz * bxEz;
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef FIELDSOLVER1D_H
+#define FIELDSOLVER1D_H
+
+#include "data/Field/field.h"
+#include "data/grid/gridlayout.h"
+#include "data/vecfield/vecfield.h"
+
+#include "utilities/types.h"
+
+
+
+/**
+ * @brief FieldSolver1D computes the field stages of the 1D Yee predictor
+ * corrector scheme with fused stencils.
+ *
+ * Each operation below is a single sweep over the grid that reads its operands
+ * and writes its result directly, without the derivative and Ohm term
+ * temporaries of Faraday, Ampere, Electrons and Ohm. The results are the same
+ * as those of these operators, bit for bit.
+ *
+ * The boundary conditions must still be applied between the operations, since
+ * each of them reads the ghost nodes of the result of the previous one.
+ */
+class FieldSolver1D
+{
+private:
+    double dt_;
+    GridLayout layout_;
+
+    // physical moment nodes, where the electron velocity is defined
+    uint32 momentStart_;
+    uint32 momentEnd_;
+
+    // electron bulk velocity on the moment nodes, computed once by ohm for
+    // all the E nodes that average it
+    mutable VecField Ve_;
+
+    // compute the electron bulk velocity Ve_ on all the moment nodes
+    template<uint32 InterpOrder>
+    void electronVelocity_(VecField const& Vi, Field const& Ni, VecField const& J) const;
+
+    // ohm for the Yee stencils of the interpolation order
+    template<uint32 InterpOrder>
+    void ohm_(VecField const& B, Field const& Ni, VecField const& Vi, VecField const& J,
+              VecField& Enew) const;
+
+    // index of the first operand node used by the derivative of 'operand'
+    uint32 derivativeStart_(Field const& operand) const;
+
+public:
+    FieldSolver1D(double dt, GridLayout const& layout);
+
+    //! advance B to Bnew with the electric field E, Bnew may be B
+    void faraday(VecField const& E, VecField const& B, VecField& Bnew) const;
+
+    //! compute the total current J from B
+    void ampere(VecField const& B, VecField& J) const;
+
+    //! compute E from Ohm's law, with the electron bulk velocity computed on the fly
+    //! from the ion density Ni and bulk velocity Vi, and the total current J
+    void ohm(VecField const& B, Field const& Ni, VecField const& Vi, VecField const& J,
+             VecField& Enew) const;
+};
+
+
+
+#endif // FIELDSOLVER1D_H
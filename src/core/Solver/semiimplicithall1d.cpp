@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "core/Solver/semiimplicithall1d.h"
+#include "utilities/hybridenums.h"
+
+
+
+// implicitness of the Hall term, 1/2 for Crank-Nicolson
+static const double hallImplicitness = 0.5;
+
+
+
+SemiImplicitHall1D::SemiImplicitHall1D(double dt, GridLayout const& layout)
+    : dt_{dt}
+    , layout_{layout}
+{
+    if (layout.nbDimensions() != 1 || layout.layoutName() != "yee")
+        throw std::runtime_error("SemiImplicitHall1D - only the 1D Yee layout is supported");
+
+    uint32 nbrNodes = layout.physicalEndIndex(HybridQuantity::By, Direction::X)
+                      - layout.physicalStartIndex(HybridQuantity::By, Direction::X) + 1;
+
+    if (nbrNodes < 3)
+        throw std::runtime_error("SemiImplicitHall1D - at least 3 cells are needed");
+
+    hallCoef_.resize(nbrNodes + 1);
+    lower_.resize(nbrNodes);
+    diag_.resize(nbrNodes);
+    upper_.resize(nbrNodes);
+    increment_.resize(nbrNodes);
+    modifiedUpper_.resize(nbrNodes);
+    modifiedDiag_.resize(nbrNodes);
+    correction_.resize(nbrNodes);
+}
+
+
+
+
+void SemiImplicitHall1D::operator()(VecField const& B, VecField const& Bhall,
+                                    VecField const& Bexplicit, Field const& Ni, bool periodic,
+                                    VecField& Bnew)
+{
+    Field const& Bx = B.component(VecField::VecX);
+    Field const& By = B.component(VecField::VecY);
+    Field const& Bz = B.component(VecField::VecZ);
+
+    Field const& ByHall = Bhall.component(VecField::VecY);
+    Field const& BzHall = Bhall.component(VecField::VecZ);
+
+    Field const& ByExplicit = Bexplicit.component(VecField::VecY);
+    Field const& BzExplicit = Bexplicit.component(VecField::VecZ);
+
+    uint32 const nbrNodes = static_cast<uint32>(increment_.size());
+
+    // dual node k of By and Bz is between the primal nodes k and k+1 of Bx and Ni
+    uint32 const dualStart   = layout_.physicalStartIndex(By, Direction::X);
+    uint32 const bxStart     = layout_.physicalStartIndex(Bx, Direction::X);
+    uint32 const momentStart = layout_.physicalStartIndex(Ni, Direction::X);
+
+    for (uint32 m = 0; m <= nbrNodes; ++m)
+    {
+        hallCoef_[m] = Bx(bxStart + m) / Ni(momentStart + m);
+    }
+
+    double odx = layout_.odx();
+    std::complex<double> c{0., hallImplicitness * dt_ * odx * odx};
+
+    // difference between B and Bhall, at the dual node 'ix'
+    auto shift = [&](uint32 ix) {
+        return std::complex<double>{By(ix) - ByHall(ix), Bz(ix) - BzHall(ix)};
+    };
+
+    for (uint32 k = 0; k < nbrNodes; ++k)
+    {
+        lower_[k] = c * hallCoef_[k];
+        upper_[k] = c * hallCoef_[k + 1];
+        diag_[k]  = 1. - c * (hallCoef_[k] + hallCoef_[k + 1]);
+
+        uint32 ix                    = dualStart + k;
+        std::complex<double> current = shift(ix);
+
+        increment_[k] = {ByExplicit(ix) - By(ix), BzExplicit(ix) - Bz(ix)};
+        increment_[k] -= 2. * (upper_[k] * (shift(ix + 1) - current)
+                               - lower_[k] * (current - shift(ix - 1)));
+    }
+
+
+    if (periodic)
+    {
+        solveCyclic_(increment_);
+    }
+    else
+    {
+        uint32 first = dualStart - 1;
+        uint32 last  = dualStart + nbrNodes;
+
+        std::complex<double> firstGhost{ByExplicit(first) - By(first),
+                                        BzExplicit(first) - Bz(first)};
+        std::complex<double> lastGhost{ByExplicit(last) - By(last), BzExplicit(last) - Bz(last)};
+
+        increment_[0] -= lower_[0] * firstGhost;
+        increment_[nbrNodes - 1] -= upper_[nbrNodes - 1] * lastGhost;
+
+        solveTridiagonal_(diag_, increment_);
+    }
+
+
+    Field const& BxExplicit = Bexplicit.component(VecField::VecX);
+
+    Field& Bxnew = Bnew.component(VecField::VecX);
+    Field& Bynew = Bnew.component(VecField::VecY);
+    Field& Bznew = Bnew.component(VecField::VecZ);
+
+    uint32 const bxEnd = layout_.physicalEndIndex(Bx, Direction::X);
+    for (uint32 ix = bxStart; ix <= bxEnd; ++ix)
+    {
+        Bxnew(ix) = BxExplicit(ix);
+    }
+
+    for (uint32 k = 0; k < nbrNodes; ++k)
+    {
+        uint32 ix = dualStart + k;
+        Bynew(ix) = By(ix) + increment_[k].real();
+        Bznew(ix) = Bz(ix) + increment_[k].imag();
+    }
+}
+
+
+
+
+/**
+ * @brief SemiImplicitHall1D::solveTridiagonal_ solves in place the system of
+ * sub-diagonal lower_, diagonal 'diag' and super-diagonal upper_ with the
+ * Thomas algorithm. The system is diagonally dominant as long as Bx keeps the
+ * same sign, so no pivoting is needed.
+ */
+void SemiImplicitHall1D::solveTridiagonal_(std::vector<std::complex<double>> const& diag,
+                                           std::vector<std::complex<double>>& x)
+{
+    std::size_t n = x.size();
+
+    modifiedUpper_[0] = upper_[0] / diag[0];
+    x[0] /= diag[0];
+
+    for (std::size_t k = 1; k < n; ++k)
+    {
+        std::complex<double> pivot = diag[k] - lower_[k] * modifiedUpper_[k - 1];
+
+        modifiedUpper_[k] = upper_[k] / pivot;
+        x[k]              = (x[k] - lower_[k] * x[k - 1]) / pivot;
+    }
+
+    for (std::size_t k = n - 1; k > 0; --k)
+    {
+        x[k - 1] -= modifiedUpper_[k - 1] * x[k];
+    }
+}
+
+
+
+
+/**
+ * @brief SemiImplicitHall1D::solveCyclic_ solves in place the periodic system,
+ * where lower_[0] couples the first node to the last one and upper_[n-1] the
+ * last node to the first one, with the Sherman-Morrison formula: two
+ * tridiagonal solves with a diagonal modified by a rank one correction.
+ */
+void SemiImplicitHall1D::solveCyclic_(std::vector<std::complex<double>>& x)
+{
+    std::size_t n = x.size();
+
+    std::complex<double> topRight   = lower_[0];
+    std::complex<double> bottomLeft = upper_[n - 1];
+    std::complex<double> gamma      = -diag_[0];
+
+    modifiedDiag_ = diag_;
+    modifiedDiag_[0] -= gamma;
+    modifiedDiag_[n - 1] -= bottomLeft * topRight / gamma;
+
+    solveTridiagonal_(modifiedDiag_, x);
+
+    std::fill(correction_.begin(), correction_.end(), std::complex<double>{0., 0.});
+    correction_[0]     = gamma;
+    correction_[n - 1] = bottomLeft;
+
+    solveTridiagonal_(modifiedDiag_, correction_);
+
+    std::complex<double> factor = (x[0] + topRight * x[n - 1] / gamma)
+                                  / (1. + correction_[0] + topRight * correction_[n - 1] / gamma);
+
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        x[k] -= factor * correction_[k];
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef SEMIIMPLICITHALL1D_H
+#define SEMIIMPLICITHALL1D_H
+
+#include <complex>
+#include <vector>
+
+#include "data/Field/field.h"
+#include "data/grid/gridlayout.h"
+#include "data/vecfield/vecfield.h"
+
+#include "utilities/types.h"
+
+
+
+/**
+ * @brief SemiImplicitHall1D makes the Hall term of the 1D Faraday step
+ * implicit, so that the time step is no longer limited by the whistler waves.
+ *
+ * In 1D Yee, the Hall electric field Ey = Bx dxBy / N, Ez = Bx dxBz / N is
+ * linear in (By, Bz) since Bx is constant. With P = By + i Bz, its part of
+ * Faraday's law is dP/dt = -i D P, where D is the second difference
+ * D P_k = (a_{k+1} (P_{k+1} - P_k) - a_k (P_k - P_{k-1})) / dx^2 with a = Bx / N
+ * on the primal nodes around the dual node k.
+ *
+ * The explicit Faraday step uses the Hall term of some field Bhall (B itself,
+ * or the time average of B and of a predicted field in the predictor and
+ * corrector stages). Its increment r = Bexplicit - B is replaced by the
+ * solution dP of the tridiagonal system (cyclic on periodic domains)
+ *
+ *      (I + theta dt i D) dP = r - 2 theta dt i D (P - Phall)
+ *
+ * With theta = 1/2, this amounts to advancing the Hall term with the
+ * Crank-Nicolson scheme, which neither amplifies nor damps the whistlers for
+ * any dt, while the other terms of E stay explicit.
+ */
+class SemiImplicitHall1D
+{
+private:
+    double dt_;
+    GridLayout layout_;
+
+    // tridiagonal system on the physical nodes of By and Bz
+    std::vector<double> hallCoef_; // Bx / N on the primal nodes around them
+    std::vector<std::complex<double>> lower_;
+    std::vector<std::complex<double>> diag_;
+    std::vector<std::complex<double>> upper_;
+    std::vector<std::complex<double>> increment_;
+
+    // work arrays of the tridiagonal solves
+    std::vector<std::complex<double>> modifiedUpper_;
+    std::vector<std::complex<double>> modifiedDiag_;
+    std::vector<std::complex<double>> correction_;
+
+    void solveTridiagonal_(std::vector<std::complex<double>> const& diag,
+                           std::vector<std::complex<double>>& x);
+
+    void solveCyclic_(std::vector<std::complex<double>>& x);
+
+public:
+    SemiImplicitHall1D(double dt, GridLayout const& layout);
+
+    /**
+     * @brief computes Bnew from the field B at the start of the step and
+     * 'Bexplicit', the result of an explicit Faraday step with the Hall term of
+     * 'Bhall' and the boundary condition applied. The implicit Hall term uses
+     * the ion density Ni. On periodic domains the system is cyclic, otherwise
+     * the increments of the ghost nodes are those of 'Bexplicit'. Bnew may be B.
+     */
+    void operator()(VecField const& B, VecField const& Bhall, VecField const& Bexplicit,
+                    Field const& Ni, bool periodic, VecField& Bnew);
+};
+
+
+
+#endif // SEMIIMPLICITHALL1D_H
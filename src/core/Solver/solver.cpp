@@ -1,6 +1,10 @@
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 #include "core/Faraday/faradayfactory.h"
 #include "core/Interpolator/interpolator.h"
@@ -12,7 +16,7 @@
 #include "data/Plasmas/electrons.h"
 #include "data/Plasmas/ions.h"
 #include "data/grid/gridlayout.h"
-#include "data/vecfield/vecfieldoperations.h"
+#include "data/vecfield/vecfieldexpression.h"
 
 
 
@@ -40,13 +44,74 @@ Solver::Solver(GridLayout const& layout, double dt,
           layout.allocSize(HybridQuantity::Ez),
           {{HybridQuantity::Ex, HybridQuantity::Ey, HybridQuantity::Ez}},
           "Jtot"}
+    , predictorChunkSize_{solverInitializer->predictorChunkSize}
     , faraday_{dt, layout}
     , ampere_{layout}
     , ohm_{layout}
-    , interpolator_{solverInitializer->interpolationOrder}
+    , fieldSolver1D_{layout.nbDimensions() == 1 ? new FieldSolver1D{dt, layout} : nullptr}
+    , semiImplicitHall1D_{solverInitializer->fieldSolve == "semiImplicit"
+                              && layout.nbDimensions() == 1
+                              ? new SemiImplicitHall1D{dt, layout}
+                              : nullptr}
+    , Bexplicit_{layout.allocSize(HybridQuantity::Bx),
+                 layout.allocSize(HybridQuantity::By),
+                 layout.allocSize(HybridQuantity::Bz),
+                 {{HybridQuantity::Bx, HybridQuantity::By, HybridQuantity::Bz}},
+                 "Bexplicit"}
+    , fieldSubcycles_{solverInitializer->fieldSubcycles}
+    , substepFaraday_{dt / std::max(fieldSubcycles_, 1u), layout}
+    , leapfrogFaraday_{2. * dt / std::max(fieldSubcycles_, 1u), layout}
+    , substepFieldSolver1D_{layout.nbDimensions() == 1 && fieldSubcycles_ > 1
+                                ? new FieldSolver1D{dt / fieldSubcycles_, layout}
+                                : nullptr}
+    , leapfrogFieldSolver1D_{layout.nbDimensions() == 1 && fieldSubcycles_ > 1
+                                 ? new FieldSolver1D{2. * dt / fieldSubcycles_, layout}
+                                 : nullptr}
+    , interpolationOrder_{solverInitializer->interpolationOrder}
     , pusher_{PusherFactory::createPusher(layout, solverInitializer->pusherType, dt)}
+    , sortEvery_{solverInitializer->sortEvery}
+    , sortThreshold_{solverInitializer->sortThreshold}
+    , stepNbr_{0}
 
 {
+    if (fieldSubcycles_ == 0)
+        throw std::runtime_error("Solver - the number of field subcycles must be at least 1");
+
+    if (predictorChunkSize_ == 0 || predictorChunkSize_ % Pusher::chunkSize != 0)
+        throw std::runtime_error("Solver - the predictor chunk size must be a multiple of "
+                                 + std::to_string(Pusher::chunkSize));
+
+    if (solverInitializer->fieldSolve == "semiImplicit")
+    {
+        if (layout.nbDimensions() != 1)
+            throw std::runtime_error("Solver - the semi-implicit field solve only exists in 1D");
+
+        if (fieldSubcycles_ > 1)
+            throw std::runtime_error("Solver - the semi-implicit field solve is not subcycled");
+    }
+    else if (solverInitializer->fieldSolve != "explicit")
+    {
+        throw std::runtime_error("Solver - available field solves are explicit and semiImplicit");
+    }
+
+    if (solverInitializer->solverType == "PPC")
+        scheme_ = Scheme::PPC;
+    else if (solverInitializer->solverType == "momentExtrapolation")
+        scheme_ = Scheme::momentExtrapolation;
+    else
+        throw std::runtime_error("Solver - available solver types are PPC and momentExtrapolation");
+
+    // the extrapolated moments are evaluated in place at each step, see
+    // extrapolateMoments_, the previous ones are copies of the ion moments
+    if (scheme_ == Scheme::momentExtrapolation)
+    {
+        rhoExt_ = Field{layout.allocSize(HybridQuantity::rho), HybridQuantity::rho, "_rhoExt"};
+        ViExt_  = VecField{layout.allocSize(HybridQuantity::V),
+                          layout.allocSize(HybridQuantity::V),
+                          layout.allocSize(HybridQuantity::V),
+                          {{HybridQuantity::V, HybridQuantity::V, HybridQuantity::V}},
+                          "_ViExt"};
+    }
 }
 
 
@@ -60,24 +125,76 @@ void Solver::init(Ions& ions, BoundaryCondition const& boundaryCondition)
 {
     for (uint32 iSpe = 0; iSpe < ions.nbrSpecies(); ++iSpe)
     {
-        Species& species                 = ions.species(iSpe);
-        std::vector<Particle>& particles = species.particles();
+        Species& species         = ions.species(iSpe);
+        ParticleArray& particles = species.particles();
 
-        computeChargeDensityAndFlux(interpolator_, species, layout_, particles);
+        switch (interpolationOrder_)
+        {
+            case 1:
+                computeChargeDensityAndFlux(Interpolator<1>{}, species, layout_, particles);
+                break;
+            case 2:
+                computeChargeDensityAndFlux(Interpolator<2>{}, species, layout_, particles);
+                break;
+            case 3:
+                computeChargeDensityAndFlux(Interpolator<3>{}, species, layout_, particles);
+                break;
+            case 4:
+                computeChargeDensityAndFlux(Interpolator<4>{}, species, layout_, particles);
+                break;
+            default: throw std::runtime_error("Solver - wrong interpolation order");
+        }
     }
 
-    ions.computeChargeDensity();
+    for (uint32 iSpe = 0; iSpe < ions.nbrSpecies(); ++iSpe)
+        boundaryCondition.applyFluxBC(ions, iSpe);
+
+    ions.computeDensityAndFlux();
     boundaryCondition.applyDensityBC(ions.rho());
+    ions.divideFluxByDensity();
+
+    speciesPushers_.clear();
+    for (uint32 iSpe = 0; iSpe < ions.nbrSpecies(); ++iSpe)
+    {
+        uint32 pushInterval = ions.species(iSpe).pushInterval();
+
+        speciesPushers_.push_back(
+            pushInterval > 1 ? PusherFactory::createPusher(layout_, pusher_->pusherType(),
+                                                           pushInterval * pusher_->dt())
+                             : nullptr);
+    }
+}
+
+
+
+
+/**
+ * @brief Solver::solveStep advances the fields and the ions from t=n to t=n+1
+ * with the scheme chosen at construction: the predictor-predictor-corrector,
+ * which pushes the particles twice, or the moment extrapolation scheme, which
+ * pushes them once.
+ */
+void Solver::solveStep(Electromag& EMFields, Ions& ions, Electrons& electrons,
+                       BoundaryCondition& boundaryCondition)
+{
+    // the push phases of the species and the sorts are based on the step number
+    ++stepNbr_;
+
+    switch (scheme_)
+    {
+        case Scheme::PPC: solveStepPPC_(EMFields, ions, electrons, boundaryCondition); break;
 
-    boundaryCondition.applyFluxBC(ions);
-    ions.computeBulkVelocity();
+        case Scheme::momentExtrapolation:
+            solveStepExtrapolation_(EMFields, ions, electrons, boundaryCondition);
+            break;
+    }
 }
 
 
 
 
-void Solver::solveStepPPC(Electromag& EMFields, Ions& ions, Electrons& electrons,
-                          BoundaryCondition& boundaryCondition)
+void Solver::solveStepPPC_(Electromag& EMFields, Ions& ions, Electrons& electrons,
+                           BoundaryCondition& boundaryCondition)
 {
     VecField& B     = EMFields.getB();
     VecField& E     = EMFields.getE();
@@ -87,34 +204,34 @@ void Solver::solveStepPPC(Electromag& EMFields, Ions& ions, Electrons& electrons
     VecField& Eavg  = EMFieldsAvg_.getE();
 
 
+    sortIons_(ions);
+    startPushIntervals_(ions);
+
+    // the ion moments at t=n are interpolated in time with the predicted ones
+    // at the field substeps
+    if (fieldSubcycles_ > 1)
+    {
+        rhoN_ = ions.rho();
+        ViN_  = ions.bulkVel();
+    }
+
+
     // -----------------------------------------------------------------------
     //
     //                              PREDICTOR 1
     //
     // -----------------------------------------------------------------------
 
-    // Get B^{n+1} pred1 from E^n
-    faraday_(E, B, Bpred);
-    boundaryCondition.applyMagneticBC(Bpred);
-
-    // Compute J
-    ampere_(Bpred, Jtot_);
-    boundaryCondition.applyCurrentBC(Jtot_);
-
-
-    // --> Get electron moments at time n
-    VecField const& Vepred1 = electrons.bulkVel(ions.bulkVel(), ions.rho(), Jtot_);
-    Field const& PePred1    = electrons.pressure(ions.rho());
-
-    // --> Get electric field E_{n+1} pred1 from Ohm's law
-    ohm_(Bpred, ions.rho(), Vepred1, PePred1, Jtot_, Epred);
-    boundaryCondition.applyElectricBC(Epred);
+    // Get B^{n+1} pred1 from E^n, then J, the electron moments at time n
+    // and the electric field E_{n+1} pred1 from Ohm's law
+    fieldStage_(E, B, EMFields, Bpred, Epred, ions.rho(), ions.bulkVel(), electrons,
+                boundaryCondition);
 
 
     // Get time averaged prediction (E,B)^{n+1/2} pred1
     // using (E^n, B^n) and (E^{n+1}, B^{n+1}) pred1
-    timeAverage(E, Epred, Eavg);
-    timeAverage(B, Bpred, Bavg);
+    Eavg = (E + Epred) * 0.5;
+    Bavg = (B + Bpred) * 0.5;
 
     // Move ions from n to n+1 using (E^{n+1/2},B^{n+1/2}) pred 1
     // accumulate moments for each species and total ions.
@@ -129,31 +246,17 @@ void Solver::solveStepPPC(Electromag& EMFields, Ions& ions, Electrons& electrons
     //
     // -----------------------------------------------------------------------
 
-    // Get B^{n+1} pred2 from E^{n+1/2} pred1
-    faraday_(Eavg, B, Bpred);
-    boundaryCondition.applyMagneticBC(Bpred);
-
-    // Eavg.zero();
-
-    // Compute J
-    ampere_(Bpred, Jtot_);
-    boundaryCondition.applyCurrentBC(Jtot_);
-
-
-    // --> Get electron moments at time n with Pred1 ion moments
-    VecField const& Vepred2 = electrons.bulkVel(ions.bulkVel(), ions.rho(), Jtot_);
-    Field const& PePred2    = electrons.pressure(ions.rho());
-
-    // --> Get electric field E^{n+1} pred2 from Ohm's law
-    // --> using (n^{n+1}, u^{n+1}) pred and B_{n+1} pred2
-    ohm_(Bpred, ions.rho(), Vepred2, PePred2, Jtot_, Epred);
-    boundaryCondition.applyElectricBC(Epred);
+    // Get B^{n+1} pred2 from E^{n+1/2} pred1, then J, the electron moments
+    // with Pred1 ion moments and the electric field E^{n+1} pred2 from
+    // Ohm's law using (n^{n+1}, u^{n+1}) pred and B_{n+1} pred2
+    fieldStage_(Eavg, Bavg, EMFields, Bpred, Epred, ions.rho(), ions.bulkVel(), electrons,
+                boundaryCondition);
 
 
     // --> Get time averaged prediction (E^(n+1/2),B^(n+1/2)) pred2
     // --> using (E^n, B^n) and (E^{n+1}, B^{n+1}) pred2
-    timeAverage(E, Epred, Eavg);
-    timeAverage(B, Bpred, Bavg);
+    Eavg = (E + Epred) * 0.5;
+    Bavg = (B + Bpred) * 0.5;
 
 
     // Get the CORRECTED positions and velocities
@@ -168,124 +271,492 @@ void Solver::solveStepPPC(Electromag& EMFields, Ions& ions, Electrons& electrons
     //
     // -----------------------------------------------------------------------
 
-    // Get CORRECTED B^{n+1} from E^{n+1/2} pred2
-    faraday_(Eavg, B, B);
-    boundaryCondition.applyMagneticBC(B);
+    // Get CORRECTED B^{n+1} from E^{n+1/2} pred2, then J, the electron
+    // moments with Pred2 ion moments and the CORRECTED electric field E^{n+1}
+    // from Ohm's law using (n^{n+1}, u^{n+1}) cor and B_{n+1} cor
+    fieldStage_(Eavg, Bavg, EMFields, B, E, ions.rho(), ions.bulkVel(), electrons,
+                boundaryCondition);
+}
+
+
+
+
+/**
+ * @brief Solver::solveStepExtrapolation_ advances the step with a single push
+ * of the particles. The ion moments at t=n+1 needed by the predictor are not
+ * obtained from a first push as in solveStepPPC_, but extrapolated in time from
+ * those at t=n-1 and t=n, as in CAM-CL (Matthews 1994).
+ *
+ * The field stages are the same as in solveStepPPC_, so that the scheme is
+ * still time centered, but the predicted fields depend on the extrapolation
+ * error of the moments: it is less accurate and mostly worth it when the
+ * particle push dominates the cost of the step.
+ */
+void Solver::solveStepExtrapolation_(Electromag& EMFields, Ions& ions, Electrons& electrons,
+                                     BoundaryCondition& boundaryCondition)
+{
+    VecField& B     = EMFields.getB();
+    VecField& E     = EMFields.getE();
+    VecField& Bpred = EMFieldsPred_.getB();
+    VecField& Epred = EMFieldsPred_.getE();
+    VecField& Bavg  = EMFieldsAvg_.getB();
+    VecField& Eavg  = EMFieldsAvg_.getE();
+
+
+    sortIons_(ions);
+    startPushIntervals_(ions);
+
+    if (fieldSubcycles_ > 1)
+    {
+        rhoN_ = ions.rho();
+        ViN_  = ions.bulkVel();
+    }
+
+    extrapolateMoments_(ions);
+
+
+    // -----------------------------------------------------------------------
+    //
+    //                              PREDICTOR
+    //
+    // -----------------------------------------------------------------------
+
+    // Get B^{n+1} pred from E^n, then J, the electron moments and the
+    // electric field E^{n+1} pred from Ohm's law with the extrapolated
+    // ion moments (n^{n+1}, u^{n+1})
+    fieldStage_(E, B, EMFields, Bpred, Epred, rhoExt_, ViExt_, electrons, boundaryCondition);
+
+    Eavg = (E + Epred) * 0.5;
+    Bavg = (B + Bpred) * 0.5;
+
+    // Move ions from n to n+1 in place using (E^{n+1/2},B^{n+1/2}) pred,
+    // this is the only push of the step
+    moveIons_(Eavg, Bavg, ions, boundaryCondition, predictor2_);
+
+
+    // -----------------------------------------------------------------------
+    //
+    //                           CORRECTOR
+    //
+    // -----------------------------------------------------------------------
+
+    // Get CORRECTED B^{n+1} from E^{n+1/2} pred, then the CORRECTED electric
+    // field E^{n+1} from Ohm's law using the ion moments (n^{n+1}, u^{n+1})
+    // of the push and B_{n+1} cor
+    fieldStage_(Eavg, Bavg, EMFields, B, E, ions.rho(), ions.bulkVel(), electrons,
+                boundaryCondition);
+}
+
+
+
+
+/**
+ * @brief Solver::extrapolateMoments_ linearly extrapolates the ion density
+ * and bulk velocity to t=n+1 from the current moments of 'ions' at t=n and
+ * those of the previous step, and keeps the current ones for the next step.
+ * At the first step, the moments at t=n are used as they are.
+ *
+ * Where the density drops by more than half in a step, the extrapolated one
+ * could be small or negative and blow up the electron velocity in Ohm's law:
+ * the moments at t=n are used there instead.
+ */
+void Solver::extrapolateMoments_(Ions const& ions)
+{
+    Field const& rho  = ions.rho();
+    VecField const& V = ions.bulkVel();
+
+    // first step (solveStep has already counted it), there is no previous step
+    if (stepNbr_ == 1)
+    {
+        rhoPrev_ = rho;
+        ViPrev_  = V;
+    }
+
+    rhoExt_ = rho * 2. - rhoPrev_;
+    ViExt_  = V * 2. - ViPrev_;
+
+    for (uint32 iNode = 0; iNode < rho.size(); ++iNode)
+    {
+        if (rhoExt_(iNode) < 0.5 * rho(iNode))
+        {
+            rhoExt_(iNode) = rho(iNode);
+
+            for (uint32 iComp = 0; iComp < NBR_COMPO; ++iComp)
+                ViExt_.component(iComp)(iNode) = V.component(iComp)(iNode);
+        }
+    }
+
+    rhoPrev_ = rho;
+    ViPrev_  = V;
+}
+
+
+
+
+/**
+ * @brief Solver::fieldStage_ computes the fields (Bnew, Enew) at t=n+1 of a
+ * stage of the step, from the fields at t=n 'EMFields' and the ion density
+ * Ni and bulk velocity Vi at t=n+1 given by the stage.
+ *
+ * Without subcycling, B is advanced with 'Efaraday', the electric field given
+ * by the stage. Otherwise, see subcycleFields_. With the semi-implicit field
+ * solve, the Hall term of this Faraday step, which is the one of 'Bfaraday',
+ * is then made implicit.
+ */
+void Solver::fieldStage_(VecField const& Efaraday, VecField const& Bfaraday,
+                         Electromag const& EMFields, VecField& Bnew, VecField& Enew,
+                         Field const& Ni, VecField const& Vi, Electrons& electrons,
+                         BoundaryCondition& boundaryCondition)
+{
+    if (semiImplicitHall1D_)
+    {
+        advanceB_(FieldStep::particle, Efaraday, EMFields.getB(), Bexplicit_, boundaryCondition);
+
+        (*semiImplicitHall1D_)(EMFields.getB(), Bfaraday, Bexplicit_, Ni,
+                               boundaryCondition.isPeriodic(), Bnew);
+        boundaryCondition.applyMagneticBC(Bnew);
+
+        computeE_(Bnew, Enew, Ni, Vi, electrons, boundaryCondition);
+    }
+    else if (fieldSubcycles_ == 1)
+    {
+        advanceB_(FieldStep::particle, Efaraday, EMFields.getB(), Bnew, boundaryCondition);
+        computeE_(Bnew, Enew, Ni, Vi, electrons, boundaryCondition);
+    }
+    else
+    {
+        subcycleFields_(EMFields, Bnew, Enew, Ni, Vi, electrons, boundaryCondition);
+    }
+}
+
+
+
+
+/**
+ * @brief Solver::subcycleFields_ advances the fields from t=n to t=n+1 with
+ * 'fieldSubcycles_' substeps of size h, so that the field time step is not
+ * limited by the particle one.
+ *
+ * B is advanced with the modified midpoint method: an Euler substep, leapfrog
+ * substeps B_{m+1} = B_{m-1} - 2h curl E_m, and a last smoothing step
+ * B = (B_N + B_{N-1} - h curl E_N) / 2. Unlike Runge-Kutta substeps, leapfrog is
+ * not unstable for the undamped whistler modes that limit the time step.
+ *
+ * E_m is given by Ohm's law with the ion moments interpolated in time at the
+ * substep, between those at t=n and (Ni, Vi), those of the stage at t=n+1.
+ *
+ * The boundary conditions are applied at each substep, at the time of the
+ * particle step for time dependent boundaries.
+ */
+void Solver::subcycleFields_(Electromag const& EMFields, VecField& Bnew, VecField& Enew,
+                             Field const& Ni, VecField const& Vi, Electrons& electrons,
+                             BoundaryCondition& boundaryCondition)
+{
+    // start from the fields and the ion moments at t=n, the buffers are only
+    // allocated by these copies at the first call and reused afterwards
+    BsubPrev_ = EMFields.getB();
+    Bsub_     = BsubPrev_;
+    Esub_     = EMFields.getE();
+    rhoSub_   = rhoN_;
+    ViSub_    = ViN_;
+
+    advanceB_(FieldStep::substep, Esub_, BsubPrev_, Bsub_, boundaryCondition);
+    interpolateMoments_(Ni, Vi, 1. / fieldSubcycles_);
+    computeE_(Bsub_, Esub_, rhoSub_, ViSub_, electrons, boundaryCondition);
+
+    for (uint32 iSub = 2; iSub <= fieldSubcycles_; ++iSub)
+    {
+        advanceB_(FieldStep::leapfrog, Esub_, BsubPrev_, BsubPrev_, boundaryCondition);
+        std::swap(Bsub_, BsubPrev_);
+
+        interpolateMoments_(Ni, Vi, static_cast<double>(iSub) / fieldSubcycles_);
+        computeE_(Bsub_, Esub_, rhoSub_, ViSub_, electrons, boundaryCondition);
+    }
+
+    advanceB_(FieldStep::substep, Esub_, BsubPrev_, BsubPrev_, boundaryCondition);
+    Bnew = (Bsub_ + BsubPrev_) * 0.5;
+    boundaryCondition.applyMagneticBC(Bnew);
+
+    computeE_(Bnew, Enew, rhoSub_, ViSub_, electrons, boundaryCondition);
+}
+
+
+
+
+/**
+ * @brief Solver::interpolateMoments_ interpolates the ion density and bulk
+ * velocity between t=n (weight 0) and (Ni, Vi) at t=n+1 (weight 1)
+ */
+void Solver::interpolateMoments_(Field const& Ni, VecField const& Vi, double weight)
+{
+    rhoSub_ = rhoN_ + (Ni - rhoN_) * weight;
+    ViSub_  = ViN_ + (Vi - ViN_) * weight;
+}
+
+
+
+
+/**
+ * @brief Solver::advanceB_ advances B to Bnew with Faraday's law using
+ * 'Efaraday' over the time 'step', and applies the boundary condition.
+ * In 1D, the fused FieldSolver1D is used.
+ */
+void Solver::advanceB_(FieldStep step, VecField const& Efaraday, VecField const& B,
+                       VecField& Bnew, BoundaryCondition& boundaryCondition)
+{
+    switch (step)
+    {
+        case FieldStep::particle:
+            if (fieldSolver1D_)
+                fieldSolver1D_->faraday(Efaraday, B, Bnew);
+            else
+                faraday_(Efaraday, B, Bnew);
+            break;
+
+        case FieldStep::substep:
+            if (substepFieldSolver1D_)
+                substepFieldSolver1D_->faraday(Efaraday, B, Bnew);
+            else
+                substepFaraday_(Efaraday, B, Bnew);
+            break;
+
+        case FieldStep::leapfrog:
+            if (leapfrogFieldSolver1D_)
+                leapfrogFieldSolver1D_->faraday(Efaraday, B, Bnew);
+            else
+                leapfrogFaraday_(Efaraday, B, Bnew);
+            break;
+    }
+
+    boundaryCondition.applyMagneticBC(Bnew);
+}
+
+
+
+
+/**
+ * @brief Solver::computeE_ computes J from B and then E from Ohm's law with
+ * the ion density Ni and bulk velocity Vi, applying the boundary conditions
+ * after each of them.
+ *
+ * In 1D, the fused FieldSolver1D computes each of them in a single sweep and
+ * the electron bulk velocity on the fly.
+ */
+void Solver::computeE_(VecField const& B, VecField& E, Field const& Ni, VecField const& Vi,
+                       Electrons& electrons, BoundaryCondition& boundaryCondition)
+{
+    if (fieldSolver1D_)
+    {
+        fieldSolver1D_->ampere(B, Jtot_);
+        boundaryCondition.applyCurrentBC(Jtot_);
+
+        fieldSolver1D_->ohm(B, Ni, Vi, Jtot_, E);
+        boundaryCondition.applyElectricBC(E);
+        return;
+    }
 
-    // Compute J
     ampere_(B, Jtot_);
     boundaryCondition.applyCurrentBC(Jtot_);
 
+    VecField const& Ve = electrons.bulkVel(Vi, Ni, Jtot_);
+    Field const& Pe    = electrons.pressure(Ni);
 
-    // --> Get electron moments at time n with Pred2 ion moments
-    VecField const& Vecorr = electrons.bulkVel(ions.bulkVel(), ions.rho(), Jtot_);
-    Field const& Pecorr    = electrons.pressure(ions.rho());
-
-    // --> Get CORRECTED electric field E^{n+1} from Ohm's law
-    // --> using (n^{n+1}, u^{n+1}) cor and B_{n+1} cor
-    ohm_(B, ions.rho(), Vecorr, Pecorr, Jtot_, E);
-    // BC Fields --> Apply boundary conditions on the electric field
+    ohm_(B, Ni, Ve, Pe, Jtot_, E);
     boundaryCondition.applyElectricBC(E);
 }
 
 
 
 
-// convenience function that counts the maximum number of particles over
-// all species. this is useful to allocated the temporary particle buffer
-std::vector<Particle>::size_type maxNbrParticles(Ions const& ions)
+// move the particles of one species with 'pusher', accumulate its moments
+template<uint32 order>
+void Solver::moveSpecies_(VecField const& E, VecField const& B, Species& species, Pusher& pusher,
+                          BoundaryCondition& boundaryCondition, uint32 predictorStep,
+                          Interpolator<order> const& interpolator)
 {
-    // find the largest particles number accross all species
-    auto nbrParticlesMax = ions.species(0).nbrParticles();
-    auto nbrSpecies      = ions.nbrSpecies();
+    ParticleArray& particles = species.particles();
 
-    for (uint32 ispe = 0; ispe < nbrSpecies; ++ispe)
+
+    // at the first predictor step we must not overwrite particles
+    // at t=n with particles at t=n+1 because time n will be used
+    // in the second push. Particles at n+1 are only needed for the
+    // predicted moments, so we advance them by chunks in a small buffer
+    // 'particleChunk_', deposit their moments right away and discard them.
+    // All the chunks are deposited in the deposit buffer of the species,
+    // which is copied in its moments once they all are.
+    if (predictorStep == predictor1_)
     {
-        Species const& species = ions.species(ispe);
-        auto nbrParticles      = species.nbrParticles();
+        species.startDeposit();
 
-        if (nbrParticlesMax < nbrParticles)
+        for (ParticleArray::size_type first = 0; first < particles.size();
+             first += predictorChunkSize_)
         {
-            nbrParticlesMax = nbrParticles;
+            auto count = std::min(particles.size() - first,
+                                  static_cast<ParticleArray::size_type>(predictorChunkSize_));
+            particleChunk_.assign(particles, first, count);
+
+            // move the particles of the chunk from n to n+1
+            pusher.move(particleChunk_, particleChunk_, species.mass(), E, B, interpolator,
+                        boundaryCondition);
+
+            depositChargeDensityAndFlux(interpolator, species, layout_, particleChunk_);
         }
+
+        // incoming particles are put in their own buffer
+        // we do not update GCA particles (flag set to false)
+        incomingParticles_.clear();
+        boundaryCondition.applyIncomingParticleBC(incomingParticles_, pusher.pusherType(),
+                                                  pusher.dt(), species.name(), false);
+
+        depositChargeDensityAndFlux(interpolator, species, layout_, incomingParticles_);
+        species.finishDeposit();
     }
-    return nbrParticlesMax;
-}
 
+    // we're at pred2, so we can update particles in place as we won't
+    // need their properties at t=n anymore
+    else if (predictorStep == predictor2_)
+    {
+        // move all particles of that species from n to n+1
+        pusher.move(particles, particles, species.mass(), E, B, interpolator, boundaryCondition);
+
+        // ------------------------------------------------------
+        //                INCOMING PARTICLE BC
+        // ------------------------------------------------------
+        // we update GCA particles (flag set to true)
+        boundaryCondition.applyIncomingParticleBC(particles, pusher.pusherType(), pusher.dt(),
+                                                  species.name(), true);
+
+        computeChargeDensityAndFlux(interpolator, species, layout_, particles);
+    }
+}
 
 
 
 // this routine move the ions for all species, accumulate their moments
 // and compute the total ion moments.
+//
+// A species with a push interval k > 1 is only pushed at the first step of
+// each interval, from its start to its end with a time step k*dt. At all the
+// steps of the interval, its moments at t=n+1 are interpolated in time
+// between those at the start and at the end of the interval.
 void Solver::moveIons_(VecField const& E, VecField const& B, Ions& ions,
                        BoundaryCondition& boundaryCondition, uint32 predictorStep)
 {
-    // the temporary buffer must be big enough to hold the max
-    // number of particles
-    auto nbrParticlesMax = maxNbrParticles(ions);
-    if (particleArrayPred_.size() < nbrParticlesMax)
+    for (uint32 ispe = 0; ispe < ions.nbrSpecies(); ++ispe)
     {
-        particleArrayPred_.resize(nbrParticlesMax);
-    }
+        Species& species    = ions.species(ispe);
+        uint32 pushInterval = species.pushInterval();
+
+        if (pushPhase_(species) == 0)
+        {
+            Pusher& pusher = pushInterval > 1 ? *speciesPushers_[ispe] : *pusher_;
+
+            // the interpolation order is only known at runtime, we dispatch
+            // once per species to a mover working with an Interpolator<order>
+            switch (interpolationOrder_)
+            {
+                case 1:
+                    moveSpecies_(E, B, species, pusher, boundaryCondition, predictorStep,
+                                 Interpolator<1>{});
+                    break;
+                case 2:
+                    moveSpecies_(E, B, species, pusher, boundaryCondition, predictorStep,
+                                 Interpolator<2>{});
+                    break;
+                case 3:
+                    moveSpecies_(E, B, species, pusher, boundaryCondition, predictorStep,
+                                 Interpolator<3>{});
+                    break;
+                case 4:
+                    moveSpecies_(E, B, species, pusher, boundaryCondition, predictorStep,
+                                 Interpolator<4>{});
+                    break;
+                default: throw std::runtime_error("Solver - wrong interpolation order");
+            }
+        }
+    } // end loop on species
 
 
     for (uint32 ispe = 0; ispe < ions.nbrSpecies(); ++ispe)
     {
-        Species& species                 = ions.species(ispe);
-        std::vector<Particle>& particles = species.particles();
+        Species& species    = ions.species(ispe);
+        uint32 pushInterval = species.pushInterval();
+        uint32 pushPhase    = pushPhase_(species);
 
+        // the flux boundary condition sums the ghost nodes of the species, it
+        // must be applied once to the deposited fluxes, before they are kept,
+        // and not to the interpolated ones
+        if (pushPhase == 0)
+            boundaryCondition.applyFluxBC(ions, ispe);
 
-        // at the first predictor step we must not overwrite particles
-        // at t=n with particles at t=n+1 because time n will be used
-        // in the second push. we rather put particles at time n+1 in a
-        // temporary buffer particleArrayPred_
-        if (predictorStep == predictor1_)
+        if (pushInterval > 1)
         {
-            // resize the buffer so that charge density and fluxes use
-            // no more than the right number of particles
-            // particleArrayPred_ has a capacity that is large enough for all
-            // particle arrays for all species.
-            particleArrayPred_.resize(particles.size());
+            if (pushPhase == 0)
+                species.keepEndMoments();
 
+            species.interpolateMoments(static_cast<double>(pushPhase + 1) / pushInterval);
+        }
+    }
 
-            // move all particles of that species from n to n+1
-            // and put the advanced particles in the predictor buffer 'particleArrayPred_'
-            pusher_->move(particles, particleArrayPred_, species.mass(), E, B, interpolator_,
-                          boundaryCondition);
+    // total moments in one sweep over the species, the density boundary
+    // condition only corrects the total density before the flux is divided
+    ions.computeDensityAndFlux();
+    boundaryCondition.applyDensityBC(ions.rho());
+    ions.divideFluxByDensity();
+}
 
-            // we do not update GCA particles (flag set to false)
-            boundaryCondition.applyIncomingParticleBC(particleArrayPred_, pusher_->pusherType(),
-                                                      pusher_->dt(), species.name(), false);
 
-            computeChargeDensityAndFlux(interpolator_, species, layout_, particleArrayPred_);
-        }
 
-        // we're at pred2, so we can update particles in place as we won't
-        // need their properties at t=n anymore
-        else if (predictorStep == predictor2_)
-        {
-            // move all particles of that species from n to n+1
-            pusher_->move(particles, particles, species.mass(), E, B, interpolator_,
-                          boundaryCondition);
-
-            // ------------------------------------------------------
-            //                INCOMING PARTICLE BC
-            // ------------------------------------------------------
-            // we update GCA particles (flag set to true)
-            boundaryCondition.applyIncomingParticleBC(particles, pusher_->pusherType(),
-                                                      pusher_->dt(), species.name(), true);
-
-            computeChargeDensityAndFlux(interpolator_, species, layout_, particles);
-        }
 
+/**
+ * @brief Solver::pushPhase_ is the index of the current step in the push
+ * interval of 'species', the species being pushed at phase 0
+ */
+uint32 Solver::pushPhase_(Species const& species) const
+{
+    return (stepNbr_ - 1) % species.pushInterval();
+}
 
 
-    } // end loop on species
 
 
-    ions.computeChargeDensity();
-    boundaryCondition.applyDensityBC(ions.rho());
+/**
+ * @brief Solver::startPushIntervals_ keeps the moments at t=n of the species
+ * pushed every k > 1 steps that start a push interval at this step, so that
+ * their moments are then interpolated from them.
+ */
+void Solver::startPushIntervals_(Ions& ions)
+{
+    for (uint32 ispe = 0; ispe < ions.nbrSpecies(); ++ispe)
+    {
+        Species& species = ions.species(ispe);
+
+        if (species.pushInterval() > 1 && pushPhase_(species) == 0)
+            species.keepStartMoments();
+    }
+}
 
-    boundaryCondition.applyFluxBC(ions);
-    ions.computeBulkVelocity();
+
+
+
+/**
+ * @brief Solver::sortIons_ sorts the particles of each species by cell every
+ * sortEvery_ steps, or when they are scattered in memory enough for their
+ * disorder to exceed sortThreshold_, so that the field gathers and the
+ * moment deposition access the mesh contiguously.
+ */
+void Solver::sortIons_(Ions& ions)
+{
+    bool sortDue = sortEvery_ > 0 && stepNbr_ % sortEvery_ == 0;
+
+    for (uint32 ispe = 0; ispe < ions.nbrSpecies(); ++ispe)
+    {
+        Species& species = ions.species(ispe);
+
+        if (sortDue
+            || (sortThreshold_ > 0. && species.particleDisorder(layout_) > sortThreshold_))
+        {
+            species.sortParticles(layout_);
+        }
+    }
 }
@@ -10,6 +10,8 @@
 #include "core/Faraday/faraday.h"
 #include "core/Interpolator/interpolator.h"
 #include "core/Ohm/ohm.h"
+#include "core/Solver/fieldsolver1d.h"
+#include "core/Solver/semiimplicithall1d.h"
 #include "core/pusher/pusher.h"
 
 #include "initializer/solverinitializer.h"
@@ -36,19 +38,116 @@ private:
     Electromag EMFieldsPred_;
     Electromag EMFieldsAvg_;
     VecField Jtot_;
-    std::vector<Particle> particleArrayPred_;
+
+    // at the first predictor step, particles are advanced by chunks of
+    // 'predictorChunkSize_' particles, made of whole pusher chunks, small
+    // enough to stay in cache and large enough to keep the threads busy,
+    // see SolverInitializer
+    uint32 predictorChunkSize_;
+    ParticleArray particleChunk_;
+    ParticleArray incomingParticles_;
 
 
     // algorithms
     Faraday faraday_;
     Ampere ampere_;
     Ohm ohm_;
-    Interpolator interpolator_;
+
+    // fused field stages, used instead of faraday_, ampere_ and ohm_ in 1D
+    std::unique_ptr<FieldSolver1D> fieldSolver1D_;
+
+    // semi-implicit field solve: the Hall term of the Faraday steps is made
+    // implicit, B being first advanced explicitly in 'Bexplicit_'
+    std::unique_ptr<SemiImplicitHall1D> semiImplicitHall1D_;
+    VecField Bexplicit_;
+
+    // field subcycling: if 'fieldSubcycles_' > 1, each field stage of the
+    // step is made of that many substeps, see subcycleFields_. The Faraday
+    // operators below advance B by a substep and by two substeps.
+    uint32 fieldSubcycles_;
+    Faraday substepFaraday_;
+    Faraday leapfrogFaraday_;
+    std::unique_ptr<FieldSolver1D> substepFieldSolver1D_;
+    std::unique_ptr<FieldSolver1D> leapfrogFieldSolver1D_;
+
+    // magnetic field at the last two substeps, electric field at the last one
+    VecField Bsub_;
+    VecField BsubPrev_;
+    VecField Esub_;
+
+    // ion moments at t=n and interpolated at the current substep
+    Field rhoN_;
+    VecField ViN_;
+    Field rhoSub_;
+    VecField ViSub_;
+
+    // time integration scheme of a step, see solveStep
+    enum class Scheme { PPC, momentExtrapolation };
+    Scheme scheme_;
+
+    // moment extrapolation: ion moments at t=n-1 and extrapolated at t=n+1
+    Field rhoPrev_;
+    VecField ViPrev_;
+    Field rhoExt_;
+    VecField ViExt_;
+
+    uint32 interpolationOrder_;
     std::unique_ptr<Pusher> pusher_;
 
+    // pushers of the species pushed every k > 1 steps, with a time step k*dt,
+    // null for the species pushed at every step, see moveIons_
+    std::vector<std::unique_ptr<Pusher>> speciesPushers_;
+
+    // cell sorting of the particles
+    uint32 sortEvery_;
+    double sortThreshold_;
+
+    // number of the current step, from 1, counted by solveStep
+    uint32 stepNbr_;
+
+    template<uint32 order>
+    void moveSpecies_(VecField const& E, VecField const& B, Species& species, Pusher& pusher,
+                      BoundaryCondition& boundaryCondition, uint32 predictorStep,
+                      Interpolator<order> const& interpolator);
+
+    // the steps of the two schemes, see solveStep
+    void solveStepPPC_(Electromag& EMFields, Ions& ions, Electrons& electrons,
+                       BoundaryCondition& boundaryCondition);
+
+    void solveStepExtrapolation_(Electromag& EMFields, Ions& ions, Electrons& electrons,
+                                 BoundaryCondition& boundaryCondition);
+
     void moveIons_(VecField const& E, VecField const& B, Ions& ions,
                    BoundaryCondition& boundaryConditon, uint32 const predictorStep);
 
+    void sortIons_(Ions& ions);
+
+    uint32 pushPhase_(Species const& species) const;
+
+    void startPushIntervals_(Ions& ions);
+
+    void extrapolateMoments_(Ions const& ions);
+
+    void fieldStage_(VecField const& Efaraday, VecField const& Bfaraday,
+                     Electromag const& EMFields, VecField& Bnew, VecField& Enew, Field const& Ni,
+                     VecField const& Vi, Electrons& electrons,
+                     BoundaryCondition& boundaryCondition);
+
+    void subcycleFields_(Electromag const& EMFields, VecField& Bnew, VecField& Enew,
+                         Field const& Ni, VecField const& Vi, Electrons& electrons,
+                         BoundaryCondition& boundaryCondition);
+
+    void interpolateMoments_(Field const& Ni, VecField const& Vi, double weight);
+
+    // time step of a Faraday operation
+    enum class FieldStep { particle, substep, leapfrog };
+
+    void advanceB_(FieldStep step, VecField const& Efaraday, VecField const& B, VecField& Bnew,
+                   BoundaryCondition& boundaryCondition);
+
+    void computeE_(VecField const& B, VecField& E, Field const& Ni, VecField const& Vi,
+                   Electrons& electrons, BoundaryCondition& boundaryCondition);
+
 public:
     Solver(GridLayout const& layout, double dt,
            std::unique_ptr<SolverInitializer> solverInitializer);
@@ -61,8 +160,8 @@ public:
 
     void init(Ions& ions, BoundaryCondition const& boundaryCondition);
 
-    void solveStepPPC(Electromag& EMFields, Ions& ions, Electrons& electrons,
-                      BoundaryCondition& boundaryCondition);
+    void solveStep(Electromag& EMFields, Ions& ions, Electrons& electrons,
+                   BoundaryCondition& boundaryCondition);
 };
 
 
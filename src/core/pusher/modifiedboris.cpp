@@ -1,5 +1,7 @@
 
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
 
 #include "core/Interpolator/interpolator.h"
 #include "core/Interpolator/particlemesh.h"
@@ -8,12 +10,11 @@
 
 
 /**
- * @brief ModifiedBoris::move1D
+ * @brief ModifiedBoris::move_
  *
  * STEP 1: pre-push coordinates
- * STEP 2: compute fields at particles coordinates
- * STEP 3: push velocities
- * STEP 4: correction push for coordinates
+ * STEP 2: push velocities with the fields interpolated at particles coordinates
+ * STEP 3: correction push for coordinates
  *
  * @param partIn positions and velocities at time tn
  * @param partPred positions and velocities at time tpred
@@ -22,9 +23,11 @@
  * @param E is given at tn+1/2
  * @param B is given at tn+1/2
  */
-void ModifiedBoris::move(std::vector<Particle> const& partIn, std::vector<Particle>& partOut,
-                         double mass, VecField const& E, VecField const& B,
-                         Interpolator& interpolator, BoundaryCondition& boundaryCondition)
+template<uint32 order>
+void ModifiedBoris::move_(ParticleArray const& partIn, ParticleArray& partOut, double mass,
+                          VecField const& E, VecField const& B,
+                          Interpolator<order> const& interpolator,
+                          BoundaryCondition& boundaryCondition)
 {
     // must clean the leaving particles buffer before the last step
     // since newly leaving particles will be added to it.
@@ -36,11 +39,24 @@ void ModifiedBoris::move(std::vector<Particle> const& partIn, std::vector<Partic
     prePush_(partIn, partOut);
     boundaryCondition.applyOutgoingParticleBC(partOut, leavingParticles_);
 
-    // get fields(n+1/2) at position partOut now at n+11/2
-    fieldsAtParticles(interpolator, E, B, layout_, partOut);
-
-    // push velocity from partIn (n) to n+1 using fields at partOut(n+1/2)
-    pushVelocity_(partOut, partOut, mass);
+    // push velocity from partIn (n) to n+1 using fields(n+1/2) interpolated
+    // at position partOut, now at n+1/2
+    switch (nbdims_)
+    {
+        case 1:
+            pushVelocity_(partOut, partOut, mass,
+                          ElectromagAtParticle<1, order>{interpolator, E, B, layout_});
+            break;
+        case 2:
+            pushVelocity_(partOut, partOut, mass,
+                          ElectromagAtParticle<2, order>{interpolator, E, B, layout_});
+            break;
+        case 3:
+            pushVelocity_(partOut, partOut, mass,
+                          ElectromagAtParticle<3, order>{interpolator, E, B, layout_});
+            break;
+        default: throw std::runtime_error("ModifiedBoris - wrong dimensionality");
+    }
 
     // must clean the leaving particles buffer before the last step
     // since newly leaving particles will be added to it.
@@ -52,151 +68,204 @@ void ModifiedBoris::move(std::vector<Particle> const& partIn, std::vector<Partic
 }
 
 
+void ModifiedBoris::move(ParticleArray const& partIn, ParticleArray& partOut, double m,
+                         VecField const& E, VecField const& B, Interpolator<1> const& interpolator,
+                         BoundaryCondition& boundaryCondition)
+{
+    move_(partIn, partOut, m, E, B, interpolator, boundaryCondition);
+}
 
 
-void ModifiedBoris::prePush_(std::vector<Particle> const& particleIn,
-                             std::vector<Particle>& particleOut)
+void ModifiedBoris::move(ParticleArray const& partIn, ParticleArray& partOut, double m,
+                         VecField const& E, VecField const& B, Interpolator<2> const& interpolator,
+                         BoundaryCondition& boundaryCondition)
 {
-    std::array<double, 3> dto2dl;
-    // here dy and dz might be zero (1D, 2D) so dfo2dl[1,2] might be Inf
-    // but that's ok because we loop on nbdims_
-    dto2dl[0] = 0.5 * dt_ / layout_.dx();
-    dto2dl[1] = 0.5 * dt_ / layout_.dy();
-    dto2dl[2] = 0.5 * dt_ / layout_.dz();
+    move_(partIn, partOut, m, E, B, interpolator, boundaryCondition);
+}
 
 
-    for (uint32 iPart = 0; iPart < particleIn.size(); ++iPart)
-    {
-        Particle const& partIn = particleIn[iPart];
-        Particle& partOut      = particleOut[iPart];
-        partOut.weight         = partIn.weight;
-        partOut.charge         = partIn.charge;
-        for (uint32 iv    = 0; iv < 3; ++iv)
-            partOut.v[iv] = partIn.v[iv];
+void ModifiedBoris::move(ParticleArray const& partIn, ParticleArray& partOut, double m,
+                         VecField const& E, VecField const& B, Interpolator<3> const& interpolator,
+                         BoundaryCondition& boundaryCondition)
+{
+    move_(partIn, partOut, m, E, B, interpolator, boundaryCondition);
+}
 
-        for (uint32 dim = 0; dim < nbdims_; ++dim)
-        {
-            // time decentering of the delta position at tn+1/2
-            float delta = partIn.delta[dim] + static_cast<float>(dto2dl[dim] * partIn.v[dim]);
-
-            // check the validity of delta (0 <= delta <= 1)
-            // and do auto-correction
-            float iCell        = std::floor(delta);
-            partOut.delta[dim] = delta - iCell;
-            assert(partOut.delta[dim] <= 1 && partOut.delta[dim] >= 0
-                   && "Error in prePush_ : absolute value of delta is out of [0, 1] range");
-
-            // update the logical node
-            partOut.icell[dim] = iCell + partIn.icell[dim];
-
-            // check if the particle is now leaving the patch
-            // and if it does, store it in the leavingParticles buffers
-            leavingParticles_.storeIfLeaving(partOut.icell[dim], iPart, dim);
-        }
-    }
+
+void ModifiedBoris::move(ParticleArray const& partIn, ParticleArray& partOut, double m,
+                         VecField const& E, VecField const& B, Interpolator<4> const& interpolator,
+                         BoundaryCondition& boundaryCondition)
+{
+    move_(partIn, partOut, m, E, B, interpolator, boundaryCondition);
 }
 
 
 
 
-void ModifiedBoris::pushVelocity_(std::vector<Particle> const& particleIn,
-                                  std::vector<Particle>& particleOut, double m)
+void ModifiedBoris::prePush_(ParticleArray const& particleIn, ParticleArray& particleOut)
 {
-    double dto2m = 0.5 * dt_ / m;
-
-    for (uint32 iPart = 0; iPart < particleIn.size(); ++iPart)
+    // weight, charge and velocity are unchanged by the pre-push
+    // they only need to be copied when pushing out of place
+    if (&particleIn != &particleOut)
     {
-        Particle const& partIn = particleIn[iPart];
-        Particle& partOut      = particleOut[iPart];
-
-        double coef1 = partIn.charge * dto2m;
+        particleOut.weight() = particleIn.weight();
+        particleOut.charge() = particleIn.charge();
+        for (uint32 iv = 0; iv < 3; ++iv)
+            particleOut.v(iv) = particleIn.v(iv);
 
-        // We now apply the 3 steps of the BORIS PUSHER
-
-        // 1st half push of the electric field
-        double velx1 = partIn.v[0] + coef1 * partIn.Ex;
-        double vely1 = partIn.v[1] + coef1 * partIn.Ey;
-        double velz1 = partIn.v[2] + coef1 * partIn.Ez;
+        for (uint32 dim = nbdims_; dim < 3; ++dim)
+        {
+            particleOut.icell(dim) = particleIn.icell(dim);
+            particleOut.delta(dim) = particleIn.delta(dim);
+        }
+    }
 
+    // time decentering of the delta position at tn+1/2
+    advancePositions_(particleIn, particleIn, particleOut);
+}
 
-        // preparing variables for magnetic rotation
-        double const rx = coef1 * partIn.Bx;
-        double const ry = coef1 * partIn.By;
-        double const rz = coef1 * partIn.Bz;
 
-        double const rx2  = rx * rx;
-        double const ry2  = ry * ry;
-        double const rz2  = rz * rz;
-        double const rxry = rx * ry;
-        double const rxrz = rx * rz;
-        double const ryrz = ry * rz;
 
-        double const invDet = 1. / (1. + rx2 + ry2 + rz2);
 
-        // preparing rotation matrix due to the magnetic field
-        // m = invDet*(I + r*r - r x I) - I where x denotes the cross product
-        double const mxx = 1. + rx2 - ry2 - rz2;
-        double const mxy = 2. * (rxry + rz);
-        double const mxz = 2. * (rxrz - ry);
+/**
+ * @brief ModifiedBoris::advancePositions_ advances the positions of
+ * 'particleIn' by half a time step with their velocity, starting from the
+ * nodes of 'nodesIn', and stores them in 'particleOut'.
+ *
+ * Particles are processed by chunks, possibly by several threads. Each chunk
+ * stores its leaving particles in its own buffer, and the buffers are then
+ * appended in chunk order, so that the leaving particles are stored in the
+ * same order as when running on one thread.
+ */
+void ModifiedBoris::advancePositions_(ParticleArray const& particleIn,
+                                      ParticleArray const& nodesIn, ParticleArray& particleOut)
+{
+    std::array<double, 3> dto2dl;
+    // here dy and dz might be zero (1D, 2D) so dfo2dl[1,2] might be Inf
+    // but that's ok because we loop on nbdims_
+    dto2dl[0] = 0.5 * dt_ / layout_.dx();
+    dto2dl[1] = 0.5 * dt_ / layout_.dy();
+    dto2dl[2] = 0.5 * dt_ / layout_.dz();
 
-        double const myx = 2. * (rxry - rz);
-        double const myy = 1. + ry2 - rx2 - rz2;
-        double const myz = 2. * (ryrz + rx);
+    uint32 nbrParticles = static_cast<uint32>(particleIn.size());
+    uint32 nbrChunks    = (nbrParticles + chunkSize - 1) / chunkSize;
 
-        double const mzx = 2. * (rxrz + ry);
-        double const mzy = 2. * (ryrz - rx);
-        double const mzz = 1. + rz2 - rx2 - ry2;
+    if (chunkLeavingParticles_.size() < nbrChunks)
+    {
+        chunkLeavingParticles_.resize(nbrChunks, LeavingParticles{layout_});
+    }
 
-        // magnetic rotation
-        double const velx2 = (mxx * velx1 + mxy * vely1 + mxz * velz1) * invDet;
-        double const vely2 = (myx * velx1 + myy * vely1 + myz * velz1) * invDet;
-        double const velz2 = (mzx * velx1 + mzy * vely1 + mzz * velz1) * invDet;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (uint32 iChunk = 0; iChunk < nbrChunks; ++iChunk)
+    {
+        uint32 first      = iChunk * chunkSize;
+        uint32 nbrInChunk = std::min(nbrParticles - first, uint32{chunkSize});
 
+        LeavingParticles& leavingParticles = chunkLeavingParticles_[iChunk];
+        leavingParticles.cleanBuffers();
 
-        // 2nd half push of the electric field
-        velx1 = velx2 + coef1 * partIn.Ex;
-        vely1 = vely2 + coef1 * partIn.Ey;
-        velz1 = velz2 + coef1 * partIn.Ez;
+        for (uint32 dim = 0; dim < nbdims_; ++dim)
+        {
+            std::vector<int32>& icellOut = particleOut.icell(dim);
+            std::vector<float>& deltaOut = particleOut.delta(dim);
+
+            // update the delta position and the logical node
+            advancePosition_(nbrInChunk, dto2dl[dim], &particleIn.delta(dim)[first],
+                             &particleIn.v(dim)[first], &nodesIn.icell(dim)[first],
+                             &deltaOut[first], &icellOut[first]);
+
+            for (uint32 iPart = first; iPart < first + nbrInChunk; ++iPart)
+            {
+                assert(deltaOut[iPart] <= 1 && deltaOut[iPart] >= 0
+                       && "Error in advancePositions_ : delta is out of [0, 1] range");
+
+                // check if the particle is now leaving the patch
+                // and if it does, store it in the leavingParticles buffers
+                leavingParticles.storeIfLeaving(icellOut[iPart], iPart, dim);
+            }
+        }
+    }
 
-        // Update particle velocity
-        partOut.v[0] = velx1;
-        partOut.v[1] = vely1;
-        partOut.v[2] = velz1;
+    for (uint32 iChunk = 0; iChunk < nbrChunks; ++iChunk)
+    {
+        leavingParticles_.append(chunkLeavingParticles_[iChunk]);
     }
 }
 
 
-void ModifiedBoris::postPush_(std::vector<Particle> const& particleIn,
-                              std::vector<Particle>& particleOut)
+
+
+/**
+ * @brief ModifiedBoris::pushVelocity_ gathers E and B at the particle
+ * positions and immediately applies the Boris push, so that the fields never
+ * need to be stored in the particle array.
+ *
+ * Particles are processed by blocks, possibly by several threads: the fields
+ * of a block are gathered in small buffers that stay in cache, and the
+ * vectorized Boris kernel pushes the whole block.
+ */
+template<typename FieldsAtParticle>
+void ModifiedBoris::pushVelocity_(ParticleArray const& particleIn, ParticleArray& particleOut,
+                                  double m, FieldsAtParticle fieldsAtParticle)
 {
-    std::array<double, 3> dto2dl;
-    dto2dl[0] = 0.5 * dt_ / layout_.dx();
-    dto2dl[1] = 0.5 * dt_ / layout_.dy();
-    dto2dl[2] = 0.5 * dt_ / layout_.dz();
+    double dto2m = 0.5 * dt_ / m;
 
+    uint32 nbrParticles = static_cast<uint32>(particleIn.size());
+    uint32 nbrBlocks    = (nbrParticles + blockSize - 1) / blockSize;
 
-    for (uint32 iPart = 0; iPart < particleIn.size(); ++iPart)
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
     {
-        Particle const& partIn = particleIn[iPart];
-        Particle& partOut      = particleOut[iPart];
+        std::array<std::array<double, blockSize>, 3> Eblock;
+        std::array<std::array<double, blockSize>, 3> Bblock;
 
-        for (uint32 dim = 0; dim < nbdims_; ++dim)
+        std::array<double const*, 3> E{{Eblock[0].data(), Eblock[1].data(), Eblock[2].data()}};
+        std::array<double const*, 3> B{{Bblock[0].data(), Bblock[1].data(), Bblock[2].data()}};
+
+        std::array<double, 3> Epart;
+        std::array<double, 3> Bpart;
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+        for (uint32 iBlock = 0; iBlock < nbrBlocks; ++iBlock)
         {
-            // we update the delta position at tn+1
-            float delta = partIn.delta[dim] + static_cast<float>(dto2dl[dim] * partIn.v[dim]);
-
-            // check the validity of delta (0 <= delta <= 1)
-            // and do auto-correction
-            float iCell        = std::floor(delta);
-            partOut.delta[dim] = delta - iCell;
-            assert(partOut.delta[dim] <= 1 && partOut.delta[dim] >= 0
-                   && "Error in postPush_ : absolute value of delta is out of [0, 1] range");
-            // update the logical node
-            partOut.icell[dim] += iCell;
-
-            // check if the particle is now leaving the patch
-            // and if it does, store it in the leavingParticles buffers
-            leavingParticles_.storeIfLeaving(partOut.icell[dim], iPart, dim);
+            uint32 first      = iBlock * blockSize;
+            uint32 nbrInBlock = std::min(nbrParticles - first, uint32{blockSize});
+
+            for (uint32 ik = 0; ik < nbrInBlock; ++ik)
+            {
+                uint32 iPart = first + ik;
+
+                fieldsAtParticle(particleIn, iPart, Epart, Bpart);
+
+                for (uint32 iComp = 0; iComp < 3; ++iComp)
+                {
+                    Eblock[iComp][ik] = Epart[iComp];
+                    Bblock[iComp][ik] = Bpart[iComp];
+#ifdef DEBUG_PARTICLE_FIELDS
+                    particleOut.E(iComp)[iPart] = Epart[iComp];
+                    particleOut.B(iComp)[iPart] = Bpart[iComp];
+#endif
+                }
+            }
+
+            std::array<double const*, 3> vIn{
+                {&particleIn.v(0)[first], &particleIn.v(1)[first], &particleIn.v(2)[first]}};
+            std::array<double*, 3> vOut{
+                {&particleOut.v(0)[first], &particleOut.v(1)[first], &particleOut.v(2)[first]}};
+
+            borisPush_(nbrInBlock, dto2m, &particleIn.charge()[first], E, B, vIn, vOut);
         }
     }
 }
+
+
+void ModifiedBoris::postPush_(ParticleArray const& particleIn, ParticleArray& particleOut)
+{
+    // we update the delta position at tn+1, starting from the nodes at tn+1/2
+    advancePositions_(particleIn, particleOut, particleOut);
+}
@@ -2,6 +2,7 @@
 #define MODIFIEDBORIS_H
 
 #include "core/Interpolator/interpolator.h"
+#include "core/pusher/pushkernels.h"
 #include "pusher.h"
 
 /**
@@ -10,23 +11,57 @@
 class ModifiedBoris : public Pusher
 {
 private:
-    void prePush_(std::vector<Particle> const& particleIn, std::vector<Particle>& particleOut);
+    // number of particles whose fields are gathered before pushing their velocities
+    static const uint32 blockSize = 64;
 
-    void pushVelocity_(std::vector<Particle> const& particleIn, std::vector<Particle>& particleOut,
-                       double m);
+    // leaving particles found in each chunk, merged in chunk order into
+    // leavingParticles_ so that their order does not depend on the threads
+    std::vector<LeavingParticles> chunkLeavingParticles_;
 
-    void postPush_(std::vector<Particle> const& particleIn, std::vector<Particle>& particleOut);
+    // vectorized kernels selected for the CPU at construction
+    AdvancePositionKernel advancePosition_;
+    BorisKernel borisPush_;
+
+    template<uint32 order>
+    void move_(ParticleArray const& partIn, ParticleArray& partOut, double m, VecField const& E,
+               VecField const& B, Interpolator<order> const& interpolator,
+               BoundaryCondition& boundaryCondition);
+
+    void prePush_(ParticleArray const& particleIn, ParticleArray& particleOut);
+
+    void advancePositions_(ParticleArray const& particleIn, ParticleArray const& nodesIn,
+                           ParticleArray& particleOut);
+
+    template<typename FieldsAtParticle>
+    void pushVelocity_(ParticleArray const& particleIn, ParticleArray& particleOut, double m,
+                       FieldsAtParticle fieldsAtParticle);
+
+    void postPush_(ParticleArray const& particleIn, ParticleArray& particleOut);
 
 public:
     ModifiedBoris(GridLayout layout, std::string pusherType, double dt)
         : Pusher(std::move(layout), pusherType, dt)
+        , advancePosition_{advancePositionKernel(detectedSimdLevel())}
+        , borisPush_{borisKernel(detectedSimdLevel())}
     {
     }
 
     virtual ~ModifiedBoris() {}
 
-    virtual void move(std::vector<Particle> const& partIn, std::vector<Particle>& partOut, double m,
-                      VecField const& E, VecField const& B, Interpolator& interpolator,
+    virtual void move(ParticleArray const& partIn, ParticleArray& partOut, double m,
+                      VecField const& E, VecField const& B, Interpolator<1> const& interpolator,
+                      BoundaryCondition& boundaryCondition) override;
+
+    virtual void move(ParticleArray const& partIn, ParticleArray& partOut, double m,
+                      VecField const& E, VecField const& B, Interpolator<2> const& interpolator,
+                      BoundaryCondition& boundaryCondition) override;
+
+    virtual void move(ParticleArray const& partIn, ParticleArray& partOut, double m,
+                      VecField const& E, VecField const& B, Interpolator<3> const& interpolator,
+                      BoundaryCondition& boundaryCondition) override;
+
+    virtual void move(ParticleArray const& partIn, ParticleArray& partOut, double m,
+                      VecField const& E, VecField const& B, Interpolator<4> const& interpolator,
                       BoundaryCondition& boundaryCondition) override;
 };
 
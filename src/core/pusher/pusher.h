@@ -4,7 +4,7 @@
 #include "core/BoundaryConditions/boundary_conditions.h"
 #include "core/BoundaryConditions/leavingparticles.h"
 #include "core/Interpolator/interpolator.h"
-#include "data/Plasmas/particles.h"
+#include "data/Plasmas/particlearray.h"
 #include "data/grid/gridlayout.h"
 #include "data/vecfield/vecfield.h"
 
@@ -16,6 +16,10 @@
  */
 class Pusher
 {
+public:
+    // number of particles whose positions are advanced by one thread at a time
+    static const uint32 chunkSize = 4096;
+
 protected:
     uint32 nbdims_;
     GridLayout layout_;
@@ -43,8 +47,25 @@ public:
     // or move operations won't be generated
     virtual ~Pusher() = default;
 
-    virtual void move(std::vector<Particle> const& partIn, std::vector<Particle>& partOut, double m,
-                      VecField const& E, VecField const& B, Interpolator& interpolator,
+    // there is one overload per interpolation order, so that pushers work
+    // with an Interpolator<order> whose kernels are known at compile time
+    virtual void move(ParticleArray const& partIn, ParticleArray& partOut, double m,
+                      VecField const& E, VecField const& B, Interpolator<1> const& interpolator,
+                      BoundaryCondition& boundaryCondition)
+        = 0;
+
+    virtual void move(ParticleArray const& partIn, ParticleArray& partOut, double m,
+                      VecField const& E, VecField const& B, Interpolator<2> const& interpolator,
+                      BoundaryCondition& boundaryCondition)
+        = 0;
+
+    virtual void move(ParticleArray const& partIn, ParticleArray& partOut, double m,
+                      VecField const& E, VecField const& B, Interpolator<3> const& interpolator,
+                      BoundaryCondition& boundaryCondition)
+        = 0;
+
+    virtual void move(ParticleArray const& partIn, ParticleArray& partOut, double m,
+                      VecField const& E, VecField const& B, Interpolator<4> const& interpolator,
                       BoundaryCondition& boundaryCondition)
         = 0;
 
@@ -0,0 +1,396 @@
+#include <cmath>
+#include <stdexcept>
+
+#include "core/pusher/pushkernels.h"
+
+// this file is compiled with -ffp-contract=off (see core/CMakeLists.txt) so
+// that the compiler does not fuse multiplications and additions into FMAs in
+// the AVX-512 kernels, which would make them differ from the scalar ones.
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define PUSHKERNELS_X86_SIMD
+#include <immintrin.h>
+#endif
+
+
+
+SimdLevel detectedSimdLevel()
+{
+    static const SimdLevel level = []() -> SimdLevel {
+#ifdef PUSHKERNELS_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return SimdLevel::avx512;
+        if (__builtin_cpu_supports("avx2"))
+            return SimdLevel::avx2;
+#endif
+        return SimdLevel::scalar;
+    }();
+
+    return level;
+}
+
+
+
+
+/* ----------------------------------------------------------------------------
+
+                                 SCALAR KERNELS
+
+   ---------------------------------------------------------------------------- */
+
+
+static void advancePositionScalar(uint32 nbrParticles, double dto2dl, float const* deltaIn,
+                                  double const* v, int32 const* icellIn, float* deltaOut,
+                                  int32* icellOut)
+{
+    for (uint32 iPart = 0; iPart < nbrParticles; ++iPart)
+    {
+        float delta = deltaIn[iPart] + static_cast<float>(dto2dl * v[iPart]);
+
+        // split the position into a node and a delta in [0, 1[
+        float iCell     = std::floor(delta);
+        deltaOut[iPart] = delta - iCell;
+        icellOut[iPart] = iCell + icellIn[iPart];
+    }
+}
+
+
+
+static void borisScalar(uint32 nbrParticles, double dto2m, double const* charge,
+                        std::array<double const*, 3> const& E,
+                        std::array<double const*, 3> const& B,
+                        std::array<double const*, 3> const& vIn,
+                        std::array<double*, 3> const& vOut)
+{
+    for (uint32 iPart = 0; iPart < nbrParticles; ++iPart)
+    {
+        double coef1 = charge[iPart] * dto2m;
+
+        // We now apply the 3 steps of the BORIS PUSHER
+
+        // 1st half push of the electric field
+        double velx1 = vIn[0][iPart] + coef1 * E[0][iPart];
+        double vely1 = vIn[1][iPart] + coef1 * E[1][iPart];
+        double velz1 = vIn[2][iPart] + coef1 * E[2][iPart];
+
+
+        // preparing variables for magnetic rotation
+        double const rx = coef1 * B[0][iPart];
+        double const ry = coef1 * B[1][iPart];
+        double const rz = coef1 * B[2][iPart];
+
+        double const rx2  = rx * rx;
+        double const ry2  = ry * ry;
+        double const rz2  = rz * rz;
+        double const rxry = rx * ry;
+        double const rxrz = rx * rz;
+        double const ryrz = ry * rz;
+
+        double const invDet = 1. / (1. + rx2 + ry2 + rz2);
+
+        // preparing rotation matrix due to the magnetic field
+        // m = invDet*(I + r*r - r x I) - I where x denotes the cross product
+        double const mxx = 1. + rx2 - ry2 - rz2;
+        double const mxy = 2. * (rxry + rz);
+        double const mxz = 2. * (rxrz - ry);
+
+        double const myx = 2. * (rxry - rz);
+        double const myy = 1. + ry2 - rx2 - rz2;
+        double const myz = 2. * (ryrz + rx);
+
+        double const mzx = 2. * (rxrz + ry);
+        double const mzy = 2. * (ryrz - rx);
+        double const mzz = 1. + rz2 - rx2 - ry2;
+
+        // magnetic rotation
+        double const velx2 = (mxx * velx1 + mxy * vely1 + mxz * velz1) * invDet;
+        double const vely2 = (myx * velx1 + myy * vely1 + myz * velz1) * invDet;
+        double const velz2 = (mzx * velx1 + mzy * vely1 + mzz * velz1) * invDet;
+
+
+        // 2nd half push of the electric field
+        velx1 = velx2 + coef1 * E[0][iPart];
+        vely1 = vely2 + coef1 * E[1][iPart];
+        velz1 = velz2 + coef1 * E[2][iPart];
+
+        // Update particle velocity
+        vOut[0][iPart] = velx1;
+        vOut[1][iPart] = vely1;
+        vOut[2][iPart] = velz1;
+    }
+}
+
+
+
+
+#ifdef PUSHKERNELS_X86_SIMD
+
+/* ----------------------------------------------------------------------------
+
+                                  AVX2 KERNELS
+
+   ---------------------------------------------------------------------------- */
+
+
+__attribute__((target("avx2"))) static void
+advancePositionAVX2(uint32 nbrParticles, double dto2dl, float const* deltaIn, double const* v,
+                    int32 const* icellIn, float* deltaOut, int32* icellOut)
+{
+    __m256d const dl = _mm256_set1_pd(dto2dl);
+
+    uint32 iPart = 0;
+    for (; iPart + 4 <= nbrParticles; iPart += 4)
+    {
+        __m128 dx    = _mm256_cvtpd_ps(_mm256_mul_pd(dl, _mm256_loadu_pd(v + iPart)));
+        __m128 delta = _mm_add_ps(_mm_loadu_ps(deltaIn + iPart), dx);
+
+        __m128 iCell = _mm_floor_ps(delta);
+        _mm_storeu_ps(deltaOut + iPart, _mm_sub_ps(delta, iCell));
+
+        __m128i icell = _mm_loadu_si128(reinterpret_cast<__m128i const*>(icellIn + iPart));
+        __m128 node   = _mm_add_ps(iCell, _mm_cvtepi32_ps(icell));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(icellOut + iPart), _mm_cvttps_epi32(node));
+    }
+
+    advancePositionScalar(nbrParticles - iPart, dto2dl, deltaIn + iPart, v + iPart,
+                          icellIn + iPart, deltaOut + iPart, icellOut + iPart);
+}
+
+
+
+__attribute__((target("avx2"))) static void
+borisAVX2(uint32 nbrParticles, double dto2m, double const* charge,
+          std::array<double const*, 3> const& E, std::array<double const*, 3> const& B,
+          std::array<double const*, 3> const& vIn, std::array<double*, 3> const& vOut)
+{
+    __m256d const one = _mm256_set1_pd(1.);
+    __m256d const two = _mm256_set1_pd(2.);
+    __m256d const qm  = _mm256_set1_pd(dto2m);
+
+    uint32 iPart = 0;
+    for (; iPart + 4 <= nbrParticles; iPart += 4)
+    {
+        __m256d coef1 = _mm256_mul_pd(_mm256_loadu_pd(charge + iPart), qm);
+
+        __m256d Ex = _mm256_loadu_pd(E[0] + iPart);
+        __m256d Ey = _mm256_loadu_pd(E[1] + iPart);
+        __m256d Ez = _mm256_loadu_pd(E[2] + iPart);
+
+        // 1st half push of the electric field
+        __m256d velx1 = _mm256_add_pd(_mm256_loadu_pd(vIn[0] + iPart), _mm256_mul_pd(coef1, Ex));
+        __m256d vely1 = _mm256_add_pd(_mm256_loadu_pd(vIn[1] + iPart), _mm256_mul_pd(coef1, Ey));
+        __m256d velz1 = _mm256_add_pd(_mm256_loadu_pd(vIn[2] + iPart), _mm256_mul_pd(coef1, Ez));
+
+        // preparing variables for magnetic rotation
+        __m256d rx = _mm256_mul_pd(coef1, _mm256_loadu_pd(B[0] + iPart));
+        __m256d ry = _mm256_mul_pd(coef1, _mm256_loadu_pd(B[1] + iPart));
+        __m256d rz = _mm256_mul_pd(coef1, _mm256_loadu_pd(B[2] + iPart));
+
+        __m256d rx2  = _mm256_mul_pd(rx, rx);
+        __m256d ry2  = _mm256_mul_pd(ry, ry);
+        __m256d rz2  = _mm256_mul_pd(rz, rz);
+        __m256d rxry = _mm256_mul_pd(rx, ry);
+        __m256d rxrz = _mm256_mul_pd(rx, rz);
+        __m256d ryrz = _mm256_mul_pd(ry, rz);
+
+        __m256d invDet = _mm256_div_pd(
+            one, _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(one, rx2), ry2), rz2));
+
+        // preparing rotation matrix due to the magnetic field
+        __m256d mxx = _mm256_sub_pd(_mm256_sub_pd(_mm256_add_pd(one, rx2), ry2), rz2);
+        __m256d mxy = _mm256_mul_pd(two, _mm256_add_pd(rxry, rz));
+        __m256d mxz = _mm256_mul_pd(two, _mm256_sub_pd(rxrz, ry));
+
+        __m256d myx = _mm256_mul_pd(two, _mm256_sub_pd(rxry, rz));
+        __m256d myy = _mm256_sub_pd(_mm256_sub_pd(_mm256_add_pd(one, ry2), rx2), rz2);
+        __m256d myz = _mm256_mul_pd(two, _mm256_add_pd(ryrz, rx));
+
+        __m256d mzx = _mm256_mul_pd(two, _mm256_add_pd(rxrz, ry));
+        __m256d mzy = _mm256_mul_pd(two, _mm256_sub_pd(ryrz, rx));
+        __m256d mzz = _mm256_sub_pd(_mm256_sub_pd(_mm256_add_pd(one, rz2), rx2), ry2);
+
+        // magnetic rotation
+        __m256d velx2 = _mm256_mul_pd(
+            _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(mxx, velx1), _mm256_mul_pd(mxy, vely1)),
+                          _mm256_mul_pd(mxz, velz1)),
+            invDet);
+        __m256d vely2 = _mm256_mul_pd(
+            _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(myx, velx1), _mm256_mul_pd(myy, vely1)),
+                          _mm256_mul_pd(myz, velz1)),
+            invDet);
+        __m256d velz2 = _mm256_mul_pd(
+            _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(mzx, velx1), _mm256_mul_pd(mzy, vely1)),
+                          _mm256_mul_pd(mzz, velz1)),
+            invDet);
+
+        // 2nd half push of the electric field
+        _mm256_storeu_pd(vOut[0] + iPart, _mm256_add_pd(velx2, _mm256_mul_pd(coef1, Ex)));
+        _mm256_storeu_pd(vOut[1] + iPart, _mm256_add_pd(vely2, _mm256_mul_pd(coef1, Ey)));
+        _mm256_storeu_pd(vOut[2] + iPart, _mm256_add_pd(velz2, _mm256_mul_pd(coef1, Ez)));
+    }
+
+    std::array<double const*, 3> Etail{{E[0] + iPart, E[1] + iPart, E[2] + iPart}};
+    std::array<double const*, 3> Btail{{B[0] + iPart, B[1] + iPart, B[2] + iPart}};
+    std::array<double const*, 3> vInTail{{vIn[0] + iPart, vIn[1] + iPart, vIn[2] + iPart}};
+    std::array<double*, 3> vOutTail{{vOut[0] + iPart, vOut[1] + iPart, vOut[2] + iPart}};
+
+    borisScalar(nbrParticles - iPart, dto2m, charge + iPart, Etail, Btail, vInTail, vOutTail);
+}
+
+
+
+
+/* ----------------------------------------------------------------------------
+
+                                 AVX-512 KERNELS
+
+   ---------------------------------------------------------------------------- */
+
+
+__attribute__((target("avx512f"))) static void
+advancePositionAVX512(uint32 nbrParticles, double dto2dl, float const* deltaIn, double const* v,
+                      int32 const* icellIn, float* deltaOut, int32* icellOut)
+{
+    __m512d const dl = _mm512_set1_pd(dto2dl);
+
+    uint32 iPart = 0;
+    for (; iPart + 8 <= nbrParticles; iPart += 8)
+    {
+        // masked conversion of all 8 lanes: same as _mm512_cvtpd_ps, without
+        // its spurious "may be used uninitialized" warning
+        __m256 dx    = _mm512_maskz_cvtpd_ps(0xFF, _mm512_mul_pd(dl, _mm512_loadu_pd(v + iPart)));
+        __m256 delta = _mm256_add_ps(_mm256_loadu_ps(deltaIn + iPart), dx);
+
+        __m256 iCell = _mm256_floor_ps(delta);
+        _mm256_storeu_ps(deltaOut + iPart, _mm256_sub_ps(delta, iCell));
+
+        __m256i icell = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(icellIn + iPart));
+        __m256 node   = _mm256_add_ps(iCell, _mm256_cvtepi32_ps(icell));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(icellOut + iPart),
+                            _mm256_cvttps_epi32(node));
+    }
+
+    advancePositionScalar(nbrParticles - iPart, dto2dl, deltaIn + iPart, v + iPart,
+                          icellIn + iPart, deltaOut + iPart, icellOut + iPart);
+}
+
+
+
+__attribute__((target("avx512f"))) static void
+borisAVX512(uint32 nbrParticles, double dto2m, double const* charge,
+            std::array<double const*, 3> const& E, std::array<double const*, 3> const& B,
+            std::array<double const*, 3> const& vIn, std::array<double*, 3> const& vOut)
+{
+    __m512d const one = _mm512_set1_pd(1.);
+    __m512d const two = _mm512_set1_pd(2.);
+    __m512d const qm  = _mm512_set1_pd(dto2m);
+
+    uint32 iPart = 0;
+    for (; iPart + 8 <= nbrParticles; iPart += 8)
+    {
+        __m512d coef1 = _mm512_mul_pd(_mm512_loadu_pd(charge + iPart), qm);
+
+        __m512d Ex = _mm512_loadu_pd(E[0] + iPart);
+        __m512d Ey = _mm512_loadu_pd(E[1] + iPart);
+        __m512d Ez = _mm512_loadu_pd(E[2] + iPart);
+
+        // 1st half push of the electric field
+        __m512d velx1 = _mm512_add_pd(_mm512_loadu_pd(vIn[0] + iPart), _mm512_mul_pd(coef1, Ex));
+        __m512d vely1 = _mm512_add_pd(_mm512_loadu_pd(vIn[1] + iPart), _mm512_mul_pd(coef1, Ey));
+        __m512d velz1 = _mm512_add_pd(_mm512_loadu_pd(vIn[2] + iPart), _mm512_mul_pd(coef1, Ez));
+
+        // preparing variables for magnetic rotation
+        __m512d rx = _mm512_mul_pd(coef1, _mm512_loadu_pd(B[0] + iPart));
+        __m512d ry = _mm512_mul_pd(coef1, _mm512_loadu_pd(B[1] + iPart));
+        __m512d rz = _mm512_mul_pd(coef1, _mm512_loadu_pd(B[2] + iPart));
+
+        __m512d rx2  = _mm512_mul_pd(rx, rx);
+        __m512d ry2  = _mm512_mul_pd(ry, ry);
+        __m512d rz2  = _mm512_mul_pd(rz, rz);
+        __m512d rxry = _mm512_mul_pd(rx, ry);
+        __m512d rxrz = _mm512_mul_pd(rx, rz);
+        __m512d ryrz = _mm512_mul_pd(ry, rz);
+
+        __m512d invDet = _mm512_div_pd(
+            one, _mm512_add_pd(_mm512_add_pd(_mm512_add_pd(one, rx2), ry2), rz2));
+
+        // preparing rotation matrix due to the magnetic field
+        __m512d mxx = _mm512_sub_pd(_mm512_sub_pd(_mm512_add_pd(one, rx2), ry2), rz2);
+        __m512d mxy = _mm512_mul_pd(two, _mm512_add_pd(rxry, rz));
+        __m512d mxz = _mm512_mul_pd(two, _mm512_sub_pd(rxrz, ry));
+
+        __m512d myx = _mm512_mul_pd(two, _mm512_sub_pd(rxry, rz));
+        __m512d myy = _mm512_sub_pd(_mm512_sub_pd(_mm512_add_pd(one, ry2), rx2), rz2);
+        __m512d myz = _mm512_mul_pd(two, _mm512_add_pd(ryrz, rx));
+
+        __m512d mzx = _mm512_mul_pd(two, _mm512_add_pd(rxrz, ry));
+        __m512d mzy = _mm512_mul_pd(two, _mm512_sub_pd(ryrz, rx));
+        __m512d mzz = _mm512_sub_pd(_mm512_sub_pd(_mm512_add_pd(one, rz2), rx2), ry2);
+
+        // magnetic rotation
+        __m512d velx2 = _mm512_mul_pd(
+            _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(mxx, velx1), _mm512_mul_pd(mxy, vely1)),
+                          _mm512_mul_pd(mxz, velz1)),
+            invDet);
+        __m512d vely2 = _mm512_mul_pd(
+            _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(myx, velx1), _mm512_mul_pd(myy, vely1)),
+                          _mm512_mul_pd(myz, velz1)),
+            invDet);
+        __m512d velz2 = _mm512_mul_pd(
+            _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(mzx, velx1), _mm512_mul_pd(mzy, vely1)),
+                          _mm512_mul_pd(mzz, velz1)),
+            invDet);
+
+        // 2nd half push of the electric field
+        _mm512_storeu_pd(vOut[0] + iPart, _mm512_add_pd(velx2, _mm512_mul_pd(coef1, Ex)));
+        _mm512_storeu_pd(vOut[1] + iPart, _mm512_add_pd(vely2, _mm512_mul_pd(coef1, Ey)));
+        _mm512_storeu_pd(vOut[2] + iPart, _mm512_add_pd(velz2, _mm512_mul_pd(coef1, Ez)));
+    }
+
+    std::array<double const*, 3> Etail{{E[0] + iPart, E[1] + iPart, E[2] + iPart}};
+    std::array<double const*, 3> Btail{{B[0] + iPart, B[1] + iPart, B[2] + iPart}};
+    std::array<double const*, 3> vInTail{{vIn[0] + iPart, vIn[1] + iPart, vIn[2] + iPart}};
+    std::array<double*, 3> vOutTail{{vOut[0] + iPart, vOut[1] + iPart, vOut[2] + iPart}};
+
+    borisScalar(nbrParticles - iPart, dto2m, charge + iPart, Etail, Btail, vInTail, vOutTail);
+}
+
+#endif // PUSHKERNELS_X86_SIMD
+
+
+
+
+/* ----------------------------------------------------------------------------
+
+                                KERNEL SELECTION
+
+   ---------------------------------------------------------------------------- */
+
+
+AdvancePositionKernel advancePositionKernel(SimdLevel level)
+{
+    switch (level)
+    {
+        case SimdLevel::scalar: return advancePositionScalar;
+#ifdef PUSHKERNELS_X86_SIMD
+        case SimdLevel::avx2: return advancePositionAVX2;
+        case SimdLevel::avx512: return advancePositionAVX512;
+#endif
+        default: throw std::runtime_error("advancePositionKernel - SIMD level not available");
+    }
+}
+
+
+
+BorisKernel borisKernel(SimdLevel level)
+{
+    switch (level)
+    {
+        case SimdLevel::scalar: return borisScalar;
+#ifdef PUSHKERNELS_X86_SIMD
+        case SimdLevel::avx2: return borisAVX2;
+        case SimdLevel::avx512: return borisAVX512;
+#endif
+        default: throw std::runtime_error("borisKernel - SIMD level not available");
+    }
+}
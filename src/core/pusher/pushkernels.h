@@ -0,0 +1,65 @@
+#ifndef PUSHKERNELS_H
+#define PUSHKERNELS_H
+
+#include <array>
+
+#include "utilities/types.h"
+
+
+
+/* ----------------------------------------------------------------------------
+
+                      Vectorized kernels of the Boris pusher
+
+   ----------------------------------------------------------------------------
+
+   The kernels below run the arithmetic part of the Boris push on contiguous
+   particle streams. Each of them has a scalar implementation and, on x86-64
+   with GCC or Clang, an AVX2 and an AVX-512 implementation processing 4 and 8
+   particles at a time. The best implementation supported by the CPU is
+   selected at runtime; all of them give the same results as the scalar one.
+*/
+
+
+enum class SimdLevel { scalar, avx2, avx512 };
+
+
+//! best SIMD level supported by the CPU we are running on, detected once
+SimdLevel detectedSimdLevel();
+
+
+
+/**
+ * @brief AdvancePositionKernel advances 'nbrParticles' positions in one
+ * direction by dto2dl * v (in units of the mesh size), and splits the new
+ * position into the cell index 'icellOut' and the offset 'deltaOut' in [0, 1[
+ *
+ * In and out streams may be the same.
+ */
+using AdvancePositionKernel = void (*)(uint32 nbrParticles, double dto2dl, float const* deltaIn,
+                                       double const* v, int32 const* icellIn, float* deltaOut,
+                                       int32* icellOut);
+
+
+/**
+ * @brief BorisKernel pushes the velocities of 'nbrParticles' particles with
+ * the Boris scheme, given the electric and magnetic fields at their positions.
+ *
+ * In and out velocities may be the same.
+ */
+using BorisKernel = void (*)(uint32 nbrParticles, double dto2m, double const* charge,
+                             std::array<double const*, 3> const& E,
+                             std::array<double const*, 3> const& B,
+                             std::array<double const*, 3> const& vIn,
+                             std::array<double*, 3> const& vOut);
+
+
+
+//! the kernels of a given SIMD level, which must be supported by the CPU
+AdvancePositionKernel advancePositionKernel(SimdLevel level);
+
+BorisKernel borisKernel(SimdLevel level);
+
+
+
+#endif // PUSHKERNELS_H
@@ -4,7 +4,7 @@ Field::Field(const AllocSizeT &allocSize, HybridQuantity qtyType, std::string na
 
     : name_(name)
     , qtyType_{qtyType}
-    , shape_{allocSize.nx_, allocSize.ny_, allocSize.nz_}
+    , shape_{{allocSize.nx_, allocSize.ny_, allocSize.nz_}}
     , data_{}
     , size_{shape_[0] * shape_[1] * shape_[2]}
 {
@@ -2,6 +2,7 @@
 #define FIELD_H
 
 
+#include <array>
 #include <cstddef>
 #include <string>
 #include <vector>
@@ -10,12 +11,17 @@
 #include "utilities/types.h"
 
 
+template<typename E>
+class FieldExpression;
+
+
+
 class Field
 {
 private:
     std::string name_;
     HybridQuantity qtyType_;
-    std::vector<uint32> shape_;
+    std::array<uint32, 3> shape_;
     std::vector<double> data_;
     uint32 size_;
 
@@ -27,6 +33,10 @@ public:
     Field(Field const& source)       = default;
     Field& operator=(Field const& source) = default;
 
+    //! evaluate an arithmetic expression of Fields in a single loop, see fieldexpression.h
+    template<typename E>
+    Field& operator=(FieldExpression<E> const& expression);
+
     void zero()
     {
         for (double& x : data_)
@@ -59,7 +69,7 @@ public:
     std::vector<double>::iterator end() { return data_.end(); }
     std::vector<double>::const_iterator end() const { return data_.end(); }
 
-    std::vector<uint32> shape() const { return shape_; }
+    std::array<uint32, 3> const& shape() const { return shape_; }
 
     uint32 size() const { return size_; }
 
@@ -0,0 +1,282 @@
+#ifndef FIELDEXPRESSION_H
+#define FIELDEXPRESSION_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "data/Field/field.h"
+#include "utilities/types.h"
+
+
+
+/*
+ * Expression templates for the node by node arithmetic of Field and VecField.
+ *
+ * An arithmetic expression of Fields, VecFields and scalars, such as
+ *
+ *      Einterp = Et1 + (Et2 - Et1) / dt * delta;
+ *
+ * does not compute anything by itself: it builds a small object describing
+ * the expression, which holds pointers to the operand data. Assigning it to a
+ * Field (or a VecField) then evaluates the whole expression in a single loop
+ * on the nodes, without any temporary Field and thus without heap allocation.
+ *
+ * The node values are computed with the operations in the order written, so
+ * the result is the same as the one of successive passes.
+ */
+
+
+
+/**
+ * @brief FieldExpression is the base of all expression nodes. E is the node
+ * type (CRTP), which provides:
+ * - operator[](i) the value of the expression at the node i of a Field,
+ * - size() the number of nodes, 0 for a scalar
+ * - component(iComp) the expression of the component iComp, for VecField
+ * expressions.
+ */
+template<typename E>
+class FieldExpression
+{
+public:
+    E const& self() const { return static_cast<E const&>(*this); }
+};
+
+
+
+//! leaf of the expression tree that refers to the nodes of a Field
+class FieldTerm : public FieldExpression<FieldTerm>
+{
+private:
+    double const* data_;
+    uint32 size_;
+
+public:
+    explicit FieldTerm(Field const& field)
+        : data_{field.size() > 0 ? &field(0) : nullptr}
+        , size_{field.size()}
+    {
+    }
+
+    double operator[](uint32 i) const { return data_[i]; }
+
+    uint32 size() const { return size_; }
+};
+
+
+
+//! leaf of the expression tree for a scalar, the same for all nodes and components
+class ScalarTerm : public FieldExpression<ScalarTerm>
+{
+private:
+    double value_;
+
+public:
+    explicit ScalarTerm(double value)
+        : value_{value}
+    {
+    }
+
+    double operator[](uint32) const { return value_; }
+
+    uint32 size() const { return 0; }
+
+    ScalarTerm component(uint32) const { return *this; }
+};
+
+
+
+struct PlusOperation
+{
+    static double apply(double left, double right) { return left + right; }
+};
+
+struct MinusOperation
+{
+    static double apply(double left, double right) { return left - right; }
+};
+
+struct MultipliesOperation
+{
+    static double apply(double left, double right) { return left * right; }
+};
+
+struct DividesOperation
+{
+    static double apply(double left, double right) { return left / right; }
+};
+
+
+
+/**
+ * @brief BinaryExpression applies 'Operation' to its two operands, node by
+ * node. The operands are expression nodes held by value: they only contain
+ * pointers and scalars, so the whole tree is cheap to copy and never refers
+ * to a temporary node.
+ */
+template<typename Operation, typename Left, typename Right>
+class BinaryExpression : public FieldExpression<BinaryExpression<Operation, Left, Right>>
+{
+private:
+    Left left_;
+    Right right_;
+
+    // Field operands must have the same number of nodes, scalars (size 0)
+    // match any of them. VecField operands have no size, their components are
+    // checked when the component expressions are built.
+    template<typename L, typename R>
+    static auto checkSizes_(L const& left, R const& right, int)
+        -> decltype(left.size(), right.size(), void())
+    {
+        if (left.size() != 0 && right.size() != 0 && left.size() != right.size())
+            throw std::runtime_error("Error - Field expression operands of different sizes");
+    }
+
+    template<typename L, typename R>
+    static void checkSizes_(L const&, R const&, long)
+    {
+    }
+
+public:
+    BinaryExpression(Left const& left, Right const& right)
+        : left_{left}
+        , right_{right}
+    {
+        checkSizes_(left_, right_, 0);
+    }
+
+    double operator[](uint32 i) const { return Operation::apply(left_[i], right_[i]); }
+
+    // a template so that it is only instantiated for Field expressions
+    template<typename L = Left, typename R = Right>
+    auto size() const
+        -> decltype(std::declval<L const&>().size(), std::declval<R const&>().size(), uint32{})
+    {
+        return std::max(left_.size(), right_.size());
+    }
+
+    // a template so that it is only instantiated for VecField expressions
+    template<typename L = Left, typename R = Right>
+    auto component(uint32 iComp) const
+        -> BinaryExpression<Operation, decltype(std::declval<L const&>().component(iComp)),
+                            decltype(std::declval<R const&>().component(iComp))>
+    {
+        return {left_.component(iComp), right_.component(iComp)};
+    }
+};
+
+
+
+/**
+ * @brief ExpressionTerm gives the expression node corresponding to an operand
+ * of an arithmetic operator: expression nodes are kept as they are, Fields and
+ * scalars are wrapped in their leaf. 'isOperand' is false for other types,
+ * for which the operators below do not exist.
+ */
+template<typename T, typename Enable = void>
+struct ExpressionTerm
+{
+    static const bool isOperand = false;
+};
+
+template<typename T>
+struct ExpressionTerm<T, typename std::enable_if<std::is_base_of<FieldExpression<T>, T>::value>::type>
+{
+    static const bool isOperand = true;
+    using type                  = T;
+    static T const& make(T const& expression) { return expression; }
+};
+
+template<>
+struct ExpressionTerm<Field>
+{
+    static const bool isOperand = true;
+    using type                  = FieldTerm;
+    static FieldTerm make(Field const& field) { return FieldTerm{field}; }
+};
+
+template<>
+struct ExpressionTerm<double>
+{
+    static const bool isOperand = true;
+    using type                  = ScalarTerm;
+    static ScalarTerm make(double value) { return ScalarTerm{value}; }
+};
+
+
+
+//! the arithmetic operators exist if both sides are operands and one is not a scalar
+template<typename Left, typename Right>
+struct IsFieldOperation
+{
+    static const bool value = ExpressionTerm<Left>::isOperand && ExpressionTerm<Right>::isOperand
+                              && !(std::is_same<Left, double>::value
+                                   && std::is_same<Right, double>::value);
+};
+
+
+
+template<typename Operation, typename Left, typename Right>
+using FieldOperationResult = typename std::enable_if<
+    IsFieldOperation<Left, Right>::value,
+    BinaryExpression<Operation, typename ExpressionTerm<Left>::type,
+                     typename ExpressionTerm<Right>::type>>::type;
+
+
+
+template<typename Left, typename Right>
+FieldOperationResult<PlusOperation, Left, Right> operator+(Left const& left, Right const& right)
+{
+    return {ExpressionTerm<Left>::make(left), ExpressionTerm<Right>::make(right)};
+}
+
+
+template<typename Left, typename Right>
+FieldOperationResult<MinusOperation, Left, Right> operator-(Left const& left, Right const& right)
+{
+    return {ExpressionTerm<Left>::make(left), ExpressionTerm<Right>::make(right)};
+}
+
+
+template<typename Left, typename Right>
+FieldOperationResult<MultipliesOperation, Left, Right> operator*(Left const& left,
+                                                                 Right const& right)
+{
+    return {ExpressionTerm<Left>::make(left), ExpressionTerm<Right>::make(right)};
+}
+
+
+template<typename Left, typename Right>
+FieldOperationResult<DividesOperation, Left, Right> operator/(Left const& left, Right const& right)
+{
+    return {ExpressionTerm<Left>::make(left), ExpressionTerm<Right>::make(right)};
+}
+
+
+
+/**
+ * @brief Field::operator= evaluates 'expression' on all the nodes of the Field,
+ * in a single loop. The Field may appear in the expression, since each node is
+ * only computed from the same node of the operands.
+ */
+template<typename E>
+Field& Field::operator=(FieldExpression<E> const& expression)
+{
+    E const& nodes = expression.self();
+
+    if (nodes.size() != size_)
+        throw std::runtime_error("Error - Field expression of a different size");
+
+    for (uint32 i = 0; i < size_; ++i)
+    {
+        data_[i] = nodes[i];
+    }
+
+    return *this;
+}
+
+
+
+#endif // FIELDEXPRESSION_H
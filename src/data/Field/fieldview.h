@@ -0,0 +1,53 @@
+#ifndef FIELDVIEW_H
+#define FIELDVIEW_H
+
+#include "data/Field/field.h"
+#include "utilities/types.h"
+
+
+
+/**
+ * @brief FieldView gives access to the nodes of a Field whose number of
+ * dimensions 'Dim' is known at compile time.
+ *
+ * Field::operator() with three indexes computes the 3D row-major index, the view only
+ * computes the index for 'Dim' dimensions and the indexes of the invariant
+ * directions are ignored. The view does not own the nodes, it must not outlive
+ * its Field, nor be used after the Field is resized.
+ *
+ * DataType is 'double const' for a read-only view, see ConstFieldView.
+ */
+template<uint32 Dim, typename DataType = double>
+class FieldView
+{
+    static_assert(Dim >= 1 && Dim <= 3, "FieldView - dimension must be 1, 2 or 3");
+
+private:
+    DataType* data_;
+    uint32 strideX_; // nodes between (ix, iy, iz) and (ix+1, iy, iz)
+    uint32 strideY_; // nodes between (ix, iy, iz) and (ix, iy+1, iz)
+
+public:
+    template<typename FieldType>
+    explicit FieldView(FieldType& field)
+        : data_{field.size() > 0 ? &field(0) : nullptr}
+        , strideX_{field.shape()[1] * field.shape()[2]}
+        , strideY_{field.shape()[2]}
+    {
+    }
+
+    DataType& operator()(uint32 ix, uint32 iy = 0, uint32 iz = 0) const
+    {
+        return data_[Dim == 1 ? ix
+                              : Dim == 2 ? iy + strideX_ * ix : iz + strideY_ * iy + strideX_ * ix];
+    }
+};
+
+
+
+template<uint32 Dim>
+using ConstFieldView = FieldView<Dim, double const>;
+
+
+
+#endif // FIELDVIEW_H
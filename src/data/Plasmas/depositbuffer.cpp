@@ -0,0 +1,51 @@
+#include <algorithm>
+
+#include "depositbuffer.h"
+
+
+
+void DepositBuffer::reset(uint32 nbrNodes)
+{
+    moments_.assign(nbrMoments * nbrNodes, 0.);
+    nbrSlabsInUse_ = 1;
+}
+
+
+
+
+void DepositBuffer::useSlabs(uint32 count)
+{
+    count = std::min(count, nbrSlabs);
+
+    for (uint32 iSlab = nbrSlabsInUse_; iSlab < count; ++iSlab)
+        privateSlabs_[iSlab - 1].assign(moments_.size(), 0.);
+
+    nbrSlabsInUse_ = std::max(nbrSlabsInUse_, count);
+}
+
+
+
+
+/**
+ * @brief DepositBuffer::reduce adds the private slabs to the moments. Each
+ * node gets the slabs in the same order whatever the number of threads.
+ */
+void DepositBuffer::reduce()
+{
+    if (nbrSlabsInUse_ <= 1)
+        return;
+
+    uint32 size   = static_cast<uint32>(moments_.size());
+    double* total = moments_.data();
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (uint32 i = 0; i < size; ++i)
+    {
+        for (uint32 iSlab = 1; iSlab < nbrSlabsInUse_; ++iSlab)
+            total[i] += privateSlabs_[iSlab - 1][i];
+    }
+
+    nbrSlabsInUse_ = 1;
+}
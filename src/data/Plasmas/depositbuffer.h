@@ -0,0 +1,59 @@
+#ifndef DEPOSITBUFFER_H
+#define DEPOSITBUFFER_H
+
+#include <vector>
+
+#include "utilities/types.h"
+
+
+
+/**
+ * @brief DepositBuffer holds the moments deposited by the particles of a
+ * species, rho and the x, y and z fluxes of each node being contiguous.
+ *
+ * Chunks of particles may be deposited in parallel into a fixed number of
+ * slabs: slab 0 is the moments themselves, the others are private moments
+ * added to them by reduce(). A chunk always goes to the same slab whatever the
+ * number of threads, so that the moments do not depend on it. The slabs are
+ * kept from one deposit to the next to avoid reallocating them.
+ */
+class DepositBuffer
+{
+public:
+    static const uint32 nbrMoments = 4;
+    static const uint32 nbrSlabs   = 8;
+
+private:
+    std::vector<double> moments_;
+    std::vector<std::vector<double>> privateSlabs_;
+    uint32 nbrSlabsInUse_;
+
+public:
+    DepositBuffer()
+        : moments_{}
+        , privateSlabs_(nbrSlabs - 1)
+        , nbrSlabsInUse_{1}
+    {
+    }
+
+    //! sets the 'nbrNodes' moments to zero, no private slab being in use
+    void reset(uint32 nbrNodes);
+
+    std::vector<double>& moments() { return moments_; }
+    std::vector<double> const& moments() const { return moments_; }
+
+    //! makes sure the first 'count' slabs are in use, zeroing the new ones
+    void useSlabs(uint32 count);
+
+    double* slab(uint32 iSlab)
+    {
+        return iSlab == 0 ? moments_.data() : privateSlabs_[iSlab - 1].data();
+    }
+
+    //! adds the private slabs in use to the moments, in slab order
+    void reduce();
+};
+
+
+
+#endif // DEPOSITBUFFER_H
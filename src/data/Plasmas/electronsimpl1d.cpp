@@ -1,70 +1,73 @@
+#include <stdexcept>
+
 #include "electronsimpl1d.h"
 
+#include "data/Field/fieldview.h"
+#include "data/grid/yeestencils.h"
+
 
 
 
 const VecField& ElectronsImpl1D::bulkVel(VecField const& Vi, const Field& Ni, const VecField& J)
+{
+    switch (layout_.order())
+    {
+        case 1: bulkVel_<1>(Vi, Ni, J); break;
+        case 2: bulkVel_<2>(Vi, Ni, J); break;
+        case 3: bulkVel_<3>(Vi, Ni, J); break;
+        case 4: bulkVel_<4>(Vi, Ni, J); break;
+        default: throw std::runtime_error("ElectronsImpl1D - wrong interpolation order");
+    }
+
+    return Ve_;
+}
+
+
+
+template<uint32 InterpOrder>
+void ElectronsImpl1D::bulkVel_(VecField const& Vi, const Field& Ni, const VecField& J)
 {
     const uint32 compX = 0;
     const uint32 compY = 1;
     const uint32 compZ = 2;
 
-    LinearCombination const& JxOnMoment = layout_.ExToMoment();
-    LinearCombination const& JyOnMoment = layout_.EyToMoment();
-    LinearCombination const& JzOnMoment = layout_.EzToMoment();
+    // J is defined on E, the Yee stencils project it on the moment nodes
+    using Stencils = YeeStencils<1, InterpOrder>;
 
+    FieldView<1> Vex{Ve_.component(compX)};
+    FieldView<1> Vey{Ve_.component(compY)};
+    FieldView<1> Vez{Ve_.component(compZ)};
 
-    Field& Vex = Ve_.component(compX);
-    Field& Vey = Ve_.component(compY);
-    Field& Vez = Ve_.component(compZ);
+    ConstFieldView<1> Jx{J.component(compX)};
+    ConstFieldView<1> Jy{J.component(compY)};
+    ConstFieldView<1> Jz{J.component(compZ)};
 
-    const Field& Jx = J.component(compX);
-    const Field& Jy = J.component(compY);
-    const Field& Jz = J.component(compZ);
+    ConstFieldView<1> Vix{Vi.component(compX)};
+    ConstFieldView<1> Viy{Vi.component(compY)};
+    ConstFieldView<1> Viz{Vi.component(compZ)};
 
-    const Field& Vix = Vi.component(compX);
-    const Field& Viy = Vi.component(compY);
-    const Field& Viz = Vi.component(compZ);
+    ConstFieldView<1> density{Ni};
 
 
 
     // every V (x,y,z) component and density has the same centering: ppp
     // so only one spatial loop is necessary
-    uint32 const iStart = layout_.physicalStartIndex(Vex, Direction::X);
-    uint32 const iEnd   = layout_.physicalEndIndex(Vex, Direction::X);
+    uint32 const iStart = layout_.physicalStartIndex(Ve_.component(compX), Direction::X);
+    uint32 const iEnd   = layout_.physicalEndIndex(Ve_.component(compX), Direction::X);
 
     for (uint32 ix = iStart; ix <= iEnd; ++ix)
     {
-        // J is defined on E. We don't know here where E (thus J) here
-        // we need to call the gridLayout LinearCombinations to get J components
-        // at the primal nodes.
-        double jxloc = 0;
-        for (WeightPoint const& wp : JxOnMoment)
-        {
-            jxloc += wp.coef * Jx(ix + wp.ix);
-        }
-
-        double jyloc = 0;
-        for (WeightPoint const& wp : JyOnMoment)
-        {
-            jyloc += wp.coef * Jy(ix + wp.ix);
-        }
-
-        double jzloc = 0;
-        for (WeightPoint const& wp : JzOnMoment)
-        {
-            jzloc += wp.coef * Jz(ix + wp.ix);
-        }
+        double jxloc = project<typename Stencils::ExToMoment>(Jx, ix);
+        double jyloc = project<typename Stencils::EyToMoment>(Jy, ix);
+        double jzloc = project<typename Stencils::EzToMoment>(Jz, ix);
 
         // now we have all J components at the primal nodes
         // we can safely compute Ve.
 
-        Vex(ix) = Vix(ix) - jxloc / Ni(ix);
-        Vey(ix) = Viy(ix) - jyloc / Ni(ix);
-        Vez(ix) = Viz(ix) - jzloc / Ni(ix);
+        Vex(ix) = Vix(ix) - jxloc / density(ix);
+        Vey(ix) = Viy(ix) - jyloc / density(ix);
+        Vez(ix) = Viz(ix) - jzloc / density(ix);
     }
-
-    return Ve_;
 }
 
 
@@ -1,6 +1,8 @@
 #ifndef ELECTRONSIMPL1D_H
 #define ELECTRONSIMPL1D_H
 
+#include <stdexcept>
+
 #include "data/grid/gridlayout.h"
 #include "electrons.h"
 
@@ -8,10 +10,17 @@
 
 class ElectronsImpl1D : public ElectronsImpl
 {
+private:
+    // version for the Yee stencils of the interpolation order
+    template<uint32 InterpOrder>
+    void bulkVel_(VecField const& Vi, Field const& Ni, VecField const& J);
+
 public:
     ElectronsImpl1D(GridLayout const& layout, double Te)
         : ElectronsImpl(layout, Te)
     {
+        if (layout.layoutName() != "yee")
+            throw std::runtime_error("ElectronsImpl1D - only the Yee layout is supported");
     }
 
     virtual VecField const& bulkVel(VecField const& Vi, Field const& Ni, VecField const& J) final;
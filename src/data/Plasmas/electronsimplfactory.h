@@ -4,6 +4,7 @@
 
 #include "electrons.h"
 #include "electronsimpl1d.h"
+#include "electronsimplmultid.h"
 #include "utilities/types.h"
 
 class ElectronsImplFactory
@@ -15,9 +16,9 @@ public:
         {
             case 1: return std::unique_ptr<ElectronsImpl>{new ElectronsImpl1D{layout, Te}};
 
-
             case 2:
-            case 3:
+            case 3: return std::unique_ptr<ElectronsImpl>{new ElectronsImplMultiD{layout, Te}};
+
             default: throw std::runtime_error("Not implemented");
         }
     }
@@ -0,0 +1,55 @@
+#include "electronsimplmultid.h"
+
+#include "data/grid/gridrows.h"
+
+
+
+
+/**
+ * @brief ElectronsImplMultiD::bulkVel computes Ve = Vi - J/Ni on the physical
+ * moment nodes, J being projected on the moment nodes, see ElectronsImpl1D.
+ */
+VecField const& ElectronsImplMultiD::bulkVel(VecField const& Vi, Field const& Ni,
+                                             VecField const& J)
+{
+    std::array<LinearCombination const*, 3> JOnMoment{
+        {&layout_.ExToMoment(), &layout_.EyToMoment(), &layout_.EzToMoment()}};
+
+    // every V (x,y,z) component and density has the same centering: ppp
+    // so one row gives the nodes of all of them
+    forEachRow(physicalNodes(layout_, HybridQuantity::V),
+               [&](uint32 ix, uint32 iy, uint32 iz, uint32 count) {
+                   double jloc[rowTileSize];
+
+                   double const* ni = &Ni(ix, iy, iz);
+
+                   for (uint32 iComp = 0; iComp < 3; ++iComp)
+                   {
+                       projectRow(*JOnMoment[iComp], J.component(iComp), ix, iy, iz, count,
+                                  jloc);
+
+                       double const* vi = &Vi.component(iComp)(ix, iy, iz);
+                       double* ve       = &Ve_.component(iComp)(ix, iy, iz);
+
+                       for (uint32 i = 0; i < count; ++i)
+                       {
+                           ve[i] = vi[i] - jloc[i] / ni[i];
+                       }
+                   }
+               });
+
+    return Ve_;
+}
+
+
+
+Field const& ElectronsImplMultiD::pressure(Field const& Ni)
+{
+    const uint32 totalSize = Ni.size();
+
+    for (uint32 i = 0; i < totalSize; ++i)
+    {
+        Pe_(i) = Ni(i) * Te_;
+    }
+    return Pe_;
+}
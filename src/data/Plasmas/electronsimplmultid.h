@@ -0,0 +1,26 @@
+#ifndef ELECTRONSIMPLMULTID_H
+#define ELECTRONSIMPLMULTID_H
+
+#include "data/grid/gridlayout.h"
+#include "electrons.h"
+
+
+
+/**
+ * @brief ElectronsImplMultiD computes the electron moments of 2D and 3D layouts,
+ * by rows of the contiguous direction (see gridrows.h).
+ */
+class ElectronsImplMultiD : public ElectronsImpl
+{
+public:
+    ElectronsImplMultiD(GridLayout const& layout, double Te)
+        : ElectronsImpl(layout, Te)
+    {
+    }
+
+    virtual VecField const& bulkVel(VecField const& Vi, Field const& Ni, VecField const& J) final;
+
+    virtual Field const& pressure(Field const& Ni) final;
+};
+
+#endif // ELECTRONSIMPLMULTID_H
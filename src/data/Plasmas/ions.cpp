@@ -1,6 +1,6 @@
 
 #include <algorithm>
-#include <functional>
+#include <array>
 #include <iostream>
 #include <memory>
 
@@ -45,7 +45,8 @@ Ions::Ions(GridLayout const& layout, std::unique_ptr<IonsInitializer> ionInitial
         speciesArray_.push_back(
             Species{layout, ionInitializer->masses[speciesIndex],
                     std::move(ionInitializer->particleInitializers[speciesIndex]),
-                    ionInitializer->names[speciesIndex]});
+                    ionInitializer->names[speciesIndex],
+                    ionInitializer->pushIntervals[speciesIndex]});
 
         name2ID_.insert({ionInitializer->names[speciesIndex], speciesIndex});
     }
@@ -104,65 +105,104 @@ void Ions::loadParticles()
 
 
 /**
- * @brief Ions::computeChargeDensity calculates the TOTAL charge density
- * the method does not go over particles, it just takes the Species
- * charge densities (assumed already calculated) and calculate the sum
+ * @brief addSpeciesMoments sums, on each node, the charge density and the
+ * three flux components of the 'groupSize' species starting at 'first', in a
+ * single sweep over the nodes. The numbers of species and of moments being
+ * known at compile time, the loops over them are unrolled. If 'overwrite' is
+ * false, the sums are added to the values already in 'totals'.
  */
-void Ions::computeChargeDensity()
+template<uint32 groupSize>
+static void addSpeciesMoments(std::vector<Species> const& speciesArray, uint32 first,
+                              std::array<double*, 4> const& totals, bool overwrite)
 {
-    // reset charge density to zero
-    rho_.zero();
-
-    for (Species const& spe : speciesArray_)
+    std::array<std::array<double const*, groupSize>, 4> moments;
+    for (uint32 iSpe = 0; iSpe < groupSize; ++iSpe)
     {
-        // we sum over all nodes contiguously, including ghosts
-        // nodes. This is more efficient and easier to code as we don't
-        // have to account for the field dimensionality.
+        Species const& spe = speciesArray[first + iSpe];
+
+        moments[0][iSpe] = &(*spe.rho().begin());
+        moments[1][iSpe] = &(*spe.flux(VecField::VecX).begin());
+        moments[2][iSpe] = &(*spe.flux(VecField::VecY).begin());
+        moments[3][iSpe] = &(*spe.flux(VecField::VecZ).begin());
+    }
+
+    std::size_t nbrNodes = speciesArray[first].rho().size();
 
-        Field const& rhoSpe = spe.rho();
-        std::transform(rho_.begin(), rho_.end(), rhoSpe.begin(), rho_.begin(), std::plus<double>());
+    for (std::size_t i = 0; i < nbrNodes; ++i)
+    {
+        for (uint32 iMoment = 0; iMoment < 4; ++iMoment)
+        {
+            double sum = overwrite ? 0. : totals[iMoment][i];
+            for (uint32 iSpe = 0; iSpe < groupSize; ++iSpe)
+            {
+                sum += moments[iMoment][iSpe][i];
+            }
+            totals[iMoment][i] = sum;
+        }
     }
 }
 
 
 
 
-void Ions::computeBulkVelocity()
+/**
+ * @brief Ions::computeDensityAndFlux calculates the TOTAL charge density and
+ * the TOTAL flux sum_s q_s*n_s*v_s, stored in the bulk velocity until
+ * divideFluxByDensity() is called. The species are summed by groups of up to
+ * four, each group in a single sweep over the nodes, rather than with one pass
+ * per species and per moment. The boundary conditions of the total density
+ * can be applied in between.
+ */
+void Ions::computeDensityAndFlux()
 {
-    // reset bulk velocity to 0
-    bulkVel_.zero();
-
+    if (speciesArray_.empty())
+    {
+        resetBulkMoments();
+        return;
+    }
 
-    Field& vxTot = bulkVel_.component(VecField::VecX);
-    Field& vyTot = bulkVel_.component(VecField::VecY);
-    Field& vzTot = bulkVel_.component(VecField::VecZ);
+    std::array<double*, 4> totals{{&(*rho_.begin()), &(*bulkVel_.component(VecField::VecX).begin()),
+                                   &(*bulkVel_.component(VecField::VecY).begin()),
+                                   &(*bulkVel_.component(VecField::VecZ).begin())}};
 
+    uint32 nbrSpe = nbrSpecies();
 
-    // first we sum the charge density flux of each species
-    // sum_s q_s*n_s*v_s
-    for (Species const& spe : speciesArray_)
+    for (uint32 first = 0; first < nbrSpe; first += 4)
     {
-        Field const& rhovX = spe.flux(VecField::VecX);
-        Field const& rhovY = spe.flux(VecField::VecY);
-        Field const& rhovZ = spe.flux(VecField::VecZ);
-
-        std::transform(vxTot.begin(), vxTot.end(), rhovX.begin(), vxTot.begin(),
-                       std::plus<double>());
-        std::transform(vyTot.begin(), vyTot.end(), rhovY.begin(), vyTot.begin(),
-                       std::plus<double>());
-        std::transform(vzTot.begin(), vzTot.end(), rhovZ.begin(), vzTot.begin(),
-                       std::plus<double>());
+        bool overwrite = first == 0;
+
+        switch (std::min(nbrSpe - first, 4u))
+        {
+            case 1: addSpeciesMoments<1>(speciesArray_, first, totals, overwrite); break;
+            case 2: addSpeciesMoments<2>(speciesArray_, first, totals, overwrite); break;
+            case 3: addSpeciesMoments<3>(speciesArray_, first, totals, overwrite); break;
+            case 4: addSpeciesMoments<4>(speciesArray_, first, totals, overwrite); break;
+        }
     }
+}
 
 
-    // now we divide by the total ion density.
-    // therefore here we assume that rho_ has been computed before
-    // i.e. that the code has called  Ions::computeChargeDensity() before.
 
 
-    std::transform(vxTot.begin(), vxTot.end(), rho_.begin(), vxTot.begin(), std::divides<double>());
-    std::transform(vyTot.begin(), vyTot.end(), rho_.begin(), vyTot.begin(), std::divides<double>());
-    std::transform(vzTot.begin(), vzTot.end(), rho_.begin(), vzTot.begin(), std::divides<double>());
+/**
+ * @brief Ions::divideFluxByDensity turns the total flux left in the bulk
+ * velocity by computeDensityAndFlux() into the bulk velocity, in a single
+ * sweep over the three components
+ */
+void Ions::divideFluxByDensity()
+{
+    double const* rho = &(*rho_.begin());
+    double* vx        = &(*bulkVel_.component(VecField::VecX).begin());
+    double* vy        = &(*bulkVel_.component(VecField::VecY).begin());
+    double* vz        = &(*bulkVel_.component(VecField::VecZ).begin());
+
+    std::size_t nbrNodes = rho_.size();
+    for (std::size_t i = 0; i < nbrNodes; ++i)
+    {
+        vx[i] /= rho[i];
+        vy[i] /= rho[i];
+        vz[i] /= rho[i];
+    }
 }
 
 
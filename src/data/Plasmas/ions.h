@@ -91,8 +91,9 @@ public:
     VecField const& bulkVel() const { return bulkVel_; }
 
     void loadParticles();
-    void computeChargeDensity();
-    void computeBulkVelocity();
+
+    void computeDensityAndFlux();
+    void divideFluxByDensity();
 };
 
 
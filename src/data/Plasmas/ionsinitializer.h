@@ -25,6 +25,7 @@
  *  - its ParticleInitializer.
  *  - the mass of its particles
  *  - its name
+ *  - its push interval, the number of steps between two pushes of its particles
  *
  *
  * IonsInitializer objects are default constructible.
@@ -35,6 +36,7 @@ struct IonsInitializer
     std::vector<std::unique_ptr<ParticleInitializer>> particleInitializers;
     std::vector<double> masses;
     std::vector<std::string> names;
+    std::vector<uint32> pushIntervals;
     uint32 nbrSpecies;
 };
 
@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "particlearray.h"
+
+
+
+void ParticleArray::resize(size_type size)
+{
+    weight_.resize(size);
+    charge_.resize(size);
+
+    for (uint32 dir = 0; dir < nbrDirections; ++dir)
+    {
+        icell_[dir].resize(size);
+        delta_[dir].resize(size);
+        v_[dir].resize(size);
+#ifdef DEBUG_PARTICLE_FIELDS
+        E_[dir].resize(size);
+        B_[dir].resize(size);
+#endif
+    }
+}
+
+
+
+void ParticleArray::reserve(size_type capacity)
+{
+    weight_.reserve(capacity);
+    charge_.reserve(capacity);
+
+    for (uint32 dir = 0; dir < nbrDirections; ++dir)
+    {
+        icell_[dir].reserve(capacity);
+        delta_[dir].reserve(capacity);
+        v_[dir].reserve(capacity);
+#ifdef DEBUG_PARTICLE_FIELDS
+        E_[dir].reserve(capacity);
+        B_[dir].reserve(capacity);
+#endif
+    }
+}
+
+
+
+void ParticleArray::clear()
+{
+    weight_.clear();
+    charge_.clear();
+
+    for (uint32 dir = 0; dir < nbrDirections; ++dir)
+    {
+        icell_[dir].clear();
+        delta_[dir].clear();
+        v_[dir].clear();
+#ifdef DEBUG_PARTICLE_FIELDS
+        E_[dir].clear();
+        B_[dir].clear();
+#endif
+    }
+}
+
+
+
+Particle ParticleArray::operator[](size_type iPart) const
+{
+    Particle particle{weight_[iPart],
+                      charge_[iPart],
+                      {{icell_[0][iPart], icell_[1][iPart], icell_[2][iPart]}},
+                      {{delta_[0][iPart], delta_[1][iPart], delta_[2][iPart]}},
+                      {{v_[0][iPart], v_[1][iPart], v_[2][iPart]}}};
+
+#ifdef DEBUG_PARTICLE_FIELDS
+    particle.Ex = E_[0][iPart];
+    particle.Ey = E_[1][iPart];
+    particle.Ez = E_[2][iPart];
+    particle.Bx = B_[0][iPart];
+    particle.By = B_[1][iPart];
+    particle.Bz = B_[2][iPart];
+#endif
+
+    return particle;
+}
+
+
+
+void ParticleArray::setParticle(size_type iPart, Particle const& particle)
+{
+    weight_[iPart] = particle.weight;
+    charge_[iPart] = particle.charge;
+
+    for (uint32 dir = 0; dir < nbrDirections; ++dir)
+    {
+        icell_[dir][iPart] = particle.icell[dir];
+        delta_[dir][iPart] = particle.delta[dir];
+        v_[dir][iPart]     = particle.v[dir];
+    }
+
+#ifdef DEBUG_PARTICLE_FIELDS
+    E_[0][iPart] = particle.Ex;
+    E_[1][iPart] = particle.Ey;
+    E_[2][iPart] = particle.Ez;
+    B_[0][iPart] = particle.Bx;
+    B_[1][iPart] = particle.By;
+    B_[2][iPart] = particle.Bz;
+#endif
+}
+
+
+
+void ParticleArray::push_back(Particle const& particle)
+{
+    resize(size() + 1);
+    setParticle(size() - 1, particle);
+}
+
+
+
+void ParticleArray::pop_back()
+{
+    resize(size() - 1);
+}
+
+
+
+template<typename T>
+static void appendStream(std::vector<T>& dest, std::vector<T> const& source)
+{
+    dest.insert(dest.end(), source.begin(), source.end());
+}
+
+
+void ParticleArray::append(ParticleArray const& source)
+{
+    appendStream(weight_, source.weight_);
+    appendStream(charge_, source.charge_);
+
+    for (uint32 dir = 0; dir < nbrDirections; ++dir)
+    {
+        appendStream(icell_[dir], source.icell_[dir]);
+        appendStream(delta_[dir], source.delta_[dir]);
+        appendStream(v_[dir], source.v_[dir]);
+#ifdef DEBUG_PARTICLE_FIELDS
+        appendStream(E_[dir], source.E_[dir]);
+        appendStream(B_[dir], source.B_[dir]);
+#endif
+    }
+}
+
+
+
+template<typename T>
+static void assignStream(std::vector<T>& dest, std::vector<T> const& source, std::size_t first,
+                         std::size_t count)
+{
+    dest.assign(source.begin() + static_cast<long>(first),
+                source.begin() + static_cast<long>(first + count));
+}
+
+
+void ParticleArray::assign(ParticleArray const& source, size_type first, size_type count)
+{
+    assignStream(weight_, source.weight_, first, count);
+    assignStream(charge_, source.charge_, first, count);
+
+    for (uint32 dir = 0; dir < nbrDirections; ++dir)
+    {
+        assignStream(icell_[dir], source.icell_[dir], first, count);
+        assignStream(delta_[dir], source.delta_[dir], first, count);
+        assignStream(v_[dir], source.v_[dir], first, count);
+#ifdef DEBUG_PARTICLE_FIELDS
+        assignStream(E_[dir], source.E_[dir], first, count);
+        assignStream(B_[dir], source.B_[dir], first, count);
+#endif
+    }
+}
+
+
+
+void ParticleArray::copyParticle(size_type iSource, size_type iDest)
+{
+    weight_[iDest] = weight_[iSource];
+    charge_[iDest] = charge_[iSource];
+
+    for (uint32 dir = 0; dir < nbrDirections; ++dir)
+    {
+        icell_[dir][iDest] = icell_[dir][iSource];
+        delta_[dir][iDest] = delta_[dir][iSource];
+        v_[dir][iDest]     = v_[dir][iSource];
+#ifdef DEBUG_PARTICLE_FIELDS
+        E_[dir][iDest] = E_[dir][iSource];
+        B_[dir][iDest] = B_[dir][iSource];
+#endif
+    }
+}
+
+
+
+/**
+ * @brief ParticleArray::permute moves each particle 'iPart' to 'destination[iPart]'
+ * in place, following the cycles of the permutation so that no second particle
+ * array is needed. A particle put in place is marked by making its destination
+ * its own index, 'destination' therefore ends up as the identity.
+ */
+void ParticleArray::permute(std::vector<uint32>& destination)
+{
+    if (destination.size() != size())
+        throw std::runtime_error("ParticleArray - the permutation does not match the particles");
+
+    for (uint32 iStart = 0; iStart < destination.size(); ++iStart)
+    {
+        if (destination[iStart] == iStart)
+            continue;
+
+        // carry the particle of 'iStart' along its cycle, until the particle
+        // that goes to 'iStart' is reached
+        Particle carried = (*this)[iStart];
+        uint32 iDest     = destination[iStart];
+
+        destination[iStart] = iStart;
+
+        while (iDest != iStart)
+        {
+            Particle next = (*this)[iDest];
+            setParticle(iDest, carried);
+
+            uint32 iNext       = destination[iDest];
+            destination[iDest] = iDest;
+            carried            = next;
+            iDest              = iNext;
+        }
+
+        setParticle(iStart, carried);
+    }
+}
+
+
+
+// shift the elements between two removed ones down to fill the holes,
+// in a single pass over the stream
+template<typename T>
+static void compactStream(std::vector<T>& stream, std::vector<uint32> const& sortedIndexes)
+{
+    auto dest = stream.begin() + sortedIndexes[0];
+
+    for (std::size_t iRemoved = 0; iRemoved < sortedIndexes.size(); ++iRemoved)
+    {
+        auto first = stream.begin() + sortedIndexes[iRemoved] + 1;
+        auto last  = iRemoved + 1 < sortedIndexes.size()
+                        ? stream.begin() + sortedIndexes[iRemoved + 1]
+                        : stream.end();
+
+        dest = std::copy(first, last, dest);
+    }
+
+    stream.erase(dest, stream.end());
+}
+
+
+void ParticleArray::remove(std::vector<uint32> const& sortedIndexes)
+{
+    if (sortedIndexes.empty())
+        return;
+
+    if (sortedIndexes.back() >= size())
+        throw std::runtime_error("ParticleArray - index of removed particle out of range");
+
+    compactStream(weight_, sortedIndexes);
+    compactStream(charge_, sortedIndexes);
+
+    for (uint32 dir = 0; dir < nbrDirections; ++dir)
+    {
+        compactStream(icell_[dir], sortedIndexes);
+        compactStream(delta_[dir], sortedIndexes);
+        compactStream(v_[dir], sortedIndexes);
+#ifdef DEBUG_PARTICLE_FIELDS
+        compactStream(E_[dir], sortedIndexes);
+        compactStream(B_[dir], sortedIndexes);
+#endif
+    }
+}
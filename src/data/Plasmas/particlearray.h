@@ -0,0 +1,172 @@
+#ifndef PARTICLEARRAY_H
+#define PARTICLEARRAY_H
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "particles.h"
+#include "utilities/types.h"
+
+
+
+/**
+ * @brief The ParticleArray class stores particles as a structure of arrays.
+ *
+ * Each particle attribute (weight, charge, icell, delta and velocity) lives
+ * in its own contiguous stream so that kernels like the pusher or the
+ * interpolator only pull into cache the attributes they actually use.
+ *
+ * The fields at the particle position are not stored: the pusher gathers them
+ * on the fly. Building with DEBUG_PARTICLE_FIELDS adds E and B streams in
+ * which the pusher records the gathered fields.
+ *
+ * Kernels work directly on the streams (icell(dim), delta(dim), v(dim), ...).
+ * Code that deals with particles one at a time (boundary conditions,
+ * splitting, diagnostics) can use the AoS-compatible view: operator[] returns
+ * a Particle by value, setParticle() writes one back, and iterating over a
+ * ParticleArray yields Particle values.
+ */
+class ParticleArray
+{
+public:
+    using size_type = std::vector<double>::size_type;
+
+
+    /**
+     * @brief const_iterator is the AoS view on a ParticleArray. Dereferencing
+     * it gathers the particle attributes into a Particle returned by value.
+     */
+    class const_iterator
+    {
+    private:
+        ParticleArray const* array_;
+        size_type index_;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Particle;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = Particle const*;
+        using reference         = Particle;
+
+        const_iterator(ParticleArray const* array, size_type index)
+            : array_{array}
+            , index_{index}
+        {
+        }
+
+        Particle operator*() const { return (*array_)[index_]; }
+
+        const_iterator& operator++()
+        {
+            ++index_;
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator current{*this};
+            ++index_;
+            return current;
+        }
+
+        bool operator==(const_iterator const& other) const
+        {
+            return array_ == other.array_ && index_ == other.index_;
+        }
+        bool operator!=(const_iterator const& other) const { return !(*this == other); }
+    };
+
+
+
+private:
+    static const uint32 nbrDirections = 3;
+
+    std::vector<double> weight_;
+    std::vector<double> charge_;
+    std::array<std::vector<int32>, nbrDirections> icell_;
+    std::array<std::vector<float>, nbrDirections> delta_;
+    std::array<std::vector<double>, nbrDirections> v_;
+
+#ifdef DEBUG_PARTICLE_FIELDS
+    // electromagnetic field at the particle position
+    std::array<std::vector<double>, nbrDirections> E_;
+    std::array<std::vector<double>, nbrDirections> B_;
+#endif
+
+public:
+    ParticleArray() = default;
+    explicit ParticleArray(size_type size) { resize(size); }
+
+    ParticleArray(ParticleArray const& source) = default;
+    ParticleArray& operator=(ParticleArray const& source) = default;
+
+    ParticleArray(ParticleArray&& source) = default;
+    ParticleArray& operator=(ParticleArray&& source) = default;
+
+
+    size_type size() const { return weight_.size(); }
+    bool empty() const { return weight_.empty(); }
+
+    void resize(size_type size);
+    void reserve(size_type capacity);
+    void clear();
+
+
+    // AoS-compatible view
+
+    Particle operator[](size_type iPart) const;
+    void setParticle(size_type iPart, Particle const& particle);
+    void push_back(Particle const& particle);
+    void pop_back();
+    void append(ParticleArray const& source);
+
+    //! replace our particles by the 'count' particles of 'source' starting at 'first'
+    void assign(ParticleArray const& source, size_type first, size_type count);
+
+    //! copy all attributes of particle 'iSource' onto particle 'iDest'
+    void copyParticle(size_type iSource, size_type iDest);
+
+    //! move each particle 'iPart' to 'destination[iPart]', a permutation of
+    //! the indexes, which is left as the identity
+    void permute(std::vector<uint32>& destination);
+
+    //! remove the particles of the sorted, duplicate free, 'sortedIndexes'
+    //! the remaining particles keep their order
+    void remove(std::vector<uint32> const& sortedIndexes);
+
+    const_iterator begin() const { return const_iterator{this, 0}; }
+    const_iterator end() const { return const_iterator{this, size()}; }
+
+
+    // SoA streams
+
+    std::vector<double>& weight() { return weight_; }
+    std::vector<double> const& weight() const { return weight_; }
+
+    std::vector<double>& charge() { return charge_; }
+    std::vector<double> const& charge() const { return charge_; }
+
+    std::vector<int32>& icell(uint32 direction) { return icell_[direction]; }
+    std::vector<int32> const& icell(uint32 direction) const { return icell_[direction]; }
+
+    std::vector<float>& delta(uint32 direction) { return delta_[direction]; }
+    std::vector<float> const& delta(uint32 direction) const { return delta_[direction]; }
+
+    std::vector<double>& v(uint32 component) { return v_[component]; }
+    std::vector<double> const& v(uint32 component) const { return v_[component]; }
+
+#ifdef DEBUG_PARTICLE_FIELDS
+    std::vector<double>& E(uint32 component) { return E_[component]; }
+    std::vector<double> const& E(uint32 component) const { return E_[component]; }
+
+    std::vector<double>& B(uint32 component) { return B_[component]; }
+    std::vector<double> const& B(uint32 component) const { return B_[component]; }
+#endif
+};
+
+
+
+#endif // PARTICLEARRAY_H
@@ -5,7 +5,7 @@
 #include <array>
 #include <vector>
 
-#include "particles.h"
+#include "particlearray.h"
 //#include "grid/gridlayout.h"
 
 
@@ -27,7 +27,7 @@ class ParticleInitializer
 {
 protected:
 public:
-    virtual void loadParticles(std::vector<Particle>& particles) const = 0;
+    virtual void loadParticles(ParticleArray& particles) const = 0;
 
     virtual ~ParticleInitializer() = 0;
 };
@@ -42,7 +42,7 @@ public:
 
 
 /**
-  \fn virtual void ParticleInitializer::loadParticles(std::vector<Particle>& particles) const = 0
+  \fn virtual void ParticleInitializer::loadParticles(ParticleArray& particles) const = 0
   \brief load particles into a Particle array following a method implemented in concrete classes
   \param particles is the vector to be filled. Assumed of size 0
   */
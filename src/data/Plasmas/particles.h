@@ -17,8 +17,10 @@ public:
     std::array<float, 3> delta; // value in [0, 1] in each direction
     std::array<double, 3> v;    // velocity in each direction
 
-    double Ex, Ey, Ez; // electric field at the particle position
-    double Bx, By, Bz; // magnetic field at the particle position
+#ifdef DEBUG_PARTICLE_FIELDS
+    double Ex, Ey, Ez; // electric field at the particle position, recorded by the pusher
+    double Bx, By, Bz; // magnetic field at the particle position, recorded by the pusher
+#endif
 
     Particle() = default;
 
@@ -30,12 +32,14 @@ public:
         , delta{delta}
         , v{v}
     {
+#ifdef DEBUG_PARTICLE_FIELDS
         Ex = 0.;
         Ey = 0.;
         Ez = 0.;
         Bx = 0.;
         By = 0.;
         Bz = 0.;
+#endif
     }
 };
 
@@ -1,9 +1,17 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
 #include "species.h"
 #include "data/grid/gridlayout.h"
+#include "data/vecfield/vecfieldexpression.h"
 
 
 Species::Species(GridLayout const& layout, double mass,
-                 std::unique_ptr<ParticleInitializer> particleInitializer, std::string const& name)
+                 std::unique_ptr<ParticleInitializer> particleInitializer, std::string const& name,
+                 uint32 pushInterval)
     : mass_{mass}
     , name_{name}
     , rho_{layout.allocSize(HybridQuantity::rho), HybridQuantity::rho, "_rhoTot"}
@@ -12,11 +20,18 @@ Species::Species(GridLayout const& layout, double mass,
             layout.allocSize(HybridQuantity::V),
             {{HybridQuantity::V, HybridQuantity::V, HybridQuantity::V}},
             "_fluxSpecies"}
+    , pushInterval_{pushInterval}
     , particleArray_{}
     , particleInitializer_{std::move(particleInitializer)} // TODO broken copy
+    , depositBuffer_{}
+    , cellOffsetsValid_{false}
+    , cellIndexValid_{false}
+    , particlesVersion_{0}
 {
     // TODO should check stuff here.
     // like : is particleInitializer OK?
+    if (pushInterval_ == 0)
+        throw std::runtime_error("Species - the push interval must be at least 1");
 }
 
 
@@ -24,4 +39,327 @@ Species::Species(GridLayout const& layout, double mass,
 void Species::loadParticles()
 {
     particleInitializer_->loadParticles(particleArray_);
+    particlesMayChange_();
+}
+
+
+
+
+void Species::startDeposit()
+{
+    depositBuffer_.reset(rho_.size());
+}
+
+
+
+
+/**
+ * @brief Species::finishDeposit adds up the slabs of the deposit buffer and
+ * copies its interleaved moments in rho and the x, y and z fluxes, once for
+ * all the deposits of the phase.
+ */
+void Species::finishDeposit()
+{
+    depositBuffer_.reduce();
+
+    std::vector<double> const& interleaved = depositBuffer_.moments();
+    std::array<Field*, DepositBuffer::nbrMoments> moments{
+        {&rho_, &flux_.component(0), &flux_.component(1), &flux_.component(2)}};
+
+    uint32 nbrNodes = rho_.size();
+
+    for (uint32 iMoment = 0; iMoment < DepositBuffer::nbrMoments; ++iMoment)
+    {
+        double* moment = &*moments[iMoment]->begin();
+        for (uint32 i = 0; i < nbrNodes; ++i)
+            moment[i] = interleaved[DepositBuffer::nbrMoments * i + iMoment];
+    }
+}
+
+
+
+
+/**
+ * @brief Species::keepStartMoments keeps the current moments as those at the
+ * start of a push interval, before the particles are pushed over it.
+ */
+void Species::keepStartMoments()
+{
+    rhoStart_  = rho_;
+    fluxStart_ = flux_;
+}
+
+
+
+
+/**
+ * @brief Species::keepEndMoments keeps the current moments, deposited by the
+ * particles pushed to the end of the push interval, as those at its end.
+ */
+void Species::keepEndMoments()
+{
+    rhoEnd_  = rho_;
+    fluxEnd_ = flux_;
+}
+
+
+
+
+/**
+ * @brief Species::interpolateMoments sets the moments to their linear
+ * interpolation in time between the start (weight 0) and the end (weight 1)
+ * of the push interval
+ */
+void Species::interpolateMoments(double weight)
+{
+    rho_  = rhoStart_ + (rhoEnd_ - rhoStart_) * weight;
+    flux_ = fluxStart_ + (fluxEnd_ - fluxStart_) * weight;
+}
+
+
+
+
+/**
+ * @brief CellIndexing gives the linear index of the cell of a particle, cells
+ * being numbered from the first ghost node in each direction, with the last
+ * direction varying fastest.
+ */
+class CellIndexing
+{
+private:
+    uint32 nbDims_;
+    std::array<int32, 3> start_;
+    std::array<uint32, 3> nbrCells_;
+
+public:
+    explicit CellIndexing(GridLayout const& layout)
+        : nbDims_{layout.nbDimensions()}
+        , start_{{0, 0, 0}}
+        , nbrCells_{{1, 1, 1}}
+    {
+        for (uint32 dim = 0; dim < nbDims_; ++dim)
+        {
+            Direction direction = static_cast<Direction>(dim);
+
+            uint32 start = layout.ghostStartIndex(QtyCentering::primal, direction);
+            uint32 end   = layout.ghostEndIndex(QtyCentering::primal, direction);
+
+            start_[dim]    = static_cast<int32>(start);
+            nbrCells_[dim] = end - start + 1;
+        }
+    }
+
+    uint32 nbrCells() const { return nbrCells_[0] * nbrCells_[1] * nbrCells_[2]; }
+
+    //! number of cells and index of the first cell in the direction 'dim'
+    uint32 nbrCells(uint32 dim) const { return nbrCells_[dim]; }
+    int32 start(uint32 dim) const { return start_[dim]; }
+
+    uint32 operator()(ParticleArray const& particles, ParticleArray::size_type iPart) const
+    {
+        uint32 cell = 0;
+
+        for (uint32 dim = 0; dim < nbDims_; ++dim)
+        {
+            int32 localIndex = particles.icell(dim)[iPart] - start_[dim];
+
+            if (localIndex < 0 || static_cast<uint32>(localIndex) >= nbrCells_[dim])
+                throw std::runtime_error("Species - particle out of the patch cells");
+
+            cell = cell * nbrCells_[dim] + static_cast<uint32>(localIndex);
+        }
+
+        return cell;
+    }
+};
+
+
+
+/**
+ * @brief countingSortCells computes, from the cell 'cells[iPart]' of each
+ * particle, the offsets of the cells once the particles are grouped by cell:
+ * those of cell 'iCell' are in [offsets[iCell], offsets[iCell+1][. Each cell
+ * in 'cells' is replaced by the place of its particle in the grouping, which
+ * keeps the order of the particles within a cell.
+ */
+static void countingSortCells(std::vector<uint32>& cells, uint32 nbrCells,
+                              std::vector<uint32>& offsets)
+{
+    uint32 nbrParticles = static_cast<uint32>(cells.size());
+
+    offsets.assign(nbrCells + 1, 0);
+
+    for (uint32 iPart = 0; iPart < nbrParticles; ++iPart)
+        ++offsets[cells[iPart] + 1];
+
+    for (uint32 iCell = 0; iCell < nbrCells; ++iCell)
+        offsets[iCell + 1] += offsets[iCell];
+
+    // the offset of each cell is used as the next free place in the cell, it
+    // ends up as the offset of the next cell, which shifts the offsets by one
+    for (uint32 iPart = 0; iPart < nbrParticles; ++iPart)
+        cells[iPart] = offsets[cells[iPart]]++;
+
+    std::copy_backward(offsets.begin(), offsets.end() - 2, offsets.end() - 1);
+    offsets[0] = 0;
+}
+
+
+
+
+/**
+ * @brief Species::sortParticles sorts the particles by cell with a counting
+ * sort, so that particles close in space are also close in memory.
+ *
+ * The sort is stable and done in place, see ParticleArray::permute, so that
+ * it needs no second particle array. The cell offsets are valid, and
+ * cellOffsets() usable, until the particles may change.
+ */
+void Species::sortParticles(GridLayout const& layout)
+{
+    CellIndexing cellIndex{layout};
+
+    uint32 nbrParticles = static_cast<uint32>(particleArray_.size());
+
+    sortCells_.resize(nbrParticles);
+    for (uint32 iPart = 0; iPart < nbrParticles; ++iPart)
+        sortCells_[iPart] = cellIndex(particleArray_, iPart);
+
+    // sortCells_ now receives the destination of each particle
+    countingSortCells(sortCells_, cellIndex.nbrCells(), cellOffsets_);
+
+    particleArray_.permute(sortCells_);
+    particlesMayChange_();
+
+    cellOffsetsValid_ = true;
+}
+
+
+
+
+/**
+ * @brief Species::indexParticleCells groups the indexes of the particles by
+ * cell, with a counting sort that does not move the particles, so that
+ * particlesNearBox() only visits the particles of a few cells. Within a cell,
+ * the indexes are increasing. The index is dropped as soon as the particles
+ * may change.
+ */
+void Species::indexParticleCells(GridLayout const& layout)
+{
+    CellIndexing cellIndex{layout};
+
+    uint32 nbrParticles = static_cast<uint32>(particleArray_.size());
+
+    sortCells_.resize(nbrParticles);
+    for (uint32 iPart = 0; iPart < nbrParticles; ++iPart)
+        sortCells_[iPart] = cellIndex(particleArray_, iPart);
+
+    countingSortCells(sortCells_, cellIndex.nbrCells(), cellIndexOffsets_);
+
+    cellIndexParticles_.resize(nbrParticles);
+    for (uint32 iPart = 0; iPart < nbrParticles; ++iPart)
+        cellIndexParticles_[sortCells_[iPart]] = iPart;
+
+    cellIndexValid_ = true;
+}
+
+
+
+
+/**
+ * @brief Species::particlesNearBox gives, in increasing order, the indexes of
+ * the particles in the cells of 'layout' that overlap 'box', with one more cell
+ * on each side against rounding. This is a superset of the particles in the
+ * box, which callers still have to select, found with the cell index.
+ */
+void Species::particlesNearBox(Box const& box, GridLayout const& layout,
+                               std::vector<uint32>& indexes) const
+{
+    if (!cellIndexValid_)
+        throw std::runtime_error("Species - the particle cells are not indexed");
+
+    CellIndexing cellIndex{layout};
+
+    Box layoutBox = layout.getBox();
+
+    std::array<double, 3> boxMin{{box.x0, box.y0, box.z0}};
+    std::array<double, 3> boxMax{{box.x1, box.y1, box.z1}};
+    std::array<double, 3> origin{{layoutBox.x0, layoutBox.y0, layoutBox.z0}};
+    std::array<double, 3> spacing = layout.dxdydz();
+
+    int32 nbrGhosts = static_cast<int32>(layout.nbrGhostNodes(QtyCentering::primal));
+
+    // range of the local cell indexes in each direction, a single cell beyond
+    // the dimensionality
+    std::array<uint32, 3> first{{0, 0, 0}};
+    std::array<uint32, 3> last{{0, 0, 0}};
+
+    indexes.clear();
+
+    for (uint32 dim = 0; dim < layout.nbDimensions(); ++dim)
+    {
+        // a particle of cell 'icell' is at (icell - nbrGhosts + delta) * spacing + origin
+        double lower = std::floor((boxMin[dim] - origin[dim]) / spacing[dim]);
+        double upper = std::floor((boxMax[dim] - origin[dim]) / spacing[dim]);
+
+        double localFirst = lower + nbrGhosts - 1 - cellIndex.start(dim);
+        double localLast  = upper + nbrGhosts + 1 - cellIndex.start(dim);
+
+        double lastCell = static_cast<double>(cellIndex.nbrCells(dim) - 1);
+
+        if (localLast < 0. || localFirst > lastCell)
+            return;
+
+        first[dim] = static_cast<uint32>(std::max(localFirst, 0.));
+        last[dim]  = static_cast<uint32>(std::min(localLast, lastCell));
+    }
+
+    for (uint32 ix = first[0]; ix <= last[0]; ++ix)
+    {
+        for (uint32 iy = first[1]; iy <= last[1]; ++iy)
+        {
+            uint32 row = (ix * cellIndex.nbrCells(1) + iy) * cellIndex.nbrCells(2);
+
+            uint32 begin = cellIndexOffsets_[row + first[2]];
+            uint32 end   = cellIndexOffsets_[row + last[2] + 1];
+
+            indexes.insert(indexes.end(), cellIndexParticles_.begin() + begin,
+                           cellIndexParticles_.begin() + end);
+        }
+    }
+
+    std::sort(indexes.begin(), indexes.end());
+}
+
+
+
+/**
+ * @brief Species::particleDisorder is the fraction of particles that are
+ * more than one cell away from the previous particle of the array.
+ *
+ * It is close to 0 right after a sort and goes to 1 when the particles are
+ * randomly scattered in memory.
+ */
+double Species::particleDisorder(GridLayout const& layout) const
+{
+    CellIndexing cellIndex{layout};
+
+    uint32 nbrParticles = static_cast<uint32>(particleArray_.size());
+    if (nbrParticles < 2)
+        return 0.;
+
+    uint32 nbrJumps = 0;
+    uint32 previous = cellIndex(particleArray_, 0);
+
+    for (uint32 iPart = 1; iPart < nbrParticles; ++iPart)
+    {
+        uint32 cell = cellIndex(particleArray_, iPart);
+
+        if (cell > previous + 1 || previous > cell + 1)
+            ++nbrJumps;
+
+        previous = cell;
+    }
+
+    return static_cast<double>(nbrJumps) / (nbrParticles - 1);
 }
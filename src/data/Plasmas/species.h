@@ -3,8 +3,10 @@
 
 #include "data/Field/field.h"
 #include "data/vecfield/vecfield.h"
+#include "depositbuffer.h"
+#include "particlearray.h"
 #include "particleinitializer.h"
-#include "particles.h"
+#include "utilities/box.h"
 
 
 class GridLayout;
@@ -23,13 +25,52 @@ private:
     std::string name_;
     Field rho_;
     VecField flux_;
-    std::vector<Particle> particleArray_;
+
+    // the species is pushed every 'pushInterval_' steps. In between, its
+    // moments are interpolated between those at the start and the end of the
+    // push interval.
+    uint32 pushInterval_;
+    Field rhoStart_;
+    VecField fluxStart_;
+    Field rhoEnd_;
+    VecField fluxEnd_;
+    ParticleArray particleArray_;
     std::unique_ptr<ParticleInitializer> particleInitializer_;
 
+    // interleaved moments and private slabs of the particle deposition
+    DepositBuffer depositBuffer_;
+
+    // scratch buffer of the cell sort, kept to avoid reallocating it
+    std::vector<uint32> sortCells_;
+
+    // offsets of the cells in the particles sorted by cell, valid until the
+    // particles change, see sortParticles
+    std::vector<uint32> cellOffsets_;
+    bool cellOffsetsValid_;
+
+    // cell index of the particles, which are not moved: the particles of cell
+    // 'iCell' are cellIndexParticles_[cellIndexOffsets_[iCell] .. [iCell+1][.
+    // It is valid until the particles change, see indexParticleCells
+    std::vector<uint32> cellIndexOffsets_;
+    std::vector<uint32> cellIndexParticles_;
+    bool cellIndexValid_;
+
+    // incremented whenever the particles may change, so that the particles
+    // derived from them can tell whether they are still up to date
+    uint64 particlesVersion_;
+
+    void particlesMayChange_()
+    {
+        cellOffsetsValid_ = false;
+        cellIndexValid_   = false;
+        ++particlesVersion_;
+    }
+
 
 public:
     Species(GridLayout const& layout, double mass,
-            std::unique_ptr<ParticleInitializer> particleInitializer, std::string const& name);
+            std::unique_ptr<ParticleInitializer> particleInitializer, std::string const& name,
+            uint32 pushInterval = 1);
 
     Species(Species const& source) = delete;
     Species& operator=(Species const& source) = delete;
@@ -43,7 +84,11 @@ public:
         flux_.zero();
     }
 
-    void resetParticles() { particleArray_.clear(); }
+    void resetParticles()
+    {
+        particleArray_.clear();
+        particlesMayChange_();
+    }
 
     Field& rho() { return rho_; }
     Field const& rho() const { return rho_; }
@@ -54,15 +99,60 @@ public:
     Field& flux(uint32 iComponent) { return flux_.component(iComponent); }
     Field const& flux(uint32 iComponent) const { return flux_.component(iComponent); }
 
-    std::vector<Particle>& particles() { return particleArray_; }
-    std::vector<Particle> const& particles() const { return particleArray_; }
+    DepositBuffer& depositBuffer() { return depositBuffer_; }
+
+    // a deposit phase zeroes the deposit buffer, which then accumulates the
+    // particles of any number of deposits, and ends by copying it in rho and
+    // the flux, see depositChargeDensityAndFlux
+    void startDeposit();
+    void finishDeposit();
+
+    // the particles may be changed through this accessor, the cell index is dropped
+    ParticleArray& particles()
+    {
+        particlesMayChange_();
+        return particleArray_;
+    }
+    ParticleArray const& particles() const { return particleArray_; }
 
     double mass() const { return mass_; }
     std::string name() const { return name_; }
-    std::vector<Particle>::size_type nbrParticles() const { return particleArray_.size(); }
+    uint32 pushInterval() const { return pushInterval_; }
+    ParticleArray::size_type nbrParticles() const { return particleArray_.size(); }
 
     void loadParticles();
 
+    void keepStartMoments();
+
+    void keepEndMoments();
+
+    void interpolateMoments(double weight);
+
+    void sortParticles(GridLayout const& layout);
+
+    double particleDisorder(GridLayout const& layout) const;
+
+    //! particles of cell 'iCell' are in [cellOffsets()[iCell], cellOffsets()[iCell+1][
+    //! as long as the particles are not changed after sortParticles
+    std::vector<uint32> const& cellOffsets() const
+    {
+        if (!cellOffsetsValid_)
+            throw std::runtime_error("Species - the particles are not sorted by cell");
+        return cellOffsets_;
+    }
+
+    bool hasCellOffsets() const { return cellOffsetsValid_; }
+
+    void indexParticleCells(GridLayout const& layout);
+
+    bool hasCellIndex() const { return cellIndexValid_; }
+
+    //! changes whenever the particles may have changed
+    uint64 particlesVersion() const { return particlesVersion_; }
+
+    void particlesNearBox(Box const& box, GridLayout const& layout,
+                          std::vector<uint32>& indexes) const;
+
     // void compute1DChargeDensityAndFlux(Interpolator & project );
 };
 
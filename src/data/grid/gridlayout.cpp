@@ -296,7 +296,11 @@ void GridLayout::deriv(Field const& operand, Direction direction, Field& derivat
     {
         case 1: implPtr_->deriv1D(operand, derivative); break;
 
-        default: throw std::runtime_error("Error - only 1D fields are handled for the moment ");
+        case 2: implPtr_->deriv2D(operand, direction, derivative); break;
+
+        case 3: implPtr_->deriv3D(operand, direction, derivative); break;
+
+        default: throw std::runtime_error("Error - GridLayout::deriv dimension must be 1, 2 or 3");
     }
 }
 
@@ -363,6 +367,12 @@ QtyCentering GridLayout::fieldCentering(Field const& field, Direction dir) const
 }
 
 
+QtyCentering GridLayout::fieldCentering(HybridQuantity qty, Direction dir) const
+{
+    return implPtr_->fieldCentering(qty, dir);
+}
+
+
 
 uint32 GridLayout::nbrGhostNodes(QtyCentering const& centering) const
 {
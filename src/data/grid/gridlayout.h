@@ -144,6 +144,7 @@ public:
     Point cellCenteredCoordinates(uint32 ix, uint32 iy, uint32 iz) const;
 
     QtyCentering fieldCentering(Field const& field, Direction dir) const;
+    QtyCentering fieldCentering(HybridQuantity qty, Direction dir) const;
 
     uint32 nbrGhostNodes(QtyCentering const& centering) const;
     uint32 nbrGhostNodes(Field const& field, Direction direction) const;
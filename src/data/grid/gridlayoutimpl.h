@@ -64,13 +64,14 @@ public:
     virtual AllocSizeT allocSizeDerived(HybridQuantity qty, Direction dir) const = 0;
 
     virtual void deriv1D(Field const& operand, Field& derivative) const = 0;
-    // virtual void deriv2D(Field const& operand, Direction direction, Field& derivative)const = 0;
-    // virtual void deriv3D(Field const& operand, Direction direction, Field& derivative)const = 0;
+    virtual void deriv2D(Field const& operand, Direction direction, Field& derivative) const = 0;
+    virtual void deriv3D(Field const& operand, Direction direction, Field& derivative) const = 0;
     virtual Point fieldNodeCoordinates(const Field& field, const Point& origin, uint32 ix,
                                        uint32 iy, uint32 iz) const = 0;
 
     virtual Point cellCenteredCoordinates(uint32 ix, uint32 iy, uint32 iz) const = 0;
     virtual QtyCentering fieldCentering(Field const& field, Direction dir) const = 0;
+    virtual QtyCentering fieldCentering(HybridQuantity qty, Direction dir) const = 0;
 
     virtual uint32 nbrGhostNodes(QtyCentering centering) const = 0;
     virtual std::array<uint32, NBR_COMPO> nbrPhysicalNodes(Field const& field) const    = 0;
@@ -526,10 +526,16 @@ uint32 GridLayoutImplInternals::isDual(QtyCentering centering) const noexcept
 
 
 QtyCentering GridLayoutImplInternals::fieldCentering_(Field const& field, Direction dir) const
+{
+    return fieldCentering_(field.hybridQty(), dir);
+}
+
+
+QtyCentering GridLayoutImplInternals::fieldCentering_(HybridQuantity qty, Direction dir) const
 {
     uint32 iDir = static_cast<uint32>(dir);
 
-    uint32 iQty = static_cast<uint32>(field.hybridQty());
+    uint32 iQty = static_cast<uint32>(qty);
 
     return hybridQtyCentering_[iQty][iDir];
 }
@@ -580,3 +586,72 @@ void GridLayoutImplInternals::deriv1D_(Field const& operand, Field& derivative)
         ++iOp;
     }
 }
+
+
+
+
+/**
+ * @brief GridLayoutImplInternals::derivMultiD_ is the 2D and 3D version of
+ * deriv1D_. The derivative and the operand only differ in their centering in
+ * the direction of derivation, so the operand nodes are only shifted in that
+ * direction.
+ *
+ * The innermost loop runs on the last direction (Y in 2D, Z in 3D), which is
+ * contiguous in memory, and each derivative is the difference between two
+ * rows of the operand, 'stride' nodes apart.
+ */
+void GridLayoutImplInternals::derivMultiD_(Field const& operand, Direction direction,
+                                           Field& derivative) const
+{
+    uint32 iDir = static_cast<uint32>(direction);
+
+    if (iDir >= nbdims_)
+        throw std::runtime_error("Error - cannot derivate in an invariant direction");
+
+    std::array<uint32, 3> start{{0, 0, 0}};
+    std::array<uint32, 3> end{{0, 0, 0}};
+
+    for (uint32 iDim = 0; iDim < nbdims_; ++iDim)
+    {
+        start[iDim] = physicalStartIndex_(derivative, static_cast<Direction>(iDim));
+        end[iDim]   = physicalEndIndex_(derivative, static_cast<Direction>(iDim));
+    }
+
+    // first operand node used for the first derivative node, see deriv1D_
+    std::array<uint32, 3> opStart = start;
+
+    opStart[iDir] = physicalStartIndex_(operand, direction);
+    if (fieldCentering_(operand, direction) == QtyCentering::dual)
+    {
+        --opStart[iDir];
+    }
+
+    std::array<uint32, 3> const& shape = operand.shape();
+    std::array<uint32, 3> strides{{shape[1] * shape[2], shape[2], 1}};
+
+    uint32 stride  = strides[iDir];
+    double inverse = odxdydz_[iDir];
+
+    // rows run in Y in 2D and in Z in 3D, the loop on Y is a single row in 2D
+    uint32 rowDir   = nbdims_ - 1;
+    uint32 rowSize  = end[rowDir] - start[rowDir] + 1;
+    uint32 iyEnd    = (nbdims_ == 3) ? end[1] : start[1];
+    uint32 opShiftX = opStart[0] - start[0];
+    uint32 opShiftY = opStart[1] - start[1];
+
+    for (uint32 ix = start[0]; ix <= end[0]; ++ix)
+    {
+        for (uint32 iy = start[1]; iy <= iyEnd; ++iy)
+        {
+            double* der = &derivative(ix, iy, start[2]);
+
+            double const* lower = &operand(ix + opShiftX, iy + opShiftY, opStart[2]);
+            double const* upper = lower + stride;
+
+            for (uint32 i = 0; i < rowSize; ++i)
+            {
+                der[i] = inverse * (upper[i] - lower[i]);
+            }
+        }
+    }
+}
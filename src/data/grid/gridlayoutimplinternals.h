@@ -110,8 +110,10 @@ protected:
     Point cellCenteredCoordinates_(uint32 ix, uint32 iy, uint32 iz) const;
 
     void deriv1D_(Field const& operand, Field& derivative) const;
+    void derivMultiD_(Field const& operand, Direction direction, Field& derivative) const;
 
     QtyCentering fieldCentering_(Field const& field, Direction dir) const;
+    QtyCentering fieldCentering_(HybridQuantity qty, Direction dir) const;
 
     void initPhysicalStart(const gridDataT& data);
     void initPhysicalEnd(const gridDataT& data);
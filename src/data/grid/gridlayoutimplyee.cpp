@@ -2,6 +2,7 @@
 #include <tuple>
 
 #include "gridlayoutimplyee.h"
+#include "yeestencils.h"
 
 
 
@@ -26,246 +27,64 @@ GridLayoutImplYee::GridLayoutImplYee(uint32 nbDims, Point origin, uint32 interpO
 
 void GridLayoutImplYee::initLinearCombinations_()
 {
-    // cf https://hephaistos.lpp.polytechnique.fr/redmine/projects/hyb-par/wiki/Ohm
-    // for how to calculate coefficients and shift indexes.
-
-    int dualToPrimal;
-    int primalTodual;
-
-    if (interpOrder_ == 1 || interpOrder_ == 2 || interpOrder_ == 4)
-    {
-        dualToPrimal = -1;
-        primalTodual = 1;
-    }
-    else if (interpOrder_ == 3)
+    switch (nbdims_)
     {
-        dualToPrimal = 1;
-        primalTodual = -1;
-    }
-    else
-    {
-        throw std::runtime_error("GridLayout Yee cannot be initialized: wrong interpolation order");
-    }
+        case 1: initLinearCombinations_<1>(); break;
 
+        case 2: initLinearCombinations_<2>(); break;
 
-    WeightPoint P1;
-    WeightPoint P2;
-
-    // moment to Ex is Ppp to Dpp
-    // shift only in X
-    // the average is done for all simulations
-    P1.ix   = 0;
-    P1.iy   = 0;
-    P1.iz   = 0;
-    P1.coef = 0.5;
-    P2.ix   = primalTodual;
-    P2.iy   = 0;
-    P2.iz   = 0;
-    P2.coef = 0.5;
-    momentsToEx_.push_back(P1);
-    momentsToEx_.push_back(P2);
-
-
-    // moment to Ey is pPp to pDp
-    // shift only in Y
-    // the average is done only for 2D and 3D simulation
-    P1.ix   = 0;
-    P1.iy   = 0;
-    P1.iz   = 0;
-    P1.coef = (nbdims_ >= 2) ? 0.5 : 1.;
-    momentsToEy_.push_back(P1);
-
-    // in 2 and 3D, add another point and average
-    if (nbdims_ >= 2)
-    {
-        P2.ix   = 0;
-        P2.iy   = primalTodual;
-        P2.iz   = 0;
-        P2.coef = 0.5;
-        momentsToEy_.push_back(P2);
-    }
-
+        case 3: initLinearCombinations_<3>(); break;
 
-    // moment to Ez is ppP to ppD
-    // shift only in Z
-    // the average is done only for 3D simulation
-    // hence for 1D and 2D runs coef==1
-    P1.ix   = 0;
-    P1.iy   = 0;
-    P1.iz   = 0;
-    P1.coef = (nbdims_ == 3) ? 0.5 : 1;
-    momentsToEz_.push_back(P1);
-
-    if (nbdims_ == 3)
-    {
-        P2.ix   = 0;
-        P2.iy   = 0;
-        P2.iz   = primalTodual;
-        P2.coef = 0.5;
-        momentsToEz_.push_back(P2);
+        default: throw std::runtime_error("GridLayout Yee cannot be initialized: wrong dimension");
     }
+}
 
 
-
-
-    // Bx to Ey is pdD to pdP
-    // shift only in Z
-    // the average is done only for 3D simulations
-    P1.ix   = 0;
-    P1.iy   = 0;
-    P1.iz   = 0;
-    P1.coef = (nbdims_ == 3) ? 0.5 : 1;
-    BxToEy_.push_back(P1);
-
-    if (nbdims_ == 3)
-    {
-        P2.ix   = 0;
-        P2.iy   = 0;
-        P2.iz   = dualToPrimal;
-        P2.coef = 0.5;
-        BxToEy_.push_back(P2);
-    }
-
-
-
-    // Bx to Ez is pDd to pPd
-    // shift in the Y direction only
-    // the average is done for 2D and 3D simulations
-    // hence for 1D simulations coef is 1
-    P1.ix   = 0;
-    P1.iy   = 0;
-    P1.iz   = 0;
-    P1.coef = (nbdims_ >= 2) ? 0.5 : 1;
-    BxToEz_.push_back(P1);
-
-    if (nbdims_ >= 2)
+template<uint32 Dim>
+void GridLayoutImplYee::initLinearCombinations_()
+{
+    // the shift between primal and dual nodes depends on the interpolation order
+    switch (interpOrder_)
     {
-        P2.ix   = 0;
-        P2.iy   = dualToPrimal;
-        P2.iz   = 0;
-        P2.coef = 0.5;
-        BxToEz_.push_back(P2);
-    }
+        case 1: initLinearCombinations_<Dim, 1>(); break;
 
+        case 2: initLinearCombinations_<Dim, 2>(); break;
 
-    // By to Ex is dpD to dpP
-    // shift only in the Z direction
-    // averaging is done only for 3D simulations
-    P1.ix   = 0;
-    P1.iy   = 0;
-    P1.iz   = 0;
-    P1.coef = (nbdims_ == 3) ? 0.5 : 1;
-    ByToEx_.push_back(P1);
+        case 3: initLinearCombinations_<Dim, 3>(); break;
 
-    if (nbdims_ == 3)
-    {
-        P2.ix   = 0;
-        P2.iy   = 0;
-        P2.iz   = dualToPrimal;
-        P2.coef = 0.5;
-        ByToEx_.push_back(P2);
-    }
+        case 4: initLinearCombinations_<Dim, 4>(); break;
 
-    // By to Ez is Dpd to Ppd
-    // shift only in the X direction
-    // the averaging is done in all simulations
-    P1.ix   = 0;
-    P1.iy   = 0;
-    P1.iz   = 0;
-    P1.coef = 0.5;
-    P2.ix   = dualToPrimal;
-    P2.iy   = 0;
-    P2.iz   = 0;
-    P2.coef = 0.5;
-    ByToEz_.push_back(P1);
-    ByToEz_.push_back(P2);
-
-
-    // Bz to Ex is dDp to dPp
-    // shift only in the Y direction
-    // the averaging is done for 2D and 3D simulations
-    P1.ix   = 0;
-    P1.iy   = 0;
-    P1.iz   = 0;
-    P1.coef = (nbdims_ >= 2) ? 0.5 : 1;
-    BzToEx_.push_back(P1);
-
-    if (nbdims_ >= 2)
-    {
-        P2.ix   = 0;
-        P2.iy   = dualToPrimal;
-        P2.iz   = 0;
-        P2.coef = 0.5;
-        BzToEx_.push_back(P2);
+        default:
+            throw std::runtime_error(
+                "GridLayout Yee cannot be initialized: wrong interpolation order");
     }
+}
 
 
-    // Bz to Ey is Ddp to Pdp
-    // shift only in the X direction
-    // the averaging is done for all simulations
-    P1.ix   = 0;
-    P1.iy   = 0;
-    P1.iz   = 0;
-    P1.coef = 0.5;
-    BzToEy_.push_back(P1);
-    P2.ix   = dualToPrimal;
-    P2.iy   = 0;
-    P2.iz   = 0;
-    P2.coef = 0.5;
-    BzToEy_.push_back(P2);
-
-
-    // Ex to Moment is Dpp to Ppp
-    // shift only in the X direction
-    // the averaging is done for all simulations
-    P1.ix   = 0;
-    P1.iy   = 0;
-    P1.iz   = 0;
-    P1.coef = 0.5;
-    ExToMoment_.push_back(P1);
-    P2.ix   = dualToPrimal;
-    P2.iy   = 0;
-    P2.iz   = 0;
-    P2.coef = 0.5;
-    ExToMoment_.push_back(P2);
-
-
-    // Ey to Moment is pDp to PPP
-    // shift tis only in the Y direction
-    // the averaging is done for 2D and 3D simulations
-    P1.ix   = 0;
-    P1.iy   = 0;
-    P1.iz   = 0;
-    P1.coef = (nbdims_ >= 2) ? 0.5 : 1;
-    EyToMoment_.push_back(P1);
-
-    if (nbdims_ >= 2)
-    {
-        P2.ix   = 0;
-        P2.iy   = dualToPrimal;
-        P2.iz   = 0;
-        P2.coef = 0.5;
-        EyToMoment_.push_back(P2);
-    }
+/**
+ * @brief GridLayoutImplYee::initLinearCombinations_ builds the runtime
+ * LinearCombination of each projection from the compile-time YeeStencils,
+ * see yeestencils.h for the nodes and coefficients.
+ */
+template<uint32 Dim, uint32 InterpOrder>
+void GridLayoutImplYee::initLinearCombinations_()
+{
+    using Stencils = YeeStencils<Dim, InterpOrder>;
 
+    momentsToEx_ = linearCombination<typename Stencils::MomentsToEx>();
+    momentsToEy_ = linearCombination<typename Stencils::MomentsToEy>();
+    momentsToEz_ = linearCombination<typename Stencils::MomentsToEz>();
 
-    // Ez to Moment is ppD on ppP
-    // shift only in the Z direction
-    // the averaging is only for 3D simulations
-    P1.ix   = 0;
-    P1.iy   = 0;
-    P1.iz   = 0;
-    P1.coef = (nbdims_ == 3) ? 0.5 : 1;
-    EzToMoment_.push_back(P1);
+    BxToEy_ = linearCombination<typename Stencils::BxToEy>();
+    BxToEz_ = linearCombination<typename Stencils::BxToEz>();
+    ByToEx_ = linearCombination<typename Stencils::ByToEx>();
+    ByToEz_ = linearCombination<typename Stencils::ByToEz>();
+    BzToEx_ = linearCombination<typename Stencils::BzToEx>();
+    BzToEy_ = linearCombination<typename Stencils::BzToEy>();
 
-    if (nbdims_ == 3)
-    {
-        P2.ix   = 0;
-        P2.iy   = 0;
-        P2.iz   = dualToPrimal;
-        P2.coef = 0.5;
-        EzToMoment_.push_back(P2);
-    }
+    ExToMoment_ = linearCombination<typename Stencils::ExToMoment>();
+    EyToMoment_ = linearCombination<typename Stencils::EyToMoment>();
+    EzToMoment_ = linearCombination<typename Stencils::EzToMoment>();
 }
 
 
@@ -443,6 +262,12 @@ QtyCentering GridLayoutImplYee::fieldCentering(Field const& field, Direction dir
 }
 
 
+QtyCentering GridLayoutImplYee::fieldCentering(HybridQuantity qty, Direction dir) const
+{
+    return fieldCentering_(qty, dir);
+}
+
+
 uint32 GridLayoutImplYee::nbrGhostNodes(QtyCentering centering) const
 {
     return nbrGhosts(centering);
@@ -499,6 +324,32 @@ void GridLayoutImplYee::deriv1D(Field const& operand, Field& derivative) const
 
 
 
+/**
+ * @brief GridLayoutImplYee::deriv2D computes the derivative of 'operand' in
+ * the direction X or Y on the entire physical domain, see deriv1D.
+ */
+void GridLayoutImplYee::deriv2D(Field const& operand, Direction direction,
+                                Field& derivative) const
+{
+    derivMultiD_(operand, direction, derivative);
+}
+
+
+
+
+/**
+ * @brief GridLayoutImplYee::deriv3D computes the derivative of 'operand' in
+ * the direction X, Y or Z on the entire physical domain, see deriv1D.
+ */
+void GridLayoutImplYee::deriv3D(Field const& operand, Direction direction,
+                                Field& derivative) const
+{
+    derivMultiD_(operand, direction, derivative);
+}
+
+
+
+
 LinearCombination const& GridLayoutImplYee::momentsToEx() const
 {
     return momentsToEx_;
@@ -34,6 +34,12 @@ private:
     void initLayoutCentering_(const gridDataT& staticData);
     void initLinearCombinations_();
 
+    template<uint32 Dim>
+    void initLinearCombinations_();
+
+    template<uint32 Dim, uint32 InterpOrder>
+    void initLinearCombinations_();
+
     LinearCombination momentsToEx_;
     LinearCombination momentsToEy_;
     LinearCombination momentsToEz_;
@@ -86,6 +92,10 @@ public:
 
 
     virtual void deriv1D(Field const& operand, Field& derivative) const override;
+    virtual void deriv2D(Field const& operand, Direction direction,
+                         Field& derivative) const override;
+    virtual void deriv3D(Field const& operand, Direction direction,
+                         Field& derivative) const override;
 
     virtual AllocSizeT allocSize(HybridQuantity qtyType) const override;
 
@@ -97,6 +107,7 @@ public:
     virtual Point cellCenteredCoordinates(uint32 ix, uint32 iy, uint32 iz) const override;
 
     virtual QtyCentering fieldCentering(Field const& field, Direction dir) const override;
+    virtual QtyCentering fieldCentering(HybridQuantity qty, Direction dir) const override;
 
     virtual uint32 nbrGhostNodes(QtyCentering centering) const override;
     virtual std::array<uint32, NBR_COMPO> nbrPhysicalNodes(Field const& field) const override;
@@ -0,0 +1,207 @@
+#ifndef GRIDROWS_H
+#define GRIDROWS_H
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+#include "data/Field/field.h"
+#include "data/grid/gridlayout.h"
+#include "utilities/types.h"
+
+
+
+/*
+ * Tools used by the 2D and 3D field operators (Faraday, Ampere, Ohm,
+ * Electrons) to work on rows of nodes.
+ *
+ * A row is a set of consecutive nodes along the last direction of the layout
+ * (Y in 2D, Z in 3D), which is the contiguous direction of the row-major
+ * storage of Field. The operators first gather their stencils and projections
+ * in row buffers, in loops on unit-stride data the compiler can vectorize, and
+ * then combine the buffers node by node.
+ */
+
+
+//! maximum number of nodes in a row, so that row buffers are small enough to live in L1
+static const uint32 rowTileSize = 128;
+
+//! number of rows in Y swept together in 3D, for Y neighbors to still be in cache
+static const uint32 planeTileSize = 8;
+
+
+
+/**
+ * @brief NodeRange is the inclusive range of node indexes of a quantity, in
+ * each direction. Invariant directions have the single index 0.
+ */
+struct NodeRange
+{
+    uint32 nbDims;
+    std::array<uint32, 3> start;
+    std::array<uint32, 3> end;
+};
+
+
+
+//! range of the physical nodes of 'qty'
+inline NodeRange physicalNodes(GridLayout const& layout, HybridQuantity qty)
+{
+    NodeRange range{layout.nbDimensions(), {{0, 0, 0}}, {{0, 0, 0}}};
+
+    for (uint32 iDim = 0; iDim < range.nbDims; ++iDim)
+    {
+        range.start[iDim] = layout.physicalStartIndex(qty, static_cast<Direction>(iDim));
+        range.end[iDim]   = layout.physicalEndIndex(qty, static_cast<Direction>(iDim));
+    }
+
+    return range;
+}
+
+
+
+/**
+ * @brief forEachRow calls rowFunction(ix, iy, iz, count) for all the rows of at
+ * most rowTileSize nodes of a 2D or 3D range, (ix, iy, iz) being the first node
+ * of the row.
+ *
+ * The rows are swept by tiles: in 2D, the X direction is swept for each chunk of
+ * the rows, so that the row at ix+1 used by X derivatives is still in cache. In
+ * 3D, the same is done with blocks of planeTileSize rows in Y.
+ */
+template<typename RowFunction>
+void forEachRow(NodeRange const& range, RowFunction rowFunction)
+{
+    if (range.nbDims == 2)
+    {
+        for (uint32 iy0 = range.start[1]; iy0 <= range.end[1]; iy0 += rowTileSize)
+        {
+            uint32 count = std::min(rowTileSize, range.end[1] - iy0 + 1);
+
+            for (uint32 ix = range.start[0]; ix <= range.end[0]; ++ix)
+            {
+                rowFunction(ix, iy0, 0u, count);
+            }
+        }
+    }
+    else if (range.nbDims == 3)
+    {
+        for (uint32 iz0 = range.start[2]; iz0 <= range.end[2]; iz0 += rowTileSize)
+        {
+            uint32 count = std::min(rowTileSize, range.end[2] - iz0 + 1);
+
+            for (uint32 iy0 = range.start[1]; iy0 <= range.end[1]; iy0 += planeTileSize)
+            {
+                uint32 iy1 = std::min(iy0 + planeTileSize - 1, range.end[1]);
+
+                for (uint32 ix = range.start[0]; ix <= range.end[0]; ++ix)
+                {
+                    for (uint32 iy = iy0; iy <= iy1; ++iy)
+                    {
+                        rowFunction(ix, iy, iz0, count);
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        throw std::runtime_error("Error - forEachRow only handles 2D and 3D ranges");
+    }
+}
+
+
+
+/**
+ * @brief projectRow computes the linear combination 'avgPoints' of 'field' for
+ * 'count' consecutive nodes of another quantity, starting at (ix, iy, iz).
+ *
+ * Each weight point adds a whole row to 'projection', the sum being done in the
+ * same order as a node by node evaluation of the linear combination.
+ */
+inline void projectRow(LinearCombination const& avgPoints, Field const& field, uint32 ix,
+                       uint32 iy, uint32 iz, uint32 count, double* projection)
+{
+    std::fill(projection, projection + count, 0.);
+
+    for (WeightPoint const& wp : avgPoints)
+    {
+        double const* nodes = &field(ix + wp.ix, iy + wp.iy, iz + wp.iz);
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            projection[i] += wp.coef * nodes[i];
+        }
+    }
+}
+
+
+
+/**
+ * @brief RowDerivative computes, by rows, the derivative of a quantity in a
+ * given direction on the nodes of its derivative, exactly as GridLayout::deriv
+ * does.
+ */
+class RowDerivative
+{
+private:
+    std::array<int32, 3> shift_{{0, 0, 0}}; // operand node minus derivative node
+    uint32 stride_      = 0;                // distance of operand nodes in the direction
+    double inverseStep_ = 0.;
+
+public:
+    RowDerivative() = default;
+
+    RowDerivative(GridLayout const& layout, HybridQuantity operand, Direction direction)
+    {
+        uint32 iDir = static_cast<uint32>(direction);
+
+        if (iDir >= layout.nbDimensions())
+            throw std::runtime_error("Error - RowDerivative in an invariant direction");
+
+        QtyCentering opCentering = layout.fieldCentering(operand, direction);
+        QtyCentering derCentering
+            = (opCentering == QtyCentering::primal) ? QtyCentering::dual : QtyCentering::primal;
+
+        shift_[iDir] = static_cast<int32>(layout.physicalStartIndex(opCentering, direction))
+                       - static_cast<int32>(layout.physicalStartIndex(derCentering, direction));
+
+        if (opCentering == QtyCentering::dual)
+        {
+            --shift_[iDir];
+        }
+
+        AllocSizeT allocSize = layout.allocSize(operand);
+        std::array<uint32, 3> strides{{allocSize.ny_ * allocSize.nz_, allocSize.nz_, 1}};
+
+        stride_ = strides[iDir];
+
+        switch (direction)
+        {
+            case Direction::X: inverseStep_ = layout.odx(); break;
+            case Direction::Y: inverseStep_ = layout.ody(); break;
+            case Direction::Z: inverseStep_ = layout.odz(); break;
+        }
+    }
+
+
+    //! derivative of 'operand' at 'count' consecutive derivative nodes from (ix, iy, iz)
+    void operator()(Field const& operand, uint32 ix, uint32 iy, uint32 iz, uint32 count,
+                    double* derivative) const
+    {
+        double const* lower = &operand(static_cast<uint32>(static_cast<int32>(ix) + shift_[0]),
+                                       static_cast<uint32>(static_cast<int32>(iy) + shift_[1]),
+                                       static_cast<uint32>(static_cast<int32>(iz) + shift_[2]));
+        double const* upper = lower + stride_;
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            derivative[i] = inverseStep_ * (upper[i] - lower[i]);
+        }
+    }
+};
+
+
+
+#endif // GRIDROWS_H
@@ -0,0 +1,144 @@
+#ifndef YEESTENCILS_H
+#define YEESTENCILS_H
+
+#include <type_traits>
+
+#include "data/grid/gridlayoutimpl.h"
+#include "utilities/types.h"
+
+
+
+/*
+ * Compile-time versions of the Yee projection stencils, i.e. the linear
+ * combinations of nodes that give a quantity on the nodes of another one.
+ *
+ * A stencil is a type with:
+ * - size, the number of nodes it combines,
+ * - ix(i), iy(i), iz(i), the shift of the node i,
+ * - coef(i), the weight of the node i.
+ *
+ * All of them are constant expressions, so that loops on the stencil nodes are
+ * unrolled and the shifts are folded in the kernel indexing.
+ */
+
+
+
+//! the quantity is already on the right node
+struct IdentityStencil
+{
+    static constexpr uint32 size = 1;
+
+    static constexpr int32 ix(uint32) { return 0; }
+    static constexpr int32 iy(uint32) { return 0; }
+    static constexpr int32 iz(uint32) { return 0; }
+    static constexpr double coef(uint32) { return 1.; }
+};
+
+
+
+//! average of the node and of its neighbor shifted by (Dx, Dy, Dz)
+template<int32 Dx, int32 Dy, int32 Dz>
+struct AverageStencil
+{
+    static constexpr uint32 size = 2;
+
+    static constexpr int32 ix(uint32 i) { return i == 0 ? 0 : Dx; }
+    static constexpr int32 iy(uint32 i) { return i == 0 ? 0 : Dy; }
+    static constexpr int32 iz(uint32 i) { return i == 0 ? 0 : Dz; }
+    static constexpr double coef(uint32) { return 0.5; }
+};
+
+
+
+//! the average in a direction only exists if the direction is not invariant
+template<bool averaged, int32 Dx, int32 Dy, int32 Dz>
+using AverageIfStencil =
+    typename std::conditional<averaged, AverageStencil<Dx, Dy, Dz>, IdentityStencil>::type;
+
+
+
+//! shift of the dual neighbor of a primal node, which depends on the interpolation order
+constexpr int32 yeePrimalToDual(uint32 interpOrder)
+{
+    return interpOrder == 3 ? -1 : 1;
+}
+
+
+
+/**
+ * @brief YeeStencils gathers the projections of the Yee layout in 'Dim'
+ * dimensions for the interpolation order 'InterpOrder'. Averages are only done
+ * in the directions that are not invariant.
+ *
+ * The nodes are listed in the same order as the LinearCombination getters of
+ * GridLayout, which are built from these stencils, so that sums done with
+ * either of them are the same, bit for bit.
+ */
+template<uint32 Dim, uint32 InterpOrder>
+struct YeeStencils
+{
+    static_assert(Dim >= 1 && Dim <= 3, "YeeStencils - dimension must be 1, 2 or 3");
+    static_assert(InterpOrder >= 1 && InterpOrder <= 4,
+                  "YeeStencils - interpolation order must be 1, 2, 3 or 4");
+
+    // moment to Ex is Ppp to Dpp, to Ey pPp to pDp, to Ez ppP to ppD
+    using MomentsToEx = AverageStencil<yeePrimalToDual(InterpOrder), 0, 0>;
+    using MomentsToEy = AverageIfStencil<(Dim >= 2), 0, yeePrimalToDual(InterpOrder), 0>;
+    using MomentsToEz = AverageIfStencil<(Dim == 3), 0, 0, yeePrimalToDual(InterpOrder)>;
+
+    // Bx to Ey is pdD to pdP, to Ez pDd to pPd
+    using BxToEy = AverageIfStencil<(Dim == 3), 0, 0, -yeePrimalToDual(InterpOrder)>;
+    using BxToEz = AverageIfStencil<(Dim >= 2), 0, -yeePrimalToDual(InterpOrder), 0>;
+
+    // By to Ex is dpD to dpP, to Ez Dpd to Ppd
+    using ByToEx = AverageIfStencil<(Dim == 3), 0, 0, -yeePrimalToDual(InterpOrder)>;
+    using ByToEz = AverageStencil<-yeePrimalToDual(InterpOrder), 0, 0>;
+
+    // Bz to Ex is dDp to dPp, to Ey Ddp to Pdp
+    using BzToEx = AverageIfStencil<(Dim >= 2), 0, -yeePrimalToDual(InterpOrder), 0>;
+    using BzToEy = AverageStencil<-yeePrimalToDual(InterpOrder), 0, 0>;
+
+    // Ex to moment is Dpp to Ppp, Ey pDp to pPp, Ez ppD to ppP
+    using ExToMoment = AverageStencil<-yeePrimalToDual(InterpOrder), 0, 0>;
+    using EyToMoment = AverageIfStencil<(Dim >= 2), 0, -yeePrimalToDual(InterpOrder), 0>;
+    using EzToMoment = AverageIfStencil<(Dim == 3), 0, 0, -yeePrimalToDual(InterpOrder)>;
+};
+
+
+
+/**
+ * @brief project computes the linear combination 'Stencil' of 'field' at the
+ * node (ix, iy, iz) of another quantity. 'field' is anything that can be called
+ * with three indexes, like a FieldView. The sum is done in the same order as
+ * the loops on a LinearCombination.
+ */
+template<typename Stencil, typename Accessor>
+double project(Accessor const& field, uint32 ix, uint32 iy = 0, uint32 iz = 0)
+{
+    double value = 0;
+    for (uint32 i = 0; i < Stencil::size; ++i)
+    {
+        value += Stencil::coef(i) * field(ix + Stencil::ix(i), iy + Stencil::iy(i),
+                                          iz + Stencil::iz(i));
+    }
+    return value;
+}
+
+
+
+//! the LinearCombination of the runtime GridLayout interface for 'Stencil'
+template<typename Stencil>
+LinearCombination linearCombination()
+{
+    LinearCombination points;
+    for (uint32 i = 0; i < Stencil::size; ++i)
+    {
+        points.push_back(WeightPoint{Stencil::ix(i), Stencil::iy(i), Stencil::iz(i),
+                                     Stencil::coef(i)});
+    }
+    return points;
+}
+
+
+
+#endif // YEESTENCILS_H
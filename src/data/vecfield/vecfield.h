@@ -16,6 +16,11 @@
 
 
 
+template<typename E>
+class FieldExpression;
+
+
+
 class VecField
 {
 private:
@@ -41,8 +46,7 @@ public:
 
 
     // I don't like calling 3 times shape()
-    // what's the return type of shape?
-    std::vector<uint32> shape() const { return xComponent_.shape(); }
+    std::array<uint32, 3> const& shape() const { return xComponent_.shape(); }
 
     std::string name() const { return name_; }
 
@@ -56,6 +60,10 @@ public:
     Field& component(uint32 iComp);
     const Field& component(uint32 iComp) const;
 
+    //! evaluate an arithmetic expression of VecFields, see vecfieldexpression.h
+    template<typename E>
+    VecField& operator=(FieldExpression<E> const& expression);
+
     void dotProduct(VecField const& v1, VecField const& v2, Field& v1dotv2);
 
     std::vector<std::reference_wrapper<Field>> components();
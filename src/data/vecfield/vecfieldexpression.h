@@ -0,0 +1,61 @@
+#ifndef VECFIELDEXPRESSION_H
+#define VECFIELDEXPRESSION_H
+
+#include <array>
+
+#include "data/Field/fieldexpression.h"
+#include "data/vecfield/vecfield.h"
+
+
+
+/*
+ * VecField support for the expression templates of fieldexpression.h. A
+ * VecField expression is evaluated component by component, each component
+ * being a Field expression evaluated in a single loop.
+ */
+
+
+
+//! leaf of the expression tree that refers to the components of a VecField
+class VecFieldTerm : public FieldExpression<VecFieldTerm>
+{
+private:
+    std::array<FieldTerm, 3> components_;
+
+public:
+    explicit VecFieldTerm(VecField const& vecField)
+        : components_{{FieldTerm{vecField.component(VecField::VecX)},
+                       FieldTerm{vecField.component(VecField::VecY)},
+                       FieldTerm{vecField.component(VecField::VecZ)}}}
+    {
+    }
+
+    FieldTerm component(uint32 iComp) const { return components_[iComp]; }
+};
+
+
+
+template<>
+struct ExpressionTerm<VecField>
+{
+    static const bool isOperand = true;
+    using type                  = VecFieldTerm;
+    static VecFieldTerm make(VecField const& vecField) { return VecFieldTerm{vecField}; }
+};
+
+
+
+template<typename E>
+VecField& VecField::operator=(FieldExpression<E> const& expression)
+{
+    for (uint32 iComp = 0; iComp < NBR_COMPO; ++iComp)
+    {
+        component(iComp) = expression.self().component(iComp);
+    }
+
+    return *this;
+}
+
+
+
+#endif // VECFIELDEXPRESSION_H
@@ -1,60 +1,24 @@
 
 #include "vecfieldoperations.h"
-#include <algorithm>
+#include "vecfieldexpression.h"
+
+
 
 void timeAverage(VecField const& vfAtTime1, VecField const& vfAtTime2, VecField& Vavg)
 {
-    for (uint32 iComponent = 0; iComponent < 3; ++iComponent)
-    {
-        // add vfAtTime1 and vfAtTime2 into Vavg
-        std::transform(vfAtTime1.component(iComponent).begin(),
-                       vfAtTime1.component(iComponent).end(),
-                       vfAtTime2.component(iComponent).begin(), Vavg.component(iComponent).begin(),
-                       std::plus<double>());
-
-        // Vavg *= 0.5
-        std::transform(Vavg.component(iComponent).begin(), Vavg.component(iComponent).end(),
-                       Vavg.component(iComponent).begin(), [](double x) { return x * 0.5; });
-    }
+    Vavg = (vfAtTime1 + vfAtTime2) * 0.5;
 }
 
 
 void getVariation(VecField const& vfAtT1, VecField const& vfAtT2, VecField& variation, double dt2t1)
 {
-    for (uint32 iComponent = 0; iComponent < 3; ++iComponent)
-    {
-        // vfAtT2 - vfAtT1
-        std::transform(vfAtT2.component(iComponent).begin(), vfAtT2.component(iComponent).end(),
-                       vfAtT1.component(iComponent).begin(),
-                       variation.component(iComponent).begin(), std::minus<double>());
-
-        // (vfAtT2 - vfAtT1)/(t2 - t1)
-        std::transform(
-            variation.component(iComponent).begin(), variation.component(iComponent).end(),
-            variation.component(iComponent).begin(), [&](double x) { return x / dt2t1; });
-    }
+    variation = (vfAtT2 - vfAtT1) / dt2t1;
 }
 
 
 void timeInterpolation(VecField const& vfAtT1, VecField const& vfAtT2, VecField& interpolated,
                        double dt2t1, double delta)
 {
-    // dF/dt
-    VecField timeVariation = vfAtT1; // dummy initialization
-
-    // compute dF/dt
-    getVariation(vfAtT1, vfAtT2, timeVariation, dt2t1);
-
-    for (uint32 iComponent = 0; iComponent < 3; ++iComponent)
-    {
-        // varprime =  delta * dF/dt
-        std::transform(
-            timeVariation.component(iComponent).begin(), timeVariation.component(iComponent).end(),
-            timeVariation.component(iComponent).begin(), [&](double x) { return x * delta; });
-
-        // vfInterp = vfAtT1 + varprime
-        std::transform(vfAtT1.component(iComponent).begin(), vfAtT1.component(iComponent).end(),
-                       timeVariation.component(iComponent).begin(),
-                       interpolated.component(iComponent).begin(), std::plus<double>());
-    }
+    // vfAtT1 + delta * dF/dt
+    interpolated = vfAtT1 + (vfAtT2 - vfAtT1) / dt2t1 * delta;
 }
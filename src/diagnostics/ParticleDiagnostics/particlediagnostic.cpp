@@ -42,8 +42,8 @@ ParticlePack ParticleDiagnostic::compute_(Patch const& patch)
     ParticlePack pack;
 
     PatchData const& patchData             = patch.data();
-    std::vector<Particle> const& particles = patchData.ions().species(speciesName_).particles();
-    GridLayout const& layout               = patch.layout();
+    ParticleArray const& particles = patchData.ions().species(speciesName_).particles();
+    GridLayout const& layout       = patch.layout();
 
     std::vector<Particle> selectedParticles;
     for (Particle const& part : particles)
@@ -44,6 +44,7 @@ std::unique_ptr<IonsInitializer> AsciiInitializerFactory::createIonsInitializer(
     ionInitPtr->nbrSpecies           = iniData_.nbrSpecies;
     ionInitPtr->masses               = iniData_.speciesMasses;
     ionInitPtr->names                = iniData_.speciesNames;
+    ionInitPtr->pushIntervals        = iniData_.speciesPushIntervals;
     ionInitPtr->particleInitializers = initModel_->particleInitializers();
 
     return ionInitPtr;
@@ -72,6 +73,12 @@ std::unique_ptr<SolverInitializer> AsciiInitializerFactory::createSolverInitiali
 
     solverInitPtr->pusherType         = iniData_.pusherName;
     solverInitPtr->interpolationOrder = iniData_.interpOrder;
+    solverInitPtr->sortEvery          = iniData_.sortEvery;
+    solverInitPtr->sortThreshold      = iniData_.sortThreshold;
+    solverInitPtr->fieldSubcycles     = iniData_.fieldSubcycles;
+    solverInitPtr->predictorChunkSize = iniData_.predictorChunkSize;
+    solverInitPtr->solverType         = iniData_.solverType;
+    solverInitPtr->fieldSolve         = iniData_.fieldSolve;
 
     return solverInitPtr;
 }
@@ -185,6 +192,12 @@ std::unique_ptr<MLMDInitializer> AsciiInitializerFactory::createMLMDInitializer(
     patchInfos.splitStrategies = splittingStrategies();
     patchInfos.refinementRatio = 2;
     patchInfos.userTimeStep    = timeStep();
+    patchInfos.sortEvery          = iniData_.sortEvery;
+    patchInfos.sortThreshold      = iniData_.sortThreshold;
+    patchInfos.fieldSubcycles     = iniData_.fieldSubcycles;
+    patchInfos.predictorChunkSize = iniData_.predictorChunkSize;
+    patchInfos.solverType         = iniData_.solverType;
+    patchInfos.fieldSolve         = iniData_.fieldSolve;
 
     MLMDInfos mlmdInfos;
     MLMDIniData const& mlmdini = iniData_.mlmdIniData;
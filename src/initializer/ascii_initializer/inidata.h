@@ -79,11 +79,13 @@ public:
                 auto mass         = reader.GetReal("model", "mass" + indexStr, 1);
                 auto charge       = reader.GetReal("model", "charge" + indexStr, 1);
                 auto nbrParticles = reader.GetInteger("model", "nbrParticlesPerCell" + indexStr, 1);
+                auto pushInterval = reader.GetInteger("model", "pushInterval" + indexStr, 1);
                 auto name = reader.Get("model", "speciesName" + indexStr, "NO_NAME" + indexStr);
                 speciesMasses.push_back(mass);
                 speciesCharges.push_back(charge);
                 nbrParticlesPerCell.push_back(static_cast<uint32>(nbrParticles));
                 speciesNames.push_back(std::move(name));
+                speciesPushIntervals.push_back(static_cast<uint32>(pushInterval));
             }
 
             boundaryConditionX = reader.Get("simulation", "boundaryconditionx", "periodic");
@@ -100,6 +102,18 @@ public:
 
             splittingMethod = reader.Get("simulation", "splittingMethod", "splitOrderN_RF2");
 
+            sortEvery     = static_cast<uint32>(reader.GetInteger("simulation", "sortEvery", 0));
+            sortThreshold = reader.GetReal("simulation", "sortThreshold", 0.);
+
+            fieldSubcycles
+                = static_cast<uint32>(reader.GetInteger("simulation", "fieldSubcycles", 1));
+
+            predictorChunkSize = static_cast<uint32>(
+                reader.GetInteger("simulation", "predictorChunkSize", 131072));
+
+            solverType = reader.Get("simulation", "solverType", "PPC");
+            fieldSolve = reader.Get("simulation", "fieldSolve", "explicit");
+
             ndims = 3;
             if (nbrCellz == 0)
             {
@@ -197,9 +211,16 @@ public:
     std::string layoutType;
     uint32 nbrSpecies;
     std::string splittingMethod;
+    uint32 sortEvery;
+    double sortThreshold;
+    uint32 fieldSubcycles;
+    uint32 predictorChunkSize;
+    std::string solverType;
+    std::string fieldSolve;
     std::vector<std::string> speciesNames;
     std::vector<double> speciesMasses;
     std::vector<double> speciesCharges;
+    std::vector<uint32> speciesPushIntervals;
     std::vector<uint32> nbrParticlesPerCell;
     std::string modelName;
     double dt;
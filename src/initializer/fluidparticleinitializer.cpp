@@ -42,7 +42,7 @@ void maxwellianVelocity(std::array<double, 3> V, std::array<double, 3> Vth,
 
 
 
-void FluidParticleInitializer::loadParticles1D_(std::vector<Particle>& particles) const
+void FluidParticleInitializer::loadParticles1D_(ParticleArray& particles) const
 {
     Logger::Debug << "\t - 1D Fluid Particle Initializer\n";
     double dx;
@@ -123,7 +123,7 @@ void FluidParticleInitializer::loadParticles1D_(std::vector<Particle>& particles
 
 
 
-void FluidParticleInitializer::loadParticles2D_(std::vector<Particle>& particles) const
+void FluidParticleInitializer::loadParticles2D_(ParticleArray& particles) const
 {
     Logger::Debug << "\t - 2D Fluid Particle Initializer\n";
     double dx, dy;
@@ -214,7 +214,7 @@ void FluidParticleInitializer::loadParticles2D_(std::vector<Particle>& particles
 
 
 
-void FluidParticleInitializer::loadParticles3D_(std::vector<Particle>& particles) const
+void FluidParticleInitializer::loadParticles3D_(ParticleArray& particles) const
 {
     Logger::Debug << "\t - 3D Fluid Particle Initializer\n";
     double dx, dy, dz;
@@ -318,7 +318,7 @@ void FluidParticleInitializer::loadParticles3D_(std::vector<Particle>& particles
  * Maxwellian distirbution function
  * @param particles is the vector that will be filled with particles
  */
-void FluidParticleInitializer::loadParticles(std::vector<Particle>& particles) const
+void FluidParticleInitializer::loadParticles(ParticleArray& particles) const
 {
     switch (layout_.nbDimensions())
     {
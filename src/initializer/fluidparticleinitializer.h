@@ -27,9 +27,9 @@ private:
     Basis base_;
 
 
-    void loadParticles1D_(std::vector<Particle>& particles) const;
-    void loadParticles2D_(std::vector<Particle>& particles) const;
-    void loadParticles3D_(std::vector<Particle>& particles) const;
+    void loadParticles1D_(ParticleArray& particles) const;
+    void loadParticles2D_(ParticleArray& particles) const;
+    void loadParticles3D_(ParticleArray& particles) const;
 
 public:
     FluidParticleInitializer(GridLayout const& layout,
@@ -40,7 +40,7 @@ public:
                              Basis base                                    = Basis::Cartesian,
                              std::unique_ptr<VectorFunction> magneticField = nullptr);
 
-    virtual void loadParticles(std::vector<Particle>& particles) const override;
+    virtual void loadParticles(ParticleArray& particles) const override;
 
     virtual ~FluidParticleInitializer();
 };
@@ -20,6 +20,16 @@ static const uint32 interpOrderConstant = 2;
 
 static const std::string defaultSplitMethod = "splitOrderN_RF2";
 
+static const uint32 sortEveryConstant     = 0;
+static const double sortThresholdConstant = 0.;
+
+static const uint32 fieldSubcyclesConstant = 1;
+
+static const uint32 predictorChunkSizeConstant = 131072;
+
+static const std::string solverTypeConstant = "PPC";
+static const std::string fieldSolveConstant = "explicit";
+
 static const double pi = 3.14159;
 
 static const double dx = 0.2;
@@ -166,6 +176,7 @@ std::unique_ptr<IonsInitializer> SimpleInitializerFactory::createIonsInitializer
     ionInitPtr->masses.push_back(1.);
     // ionInitPtr->masses.push_back(1.);
     ionInitPtr->names.push_back("proton1");
+    ionInitPtr->pushIntervals.push_back(1);
     // ionInitPtr->names.push_back("proton2");
 
     std::unique_ptr<ScalarFunction> density{new Density{}};
@@ -198,6 +209,12 @@ std::unique_ptr<SolverInitializer> SimpleInitializerFactory::createSolverInitial
 
     solverInitPtr->pusherType         = pusher_;
     solverInitPtr->interpolationOrder = interpolationOrder_;
+    solverInitPtr->sortEvery          = sortEveryConstant;
+    solverInitPtr->sortThreshold      = sortThresholdConstant;
+    solverInitPtr->fieldSubcycles     = fieldSubcyclesConstant;
+    solverInitPtr->predictorChunkSize = predictorChunkSizeConstant;
+    solverInitPtr->solverType         = solverTypeConstant;
+    solverInitPtr->fieldSolve         = fieldSolveConstant;
 
     return solverInitPtr;
 }
@@ -329,6 +346,12 @@ std::unique_ptr<MLMDInitializer> SimpleInitializerFactory::createMLMDInitializer
     patchInfos.splitStrategies = splittingStrategies();
     patchInfos.refinementRatio = 2;
     patchInfos.userTimeStep    = timeStep();
+    patchInfos.sortEvery          = sortEveryConstant;
+    patchInfos.sortThreshold      = sortThresholdConstant;
+    patchInfos.fieldSubcycles     = fieldSubcyclesConstant;
+    patchInfos.predictorChunkSize = predictorChunkSizeConstant;
+    patchInfos.solverType         = solverTypeConstant;
+    patchInfos.fieldSolve         = fieldSolveConstant;
 
     mlmdInfos.minRatio = 0.4;
     mlmdInfos.maxRatio = 0.6;
@@ -20,6 +20,28 @@ struct SolverInitializer
 {
     std::string pusherType;
     uint32 interpolationOrder;
+
+    // particles are sorted by cell every 'sortEvery' steps (never if 0)
+    // or when their disorder exceeds 'sortThreshold' (never if 0)
+    uint32 sortEvery;
+    double sortThreshold;
+
+    // number of field substeps per particle step (no subcycling if 1)
+    uint32 fieldSubcycles;
+
+    // number of particles pushed at a time at the first predictor step, a
+    // multiple of Pusher::chunkSize. A chunk is pushed by at most
+    // predictorChunkSize / Pusher::chunkSize threads and deposited by at most
+    // DepositBuffer::nbrSlabs threads. Smaller chunks stay in a faster cache
+    // level but leave threads idle. The default, 131072, gives 32 pushing
+    // threads and all the deposit slabs, for about 8 MB of particles.
+    uint32 predictorChunkSize;
+
+    // time integration scheme: "PPC" or "momentExtrapolation"
+    std::string solverType;
+
+    // "explicit" or "semiImplicit" for an implicit Hall term in Faraday's law
+    std::string fieldSolve;
 };
 
 
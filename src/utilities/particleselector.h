@@ -29,6 +29,13 @@ public:
     virtual bool pick(Particle const& particle, GridLayout const& layout) const = 0;
     virtual std::string name() const = 0;
 
+    //! gives a box out of which no particle is picked, if the selector has one
+    virtual bool boundingBox(Box& box) const
+    {
+        (void)box;
+        return false;
+    }
+
     virtual ~ParticleSelector() = default;
 };
 
@@ -64,6 +71,12 @@ public:
         return pointInBox(particlePosition, targetBox_);
     }
 
+    virtual bool boundingBox(Box& box) const override
+    {
+        box = targetBox_;
+        return true;
+    }
+
 
     virtual ~IsInBoxSelector() {}
 };
@@ -49,42 +49,19 @@ Point getParticlePosition(Particle const& part, Point const& origin, int32 nbrGh
 /**
  * @brief removeParticles
  * All particles indexed in leavingIndexes are removed from
- * particleArray
+ * particleArray, in a single pass over the particles.
+ * leavingIndexes may be unsorted and contain duplicates, it is sorted and
+ * deduplicated in place so that callers can keep it as a buffer.
  */
-void removeParticles(std::vector<uint32> leavingIndexes, std::vector<Particle>& particleArray)
+void removeParticles(std::vector<uint32>& leavingIndexes, ParticleArray& particleArray)
 {
-    auto size = particleArray.size();
+    std::sort(leavingIndexes.begin(), leavingIndexes.end());
 
-    /* The idea of the algorithm is to loop over the leaving indexes
-    * and swap each leaving particle with the last one of the particle array
-    * if the last particle is also one to be moved then update the index list
-    * with its new location in the particle array*/
+    // a particle leaving through several boundaries is indexed several times
+    auto last = std::unique(leavingIndexes.begin(), leavingIndexes.end());
+    leavingIndexes.erase(last, leavingIndexes.end());
 
-    for (std::size_t iLeav = 0; iLeav < leavingIndexes.size(); ++iLeav)
-    {
-        // swap the leaving particle with the last one of the array
-        // remove the last element of the array
-        // decrement its size by one.
-        particleArray[leavingIndexes[iLeav]] = particleArray[size - 1];
-        particleArray.pop_back();
-        size--;
-
-        // the particle at position 'size' has been moved to position
-        // leavingIndexes[iLeav]
-        // if its former index (size) was in leavingIndexes
-        // then leavingIndexes has to be updated to the new location
-        // for the particle to be removed.
-        auto it = std::find(leavingIndexes.begin(), leavingIndexes.end(), size);
-        if (it != leavingIndexes.end())
-        {
-            *it = leavingIndexes[iLeav];
-
-            // we have to maintain the index array sorted
-            // but only have to sort the part over which we have not looped yet
-            std::sort(leavingIndexes.begin() + static_cast<long int>(iLeav) + 1,
-                      leavingIndexes.end());
-        }
-    }
+    particleArray.remove(leavingIndexes);
 }
 
 
@@ -3,7 +3,7 @@
 
 #include "types.h"
 
-#include "data/Plasmas/particles.h"
+#include "data/Plasmas/particlearray.h"
 #include "data/grid/gridlayout.h"
 
 
@@ -16,6 +16,6 @@ Point getParticlePosition(Particle const& part, Point const& origin, int32 nbrGh
 void particleChangeLayout(GridLayout const& praLayout, GridLayout const& patchLayout,
                           Particle const& part, Particle& newPart);
 
-void removeParticles(std::vector<uint32> leavingIndexes, std::vector<Particle>& particleArray);
+void removeParticles(std::vector<uint32>& leavingIndexes, ParticleArray& particleArray);
 
 #endif // PARTICLETESTS_H
@@ -3,6 +3,7 @@
 
 #include <array>
 #include <cinttypes>
+#include <stdexcept>
 
 using uint32 = std::uint32_t;
 using uint64 = std::uint64_t;
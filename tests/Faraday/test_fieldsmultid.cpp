@@ -0,0 +1,230 @@
+
+#include <array>
+#include <vector>
+
+#include "core/Ampere/ampere.h"
+#include "core/Faraday/faraday.h"
+#include "core/Ohm/ohm.h"
+#include "data/Plasmas/electrons.h"
+#include "data/grid/gridrows.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+
+
+// the 2D and 3D field operators on fields with known curls and cross products.
+// The layouts have more nodes than rowTileSize in the contiguous direction so
+// that rows are split.
+class FieldsMultiDTest : public ::testing::TestWithParam<uint32>
+{
+public:
+    double dt = 0.01;
+    GridLayout layout;
+
+    FieldsMultiDTest()
+        : layout{GetParam() == 2
+                     ? GridLayout{{{0.1, 0.2, 0.}}, {{20, 300, 0}}, 2, "yee", Point{0., 0., 0.}, 1}
+                     : GridLayout{{{0.1, 0.2, 0.3}}, {{12, 14, 150}}, 3, "yee",
+                                  Point{0., 0., 0.}, 1}}
+    {
+    }
+
+
+    VecField makeVecField(std::array<HybridQuantity, 3> qties, std::string name) const
+    {
+        return VecField{layout.allocSize(qties[0]), layout.allocSize(qties[1]),
+                        layout.allocSize(qties[2]), qties, name};
+    }
+
+    VecField makeE(std::string name) const
+    {
+        return makeVecField({{HybridQuantity::Ex, HybridQuantity::Ey, HybridQuantity::Ez}}, name);
+    }
+
+    VecField makeB(std::string name) const
+    {
+        return makeVecField({{HybridQuantity::Bx, HybridQuantity::By, HybridQuantity::Bz}}, name);
+    }
+
+    VecField makeV(std::string name) const
+    {
+        return makeVecField({{HybridQuantity::V, HybridQuantity::V, HybridQuantity::V}}, name);
+    }
+
+
+    // coordinate of the node 'index' of 'qty' in the direction 'iDir'
+    double coordinate(HybridQuantity qty, uint32 iDir, uint32 index) const
+    {
+        Direction dir = static_cast<Direction>(iDir);
+        double half   = layout.fieldCentering(qty, dir) == QtyCentering::dual ? 0.5 : 0.;
+        int32 shift   = static_cast<int32>(index)
+                      - static_cast<int32>(layout.physicalStartIndex(qty, dir));
+
+        return (shift + half) * layout.dxdydz()[iDir];
+    }
+
+
+    // fill all the nodes of 'field' with sum_i slopes[i] * x_i
+    void fillLinear(Field& field, std::array<double, 3> slopes) const
+    {
+        std::array<uint32, 3> const& shape = field.shape();
+
+        for (uint32 ix = 0; ix < shape[0]; ++ix)
+            for (uint32 iy = 0; iy < shape[1]; ++iy)
+                for (uint32 iz = 0; iz < shape[2]; ++iz)
+                {
+                    std::array<uint32, 3> index{{ix, iy, iz}};
+                    double value = 0.;
+                    for (uint32 iDim = 0; iDim < layout.nbDimensions(); ++iDim)
+                    {
+                        value += slopes[iDim] * coordinate(field.hybridQty(), iDim, index[iDim]);
+                    }
+                    field(ix, iy, iz) = value;
+                }
+    }
+
+
+    void fillUniform(Field& field, double value) const
+    {
+        for (double& node : field)
+            node = value;
+    }
+
+
+    // check that the physical nodes of 'field' are 'expected'
+    void expectPhysicalNodes(Field const& field, double expected) const
+    {
+        forEachRow(physicalNodes(layout, field.hybridQty()),
+                   [&](uint32 ix, uint32 iy, uint32 iz, uint32 count) {
+                       double const* values = &field(ix, iy, iz);
+                       for (uint32 i = 0; i < count; ++i)
+                       {
+                           EXPECT_NEAR(expected, values[i], 1e-10);
+                       }
+                   });
+    }
+
+
+    // gradients of the linear fields: component, then direction
+    std::array<std::array<double, 3>, 3> slopes{
+        {{{0., 0.7, -1.1}}, {{1.3, 0., 0.4}}, {{-0.6, 1.9, 0.}}}};
+
+    // curl of a linear field of gradients 'slopes'
+    std::array<double, 3> curl() const
+    {
+        return {{slopes[2][1] - slopes[1][2], slopes[0][2] - slopes[2][0],
+                 slopes[1][0] - slopes[0][1]}};
+    }
+};
+
+
+
+
+TEST_P(FieldsMultiDTest, faradayAdvancesBWithTheCurlOfE)
+{
+    VecField E    = makeE("E");
+    VecField B    = makeB("B");
+    VecField Bnew = makeB("Bnew");
+
+    std::array<double, 3> B0{{0.5, -0.2, 1.}};
+
+    for (uint32 iComp = 0; iComp < 3; ++iComp)
+    {
+        fillLinear(E.component(iComp), slopes[iComp]);
+        fillUniform(B.component(iComp), B0[iComp]);
+    }
+
+    // Z derivatives are zero in 2D
+    if (layout.nbDimensions() == 2)
+    {
+        for (uint32 iComp = 0; iComp < 3; ++iComp)
+            slopes[iComp][2] = 0.;
+    }
+
+    Faraday faraday{dt, layout};
+    faraday(E, B, Bnew);
+
+    std::array<double, 3> curlE = curl();
+    for (uint32 iComp = 0; iComp < 3; ++iComp)
+    {
+        expectPhysicalNodes(Bnew.component(iComp), B0[iComp] - dt * curlE[iComp]);
+    }
+}
+
+
+
+
+TEST_P(FieldsMultiDTest, ampereComputesTheCurlOfB)
+{
+    VecField B = makeB("B");
+    VecField J = makeE("J");
+
+    for (uint32 iComp = 0; iComp < 3; ++iComp)
+    {
+        fillLinear(B.component(iComp), slopes[iComp]);
+    }
+
+    if (layout.nbDimensions() == 2)
+    {
+        for (uint32 iComp = 0; iComp < 3; ++iComp)
+            slopes[iComp][2] = 0.;
+    }
+
+    Ampere ampere{layout};
+    ampere(B, J);
+
+    std::array<double, 3> curlB = curl();
+    for (uint32 iComp = 0; iComp < 3; ++iComp)
+    {
+        expectPhysicalNodes(J.component(iComp), curlB[iComp]);
+    }
+}
+
+
+
+
+TEST_P(FieldsMultiDTest, electronsAndOhmGiveMinusVeCrossB)
+{
+    VecField B  = makeB("B");
+    VecField J  = makeE("J");
+    VecField Vi = makeV("Vi");
+    VecField E  = makeE("E");
+    Field Ni{layout.allocSize(HybridQuantity::rho), HybridQuantity::rho, "Ni"};
+
+    std::array<double, 3> B0{{0.5, -0.2, 1.}};
+    std::array<double, 3> V0{{0.3, 1.2, -0.8}};
+    std::array<double, 3> J0{{-0.4, 0.1, 0.6}};
+    double N0 = 2.;
+
+    for (uint32 iComp = 0; iComp < 3; ++iComp)
+    {
+        fillUniform(B.component(iComp), B0[iComp]);
+        fillUniform(J.component(iComp), J0[iComp]);
+        fillUniform(Vi.component(iComp), V0[iComp]);
+    }
+    fillUniform(Ni, N0);
+
+    Electrons electrons{layout, 0.1};
+    Ohm ohm{layout};
+
+    VecField const& Ve = electrons.bulkVel(Vi, Ni, J);
+    Field const& Pe    = electrons.pressure(Ni);
+
+    std::array<double, 3> Ve0;
+    for (uint32 iComp = 0; iComp < 3; ++iComp)
+    {
+        Ve0[iComp] = V0[iComp] - J0[iComp] / N0;
+        expectPhysicalNodes(Ve.component(iComp), Ve0[iComp]);
+    }
+
+    ohm(B, Ni, Ve, Pe, J, E);
+
+    expectPhysicalNodes(E.component(VecField::VecX), -(Ve0[1] * B0[2] - Ve0[2] * B0[1]));
+    expectPhysicalNodes(E.component(VecField::VecY), -(Ve0[2] * B0[0] - Ve0[0] * B0[2]));
+    expectPhysicalNodes(E.component(VecField::VecZ), -(Ve0[0] * B0[1] - Ve0[1] * B0[0]));
+}
+
+
+
+INSTANTIATE_TEST_CASE_P(FieldsMultiDTests, FieldsMultiDTest, ::testing::Values(2u, 3u));
@@ -0,0 +1,162 @@
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "core/Ampere/ampere.h"
+#include "core/Faraday/faraday.h"
+#include "core/Ohm/ohm.h"
+#include "core/Solver/fieldsolver1d.h"
+#include "data/Plasmas/electrons.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+
+
+// the fused 1D field stages must reproduce Faraday, Ampere, Electrons and Ohm
+// exactly, ghost nodes included, since the solver uses one or the other.
+class FieldSolver1DTest : public ::testing::Test
+{
+public:
+    double dt = 0.01;
+    GridLayout layout{{{0.1, 0., 0.}}, {{50, 0, 0}}, 1, "yee", Point{0., 0., 0.}, 1};
+
+    VecField E{layout.allocSize(HybridQuantity::Ex), layout.allocSize(HybridQuantity::Ey),
+               layout.allocSize(HybridQuantity::Ez),
+               {{HybridQuantity::Ex, HybridQuantity::Ey, HybridQuantity::Ez}}, "E"};
+
+    VecField B{layout.allocSize(HybridQuantity::Bx), layout.allocSize(HybridQuantity::By),
+               layout.allocSize(HybridQuantity::Bz),
+               {{HybridQuantity::Bx, HybridQuantity::By, HybridQuantity::Bz}}, "B"};
+
+    VecField Vi{layout.allocSize(HybridQuantity::V), layout.allocSize(HybridQuantity::V),
+                layout.allocSize(HybridQuantity::V),
+                {{HybridQuantity::V, HybridQuantity::V, HybridQuantity::V}}, "Vi"};
+
+    Field Ni{layout.allocSize(HybridQuantity::rho), HybridQuantity::rho, "Ni"};
+
+    FieldSolver1D fieldSolver{dt, layout};
+
+    FieldSolver1DTest()
+    {
+        std::mt19937 generator{42};
+        std::uniform_real_distribution<double> field{-2., 2.};
+        std::uniform_real_distribution<double> density{0.5, 2.};
+
+        for (uint32 iComp = 0; iComp < 3; ++iComp)
+        {
+            for (double& value : E.component(iComp))
+                value = field(generator);
+            for (double& value : B.component(iComp))
+                value = field(generator);
+            for (double& value : Vi.component(iComp))
+                value = field(generator);
+        }
+
+        for (double& value : Ni)
+            value = density(generator);
+    }
+
+
+    VecField makeE(std::string name) const
+    {
+        return VecField{layout.allocSize(HybridQuantity::Ex), layout.allocSize(HybridQuantity::Ey),
+                        layout.allocSize(HybridQuantity::Ez),
+                        {{HybridQuantity::Ex, HybridQuantity::Ey, HybridQuantity::Ez}}, name};
+    }
+
+
+    VecField makeB(std::string name) const
+    {
+        return VecField{layout.allocSize(HybridQuantity::Bx), layout.allocSize(HybridQuantity::By),
+                        layout.allocSize(HybridQuantity::Bz),
+                        {{HybridQuantity::Bx, HybridQuantity::By, HybridQuantity::Bz}}, name};
+    }
+
+
+    static void expectEqual(VecField const& actual, VecField const& expected)
+    {
+        for (uint32 iComp = 0; iComp < 3; ++iComp)
+        {
+            Field const& actualComp   = actual.component(iComp);
+            Field const& expectedComp = expected.component(iComp);
+
+            EXPECT_THAT(std::vector<double>(actualComp.begin(), actualComp.end()),
+                        ::testing::ContainerEq(
+                            std::vector<double>(expectedComp.begin(), expectedComp.end())));
+        }
+    }
+};
+
+
+
+
+TEST_F(FieldSolver1DTest, faradayMatchesFaraday)
+{
+    VecField expected = makeB("expected");
+    VecField actual   = makeB("actual");
+
+    Faraday faraday{dt, layout};
+    faraday(E, B, expected);
+    fieldSolver.faraday(E, B, actual);
+
+    expectEqual(actual, expected);
+}
+
+
+
+
+TEST_F(FieldSolver1DTest, faradayCanUpdateBInPlace)
+{
+    // the ghost nodes are not written, they keep their values of B
+    VecField expected = B;
+
+    Faraday faraday{dt, layout};
+    faraday(E, B, expected);
+    fieldSolver.faraday(E, B, B);
+
+    expectEqual(B, expected);
+}
+
+
+
+
+TEST_F(FieldSolver1DTest, ampereMatchesAmpere)
+{
+    VecField expected = makeE("expected");
+    VecField actual   = makeE("actual");
+
+    Ampere ampere{layout};
+    ampere(B, expected);
+    fieldSolver.ampere(B, actual);
+
+    expectEqual(actual, expected);
+}
+
+
+
+
+TEST_F(FieldSolver1DTest, ohmMatchesElectronsAndOhm)
+{
+    VecField J        = makeE("J");
+    VecField expected = makeE("expected");
+    VecField actual   = makeE("actual");
+
+    for (uint32 iComp = 0; iComp < 3; ++iComp)
+    {
+        Field const& Ecomp = E.component(iComp);
+        std::copy(Ecomp.begin(), Ecomp.end(), J.component(iComp).begin());
+    }
+
+    Electrons electrons{layout, 0.1};
+    Ohm ohm{layout};
+
+    VecField const& Ve = electrons.bulkVel(Vi, Ni, J);
+    Field const& Pe    = electrons.pressure(Ni);
+    ohm(B, Ni, Ve, Pe, J, expected);
+
+    fieldSolver.ohm(B, Ni, Vi, J, actual);
+
+    expectEqual(actual, expected);
+}
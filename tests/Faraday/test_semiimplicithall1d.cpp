@@ -0,0 +1,193 @@
+
+
+#include <complex>
+#include <random>
+#include <vector>
+
+#include "core/BoundaryConditions/domainboundarycondition.h"
+#include "core/Solver/semiimplicithall1d.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+
+
+// whatever the field whose Hall term was used in the explicit step, the
+// semi-implicit solve must advance the Hall term with Crank-Nicolson, that is
+// dP = -i dt D (P + dP / 2) with P = By + i Bz, see SemiImplicitHall1D.
+class SemiImplicitHall1DTest : public ::testing::Test
+{
+public:
+    double dt = 0.01;
+    GridLayout layout{{{0.1, 0., 0.}}, {{50, 0, 0}}, 1, "yee", Point{0., 0., 0.}, 1};
+
+    VecField B     = makeB("B");
+    VecField Bhall = makeB("Bhall");
+    Field Ni{layout.allocSize(HybridQuantity::rho), HybridQuantity::rho, "Ni"};
+
+    std::unique_ptr<BoundaryCondition> periodicBC;
+
+    uint32 dualStart   = layout.physicalStartIndex(HybridQuantity::By, Direction::X);
+    uint32 dualEnd     = layout.physicalEndIndex(HybridQuantity::By, Direction::X);
+    uint32 primalStart = layout.physicalStartIndex(HybridQuantity::rho, Direction::X);
+    uint32 nbrNodes    = dualEnd - dualStart + 1;
+
+    SemiImplicitHall1D semiImplicitHall{dt, layout};
+
+    SemiImplicitHall1DTest()
+    {
+        std::vector<DomainBoundaryCondition::BoundaryInfo> boundaries(2);
+        boundaries[0].first  = Edge::Xmin;
+        boundaries[1].first  = Edge::Xmax;
+        boundaries[0].second = BoundaryType::Periodic;
+        boundaries[1].second = BoundaryType::Periodic;
+        periodicBC.reset(new DomainBoundaryCondition{layout, boundaries});
+
+        std::mt19937 generator{42};
+        std::uniform_real_distribution<double> field{-2., 2.};
+        std::uniform_real_distribution<double> density{0.5, 2.};
+
+        for (uint32 iComp = 1; iComp < 3; ++iComp)
+        {
+            for (double& value : B.component(iComp))
+                value = field(generator);
+            for (double& value : Bhall.component(iComp))
+                value = field(generator);
+        }
+
+        for (double& value : B.component(VecField::VecX))
+            value = 1.;
+        for (double& value : Bhall.component(VecField::VecX))
+            value = 1.;
+
+        for (double& value : Ni)
+            value = density(generator);
+
+        // the first and last primal nodes are the same on a periodic domain
+        Ni(primalStart + nbrNodes) = Ni(primalStart);
+
+        periodicBC->applyMagneticBC(B);
+        periodicBC->applyMagneticBC(Bhall);
+    }
+
+
+    VecField makeB(std::string name) const
+    {
+        return VecField{layout.allocSize(HybridQuantity::Bx), layout.allocSize(HybridQuantity::By),
+                        layout.allocSize(HybridQuantity::Bz),
+                        {{HybridQuantity::Bx, HybridQuantity::By, HybridQuantity::Bz}}, name};
+    }
+
+
+    std::complex<double> P(VecField const& field, uint32 ix) const
+    {
+        return {field.component(VecField::VecY)(ix), field.component(VecField::VecZ)(ix)};
+    }
+
+
+    // -i dt D P on the physical dual nodes, with periodic neighbours
+    std::vector<std::complex<double>> hallIncrement(std::vector<std::complex<double>> const& p) const
+    {
+        double odx = layout.odx();
+        std::vector<std::complex<double>> increment(nbrNodes);
+
+        for (uint32 k = 0; k < nbrNodes; ++k)
+        {
+            double aLeft  = 1. / Ni(primalStart + k);
+            double aRight = 1. / Ni(primalStart + k + 1);
+
+            std::complex<double> next     = p[(k + 1) % nbrNodes];
+            std::complex<double> previous = p[(k + nbrNodes - 1) % nbrNodes];
+
+            std::complex<double> D
+                = (aRight * (next - p[k]) - aLeft * (p[k] - previous)) * odx * odx;
+            increment[k] = std::complex<double>{0., -dt} * D;
+        }
+        return increment;
+    }
+
+
+    // the explicit Faraday step with the Hall term of Bhall
+    VecField explicitStep() const
+    {
+        VecField Bexplicit = B;
+
+        std::vector<std::complex<double>> pHall(nbrNodes);
+        for (uint32 k = 0; k < nbrNodes; ++k)
+            pHall[k] = P(Bhall, dualStart + k);
+
+        std::vector<std::complex<double>> increment = hallIncrement(pHall);
+        for (uint32 k = 0; k < nbrNodes; ++k)
+        {
+            Bexplicit.component(VecField::VecY)(dualStart + k) += increment[k].real();
+            Bexplicit.component(VecField::VecZ)(dualStart + k) += increment[k].imag();
+        }
+
+        periodicBC->applyMagneticBC(Bexplicit);
+        return Bexplicit;
+    }
+};
+
+
+
+
+TEST_F(SemiImplicitHall1DTest, periodicSolveIsCrankNicolson)
+{
+    VecField Bexplicit = explicitStep();
+    VecField Bnew      = makeB("Bnew");
+
+    semiImplicitHall(B, Bhall, Bexplicit, Ni, true, Bnew);
+
+    std::vector<std::complex<double>> average(nbrNodes);
+    for (uint32 k = 0; k < nbrNodes; ++k)
+        average[k] = 0.5 * (P(B, dualStart + k) + P(Bnew, dualStart + k));
+
+    std::vector<std::complex<double>> expected = hallIncrement(average);
+
+    for (uint32 k = 0; k < nbrNodes; ++k)
+    {
+        std::complex<double> increment = P(Bnew, dualStart + k) - P(B, dualStart + k);
+        EXPECT_NEAR(expected[k].real(), increment.real(), 1e-10);
+        EXPECT_NEAR(expected[k].imag(), increment.imag(), 1e-10);
+    }
+}
+
+
+
+
+TEST_F(SemiImplicitHall1DTest, ghostIncrementsBoundTheNonPeriodicSolve)
+{
+    VecField Bexplicit = explicitStep();
+    VecField periodic  = makeB("periodic");
+
+    semiImplicitHall(B, Bhall, Bexplicit, Ni, true, periodic);
+    periodicBC->applyMagneticBC(periodic);
+
+    // ghost nodes advanced as in the periodic solution
+    for (uint32 iComp = 1; iComp < 3; ++iComp)
+    {
+        Bexplicit.component(iComp)(dualStart - 1) = periodic.component(iComp)(dualStart - 1);
+        Bexplicit.component(iComp)(dualEnd + 1)   = periodic.component(iComp)(dualEnd + 1);
+    }
+
+    VecField nonPeriodic = makeB("nonPeriodic");
+    semiImplicitHall(B, Bhall, Bexplicit, Ni, false, nonPeriodic);
+
+    for (uint32 ix = dualStart; ix <= dualEnd; ++ix)
+    {
+        for (uint32 iComp = 1; iComp < 3; ++iComp)
+        {
+            EXPECT_NEAR(periodic.component(iComp)(ix), nonPeriodic.component(iComp)(ix), 1e-10);
+        }
+    }
+}
+
+
+
+
+TEST_F(SemiImplicitHall1DTest, multiDimensionalLayoutsAreRejected)
+{
+    GridLayout layout2D{{{0.1, 0.1, 0.}}, {{20, 20, 0}}, 2, "yee", Point{0., 0., 0.}, 1};
+
+    EXPECT_THROW(SemiImplicitHall1D(dt, layout2D), std::runtime_error);
+}
@@ -0,0 +1,136 @@
+
+#include <array>
+
+#include "data/Field/field.h"
+#include "data/grid/gridlayout.h"
+#include "data/grid/gridrows.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+
+
+// the derivative of a linear field is its slope, on every physical node. We use
+// more nodes than rowTileSize in the contiguous direction so that rows are split.
+class GridLayoutDerivMultiD : public ::testing::TestWithParam<uint32>
+{
+public:
+    std::array<double, 3> slopes{{0.3, -1.7, 2.5}};
+
+    GridLayout makeLayout() const
+    {
+        uint32 nbDims = GetParam();
+        if (nbDims == 2)
+            return GridLayout{{{0.1, 0.2, 0.}}, {{20, 300, 0}}, 2, "yee", Point{0., 0., 0.}, 1};
+        else
+            return GridLayout{{{0.1, 0.2, 0.3}}, {{12, 14, 150}}, 3, "yee", Point{0., 0., 0.}, 2};
+    }
+
+
+    // coordinate of the node 'index' of 'qty' in the direction 'iDir'
+    static double coordinate(GridLayout const& layout, HybridQuantity qty, uint32 iDir,
+                             uint32 index)
+    {
+        Direction dir = static_cast<Direction>(iDir);
+        double half   = layout.fieldCentering(qty, dir) == QtyCentering::dual ? 0.5 : 0.;
+        int32 shift   = static_cast<int32>(index)
+                      - static_cast<int32>(layout.physicalStartIndex(qty, dir));
+
+        return (shift + half) * layout.dxdydz()[iDir];
+    }
+
+
+    // fill all the nodes of 'field', ghosts included, with sum_i slopes[i] * x_i
+    void fillLinear(GridLayout const& layout, Field& field) const
+    {
+        std::array<uint32, 3> const& shape = field.shape();
+
+        for (uint32 ix = 0; ix < shape[0]; ++ix)
+            for (uint32 iy = 0; iy < shape[1]; ++iy)
+                for (uint32 iz = 0; iz < shape[2]; ++iz)
+                {
+                    std::array<uint32, 3> index{{ix, iy, iz}};
+                    double value = 0.;
+                    for (uint32 iDim = 0; iDim < layout.nbDimensions(); ++iDim)
+                    {
+                        value += slopes[iDim]
+                                 * coordinate(layout, field.hybridQty(), iDim, index[iDim]);
+                    }
+                    field(ix, iy, iz) = value;
+                }
+    }
+};
+
+
+
+TEST_P(GridLayoutDerivMultiD, derivativeOfLinearFieldIsItsSlope)
+{
+    GridLayout layout = makeLayout();
+
+    // a primal (Ez in X and Y) and a dual (Bz in X and Y) operand
+    std::array<HybridQuantity, 2> operands{{HybridQuantity::Ez, HybridQuantity::Bz}};
+
+    for (HybridQuantity qty : operands)
+    {
+        Field operand{layout.allocSize(qty), qty, "operand"};
+        fillLinear(layout, operand);
+
+        for (uint32 iDim = 0; iDim < layout.nbDimensions(); ++iDim)
+        {
+            Direction dir = static_cast<Direction>(iDim);
+
+            // the derivative is centered as the quantity of the derivative centering
+            QtyCentering derCentering = layout.fieldCentering(qty, dir) == QtyCentering::primal
+                                            ? QtyCentering::dual
+                                            : QtyCentering::primal;
+
+            HybridQuantity derQty = qty;
+            bool found            = false;
+            for (HybridQuantity candidate :
+                 {HybridQuantity::Bx, HybridQuantity::By, HybridQuantity::Bz, HybridQuantity::Ex,
+                  HybridQuantity::Ey, HybridQuantity::Ez, HybridQuantity::rho})
+            {
+                bool match = true;
+                for (uint32 jDim = 0; jDim < 3; ++jDim)
+                {
+                    Direction other       = static_cast<Direction>(jDim);
+                    QtyCentering expected = jDim == iDim ? derCentering
+                                                         : layout.fieldCentering(qty, other);
+                    match = match && layout.fieldCentering(candidate, other) == expected;
+                }
+                if (match)
+                {
+                    derQty = candidate;
+                    found  = true;
+                }
+            }
+
+            // no quantity is dual in all directions (dzBz in 3D)
+            if (!found)
+                continue;
+
+            Field derivative{layout.allocSizeDerived(qty, dir), derQty, "derivative"};
+            layout.deriv(operand, dir, derivative);
+
+            // the row derivative must give exactly the same values
+            RowDerivative rowDerivative{layout, qty, dir};
+
+            NodeRange range = physicalNodes(layout, derQty);
+            forEachRow(range, [&](uint32 ix, uint32 iy, uint32 iz, uint32 count) {
+                double rowValues[rowTileSize];
+                rowDerivative(operand, ix, iy, iz, count, rowValues);
+
+                double const* values = &derivative(ix, iy, iz);
+                for (uint32 i = 0; i < count; ++i)
+                {
+                    EXPECT_NEAR(slopes[iDim], values[i], 1e-10);
+                    EXPECT_EQ(values[i], rowValues[i]);
+                }
+            });
+        }
+    }
+}
+
+
+
+INSTANTIATE_TEST_CASE_P(GridLayoutTest, GridLayoutDerivMultiD, ::testing::Values(2u, 3u));
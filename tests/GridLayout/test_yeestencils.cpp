@@ -0,0 +1,161 @@
+
+#include <array>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "data/Field/field.h"
+#include "data/Field/fieldview.h"
+#include "data/grid/gridlayout.h"
+#include "data/grid/yeestencils.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+
+
+// the LinearCombination getters of GridLayout, built from YeeStencils, must
+// follow the Yee rules: a projection averages two nodes in the direction where
+// the centering changes, if that direction is not invariant.
+class YeeStencilsTest : public ::testing::TestWithParam<std::tuple<uint32, uint32>>
+{
+public:
+    uint32 nbDims      = std::get<0>(GetParam());
+    uint32 interpOrder = std::get<1>(GetParam());
+
+    GridLayout layout{{{0.1, nbDims >= 2 ? 0.1 : 0., nbDims == 3 ? 0.1 : 0.}},
+                      {{10, nbDims >= 2 ? 10u : 0u, nbDims == 3 ? 10u : 0u}},
+                      nbDims,
+                      "yee",
+                      Point{0., 0., 0.},
+                      interpOrder};
+
+    // shift of the neighbor used by a projection from a primal to a dual node
+    int32 primalToDual() const { return interpOrder == 3 ? -1 : 1; }
+
+
+    // expected projection changing the centering in the direction 'iDir'
+    LinearCombination expected(uint32 iDir, int32 shift) const
+    {
+        if (iDir >= nbDims)
+            return {WeightPoint{0, 0, 0, 1.}};
+
+        std::array<int32, 3> shifts{{0, 0, 0}};
+        shifts[iDir] = shift;
+
+        return {WeightPoint{0, 0, 0, 0.5}, WeightPoint{shifts[0], shifts[1], shifts[2], 0.5}};
+    }
+
+
+    // Ex projected on the moment node (ix, iy, iz) with the stencils of the layout
+    template<uint32 Dim>
+    double projectExToMoment(Field const& Ex, uint32 ix, uint32 iy, uint32 iz) const
+    {
+        ConstFieldView<Dim> view{Ex};
+
+        switch (interpOrder)
+        {
+            case 1: return project<typename YeeStencils<Dim, 1>::ExToMoment>(view, ix, iy, iz);
+            case 2: return project<typename YeeStencils<Dim, 2>::ExToMoment>(view, ix, iy, iz);
+            case 3: return project<typename YeeStencils<Dim, 3>::ExToMoment>(view, ix, iy, iz);
+            case 4: return project<typename YeeStencils<Dim, 4>::ExToMoment>(view, ix, iy, iz);
+        }
+        throw std::runtime_error("wrong interpolation order");
+    }
+
+
+    static void expectEqual(LinearCombination const& expected, LinearCombination const& actual)
+    {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (uint32 i = 0; i < expected.size(); ++i)
+        {
+            EXPECT_EQ(expected[i].ix, actual[i].ix);
+            EXPECT_EQ(expected[i].iy, actual[i].iy);
+            EXPECT_EQ(expected[i].iz, actual[i].iz);
+            EXPECT_EQ(expected[i].coef, actual[i].coef);
+        }
+    }
+};
+
+
+
+
+TEST_P(YeeStencilsTest, linearCombinationsFollowTheYeeLayout)
+{
+    int32 p2d = primalToDual();
+    int32 d2p = -primalToDual();
+
+    expectEqual(expected(0, p2d), layout.momentsToEx());
+    expectEqual(expected(1, p2d), layout.momentsToEy());
+    expectEqual(expected(2, p2d), layout.momentsToEz());
+
+    expectEqual(expected(2, d2p), layout.BxToEy());
+    expectEqual(expected(1, d2p), layout.BxToEz());
+    expectEqual(expected(2, d2p), layout.ByToEx());
+    expectEqual(expected(0, d2p), layout.ByToEz());
+    expectEqual(expected(1, d2p), layout.BzToEx());
+    expectEqual(expected(0, d2p), layout.BzToEy());
+
+    expectEqual(expected(0, d2p), layout.ExToMoment());
+    expectEqual(expected(1, d2p), layout.EyToMoment());
+    expectEqual(expected(2, d2p), layout.EzToMoment());
+}
+
+
+
+
+TEST_P(YeeStencilsTest, fieldViewAndProjectMatchField)
+{
+    Field field{layout.allocSize(HybridQuantity::Ex), HybridQuantity::Ex, "field"};
+
+    double value = 0.;
+    for (double& node : field)
+        node = value++;
+
+    std::array<uint32, 3> const& shape = field.shape();
+
+    // nodes of Ex that have a neighbor on both sides in every direction
+    std::array<uint32, 3> first{{1, nbDims >= 2 ? 1u : 0u, nbDims == 3 ? 1u : 0u}};
+    std::array<uint32, 3> last{{shape[0] - 2, nbDims >= 2 ? shape[1] - 2 : 0u,
+                                nbDims == 3 ? shape[2] - 2 : 0u}};
+
+    LinearCombination const& ExToMoment = layout.ExToMoment();
+
+    for (uint32 ix = first[0]; ix <= last[0]; ++ix)
+        for (uint32 iy = first[1]; iy <= last[1]; ++iy)
+            for (uint32 iz = first[2]; iz <= last[2]; ++iz)
+            {
+                double expected = 0;
+                for (WeightPoint const& wp : ExToMoment)
+                {
+                    expected += wp.coef * field(ix + wp.ix, iy + wp.iy, iz + wp.iz);
+                }
+
+                double viewValue = 0., projection = 0.;
+
+                switch (nbDims)
+                {
+                    case 1:
+                        viewValue  = ConstFieldView<1>{field}(ix, iy, iz);
+                        projection = projectExToMoment<1>(field, ix, iy, iz);
+                        break;
+                    case 2:
+                        viewValue  = ConstFieldView<2>{field}(ix, iy, iz);
+                        projection = projectExToMoment<2>(field, ix, iy, iz);
+                        break;
+                    case 3:
+                        viewValue  = ConstFieldView<3>{field}(ix, iy, iz);
+                        projection = projectExToMoment<3>(field, ix, iy, iz);
+                        break;
+                }
+
+                EXPECT_EQ(field(ix, iy, iz), viewValue);
+                EXPECT_EQ(expected, projection);
+            }
+}
+
+
+
+INSTANTIATE_TEST_CASE_P(GridLayoutTest, YeeStencilsTest,
+                        ::testing::Combine(::testing::Values(1u, 2u, 3u),
+                                           ::testing::Values(1u, 2u, 3u, 4u)));
@@ -0,0 +1,94 @@
+#include <array>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "data/Plasmas/ions.h"
+#include "data/grid/gridlayout.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+
+
+class IonsMomentsTest : public ::testing::Test
+{
+public:
+    GridLayout layout;
+
+    IonsMomentsTest()
+        : layout{{{0.1, 0., 0.}}, {{20, 0, 0}}, 1, "yee", Point{0., 0., 0.}, 1}
+    {
+    }
+};
+
+
+
+TEST_F(IonsMomentsTest, fusedTotalMomentsMatchThePerSpeciesSums)
+{
+    // six species, so that the fused sweep sums a group of four then a group of two
+    uint32 const nbrSpecies = 6;
+
+    std::unique_ptr<IonsInitializer> initializer{new IonsInitializer{}};
+    for (uint32 iSpe = 0; iSpe < nbrSpecies; ++iSpe)
+    {
+        initializer->particleInitializers.push_back(nullptr);
+        initializer->masses.push_back(1.);
+        initializer->names.push_back("species" + std::to_string(iSpe));
+        initializer->pushIntervals.push_back(1);
+    }
+    initializer->nbrSpecies = nbrSpecies;
+
+    Ions ions{layout, std::move(initializer)};
+
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<double> density{0.5, 2.};
+    std::uniform_real_distribution<double> flux{-2., 2.};
+
+    for (uint32 iSpe = 0; iSpe < nbrSpecies; ++iSpe)
+    {
+        for (double& node : ions.species(iSpe).rho())
+            node = density(generator);
+        for (Field& component : ions.species(iSpe).flux().components())
+            for (double& node : component)
+                node = flux(generator);
+    }
+
+    // reference: the sums over the species in order, node by node
+    uint32 nbrNodes = ions.rho().size();
+    std::vector<double> expectedRho(nbrNodes, 0.);
+    std::array<std::vector<double>, 3> expectedBulkVel;
+
+    for (uint32 iSpe = 0; iSpe < nbrSpecies; ++iSpe)
+    {
+        for (uint32 i = 0; i < nbrNodes; ++i)
+            expectedRho[i] += ions.species(iSpe).rho()(i);
+    }
+
+    for (uint32 iComp = 0; iComp < 3; ++iComp)
+    {
+        expectedBulkVel[iComp].assign(nbrNodes, 0.);
+        for (uint32 iSpe = 0; iSpe < nbrSpecies; ++iSpe)
+        {
+            for (uint32 i = 0; i < nbrNodes; ++i)
+                expectedBulkVel[iComp][i] += ions.species(iSpe).flux(iComp)(i);
+        }
+        for (uint32 i = 0; i < nbrNodes; ++i)
+            expectedBulkVel[iComp][i] /= expectedRho[i];
+    }
+
+    ions.computeDensityAndFlux();
+    ions.divideFluxByDensity();
+
+    EXPECT_THAT(std::vector<double>(ions.rho().begin(), ions.rho().end()),
+                ::testing::ContainerEq(expectedRho));
+
+    for (uint32 iComp = 0; iComp < 3; ++iComp)
+    {
+        Field const& actual = ions.bulkVel(iComp);
+
+        EXPECT_THAT(std::vector<double>(actual.begin(), actual.end()),
+                    ::testing::ContainerEq(expectedBulkVel[iComp]));
+    }
+}
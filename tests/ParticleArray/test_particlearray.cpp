@@ -0,0 +1,155 @@
+
+#include <array>
+#include <vector>
+
+#include "data/Plasmas/particlearray.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+
+
+Particle makeParticle(double seed)
+{
+    Particle particle{seed,
+                      2 * seed,
+                      {{static_cast<int32>(seed), 1, 2}},
+                      {{0.25f, 0.5f, 0.75f}},
+                      {{3 * seed, 4 * seed, 5 * seed}}};
+#ifdef DEBUG_PARTICLE_FIELDS
+    particle.Ex = 6 * seed;
+    particle.Bz = 7 * seed;
+#endif
+    return particle;
+}
+
+
+void expectSameParticle(Particle const& expected, Particle const& actual)
+{
+    EXPECT_EQ(expected.weight, actual.weight);
+    EXPECT_EQ(expected.charge, actual.charge);
+    EXPECT_EQ(expected.icell, actual.icell);
+    EXPECT_EQ(expected.delta, actual.delta);
+    EXPECT_EQ(expected.v, actual.v);
+#ifdef DEBUG_PARTICLE_FIELDS
+    EXPECT_EQ(expected.Ex, actual.Ex);
+    EXPECT_EQ(expected.Bz, actual.Bz);
+#endif
+}
+
+
+
+TEST(ParticleArrayTest, pushedParticleCanBeReadBack)
+{
+    ParticleArray particles;
+    particles.push_back(makeParticle(1.));
+    particles.push_back(makeParticle(2.));
+
+    ASSERT_EQ(2u, particles.size());
+    expectSameParticle(makeParticle(1.), particles[0]);
+    expectSameParticle(makeParticle(2.), particles[1]);
+}
+
+
+
+TEST(ParticleArrayTest, streamsAreContiguousPerAttribute)
+{
+    ParticleArray particles;
+    particles.push_back(makeParticle(1.));
+    particles.push_back(makeParticle(2.));
+
+    EXPECT_THAT(particles.weight(), ::testing::ElementsAre(1., 2.));
+    EXPECT_THAT(particles.icell(0), ::testing::ElementsAre(1, 2));
+    EXPECT_THAT(particles.v(2), ::testing::ElementsAre(5., 10.));
+
+    particles.v(2)[1] = 42.;
+    EXPECT_EQ(42., particles[1].v[2]);
+}
+
+
+
+TEST(ParticleArrayTest, copyParticleAndPopBackRemoveAParticle)
+{
+    ParticleArray particles;
+    for (double seed : {1., 2., 3.})
+        particles.push_back(makeParticle(seed));
+
+    particles.copyParticle(2, 0);
+    particles.pop_back();
+
+    ASSERT_EQ(2u, particles.size());
+    expectSameParticle(makeParticle(3.), particles[0]);
+    expectSameParticle(makeParticle(2.), particles[1]);
+}
+
+
+
+TEST(ParticleArrayTest, appendConcatenatesArrays)
+{
+    ParticleArray particles;
+    ParticleArray others;
+    particles.push_back(makeParticle(1.));
+    others.push_back(makeParticle(2.));
+    others.push_back(makeParticle(3.));
+
+    particles.append(others);
+
+    ASSERT_EQ(3u, particles.size());
+    expectSameParticle(makeParticle(3.), particles[2]);
+}
+
+
+
+TEST(ParticleArrayTest, assignCopiesARangeOfParticles)
+{
+    ParticleArray particles;
+    ParticleArray chunk;
+    for (double seed : {1., 2., 3., 4.})
+        particles.push_back(makeParticle(seed));
+    chunk.push_back(makeParticle(5.));
+
+    chunk.assign(particles, 1, 2);
+
+    ASSERT_EQ(2u, chunk.size());
+    expectSameParticle(makeParticle(2.), chunk[0]);
+    expectSameParticle(makeParticle(3.), chunk[1]);
+}
+
+
+
+TEST(ParticleArrayTest, iterationGivesParticlesInOrder)
+{
+    ParticleArray particles;
+    for (double seed : {1., 2., 3.})
+        particles.push_back(makeParticle(seed));
+
+    std::vector<double> weights;
+    for (Particle const& particle : particles)
+        weights.push_back(particle.weight);
+
+    EXPECT_THAT(weights, ::testing::ElementsAre(1., 2., 3.));
+}
+
+
+
+
+TEST(ParticleArrayTest, removeKeepsTheOrderOfRemainingParticles)
+{
+    ParticleArray particles;
+    for (double seed : {1., 2., 3., 4., 5., 6.})
+        particles.push_back(makeParticle(seed));
+
+    particles.remove({0, 2, 3, 5});
+
+    ASSERT_EQ(2u, particles.size());
+    expectSameParticle(makeParticle(2.), particles[0]);
+    expectSameParticle(makeParticle(5.), particles[1]);
+}
+
+
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
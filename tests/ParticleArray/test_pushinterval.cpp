@@ -0,0 +1,54 @@
+#include <stdexcept>
+
+#include "data/Plasmas/species.h"
+#include "data/grid/gridlayout.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+
+
+class PushIntervalTest : public ::testing::Test
+{
+public:
+    GridLayout layout;
+
+    PushIntervalTest()
+        : layout{{{0.1, 0., 0.}}, {{20, 0, 0}}, 1, "yee", Point{0., 0., 0.}, 1}
+    {
+    }
+};
+
+
+
+TEST_F(PushIntervalTest, momentsAreInterpolatedOverThePushInterval)
+{
+    Species heavy{layout, 16., nullptr, "alphas", 4};
+    ASSERT_EQ(4u, heavy.pushInterval());
+
+    heavy.rho().zero();
+    heavy.flux().zero();
+    heavy.keepStartMoments();
+
+    for (double& node : heavy.rho())
+        node = 2.;
+    for (Field& component : heavy.flux().components())
+        for (double& node : component)
+            node = -1.;
+    heavy.keepEndMoments();
+
+    heavy.interpolateMoments(0.25);
+
+    for (double node : heavy.rho())
+        EXPECT_DOUBLE_EQ(0.5, node);
+    for (Field const& component : heavy.flux().components())
+        for (double node : component)
+            EXPECT_DOUBLE_EQ(-0.25, node);
+}
+
+
+
+TEST_F(PushIntervalTest, pushIntervalMustBePositive)
+{
+    EXPECT_THROW((Species{layout, 16., nullptr, "alphas", 0}), std::runtime_error);
+}
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "data/Plasmas/species.h"
+#include "data/grid/gridlayout.h"
+#include "utilities/particleselector.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+
+
+class SpeciesSortTest : public ::testing::Test
+{
+public:
+    static const uint32 nbrParticles = 1000;
+
+    GridLayout layout;
+    Species species;
+
+    SpeciesSortTest()
+        : layout{{{0.1, 0., 0.}}, {{20, 0, 0}}, 1, "yee", Point{0., 0., 0.}, 1}
+        , species{layout, 1., nullptr, "protons"}
+    {
+        uint32 start = layout.physicalStartIndex(QtyCentering::primal, Direction::X);
+        uint32 end   = layout.physicalEndIndex(QtyCentering::primal, Direction::X);
+
+        std::mt19937 generator{42};
+        std::uniform_int_distribution<int32> node{static_cast<int32>(start),
+                                                  static_cast<int32>(end) - 1};
+
+        // the weight is the initial index of the particle
+        for (uint32 iPart = 0; iPart < nbrParticles; ++iPart)
+        {
+            species.particles().push_back(Particle{static_cast<double>(iPart),
+                                                   1.,
+                                                   {{node(generator), 0, 0}},
+                                                   {{0.5f, 0.f, 0.f}},
+                                                   {{0., 0., 0.}}});
+        }
+    }
+};
+
+const uint32 SpeciesSortTest::nbrParticles;
+
+
+
+TEST_F(SpeciesSortTest, sortIsStableAndByCell)
+{
+    EXPECT_GT(species.particleDisorder(layout), 0.5);
+
+    species.sortParticles(layout);
+    ParticleArray const& particles = species.particles();
+
+    ASSERT_EQ(nbrParticles, particles.size());
+    for (uint32 iPart = 1; iPart < nbrParticles; ++iPart)
+    {
+        int32 previousCell = particles.icell(0)[iPart - 1];
+        int32 cell         = particles.icell(0)[iPart];
+
+        EXPECT_LE(previousCell, cell);
+        if (previousCell == cell)
+        {
+            EXPECT_LT(particles.weight()[iPart - 1], particles.weight()[iPart]);
+        }
+    }
+
+    EXPECT_DOUBLE_EQ(0., species.particleDisorder(layout));
+}
+
+
+
+TEST_F(SpeciesSortTest, cellOffsetsDelimitTheParticlesOfEachCell)
+{
+    species.sortParticles(layout);
+    Species const& sorted              = species;
+    ParticleArray const& particles     = sorted.particles();
+    std::vector<uint32> const& offsets = sorted.cellOffsets();
+
+    uint32 firstCell = layout.ghostStartIndex(QtyCentering::primal, Direction::X);
+
+    ASSERT_FALSE(offsets.empty());
+    EXPECT_EQ(0u, offsets.front());
+    EXPECT_EQ(nbrParticles, offsets.back());
+
+    for (uint32 iCell = 0; iCell + 1 < offsets.size(); ++iCell)
+    {
+        for (uint32 iPart = offsets[iCell]; iPart < offsets[iCell + 1]; ++iPart)
+            EXPECT_EQ(static_cast<int32>(firstCell + iCell), particles.icell(0)[iPart]);
+    }
+}
+
+
+
+TEST_F(SpeciesSortTest, cellOffsetsAreDroppedWhenTheParticlesMayChange)
+{
+    EXPECT_THROW(species.cellOffsets(), std::runtime_error);
+
+    species.sortParticles(layout);
+    EXPECT_TRUE(species.hasCellOffsets());
+
+    species.particles();
+    EXPECT_FALSE(species.hasCellOffsets());
+    EXPECT_THROW(species.cellOffsets(), std::runtime_error);
+}
+
+
+
+TEST_F(SpeciesSortTest, cellIndexFindsAllTheParticlesInABox)
+{
+    Box box{0.53, 1.21};
+    IsInBoxSelector selector{box};
+
+    species.indexParticleCells(layout);
+    ASSERT_TRUE(species.hasCellIndex());
+
+    std::vector<uint32> candidates;
+    species.particlesNearBox(box, layout, candidates);
+
+    EXPECT_TRUE(std::is_sorted(candidates.begin(), candidates.end()));
+    EXPECT_LT(candidates.size(), static_cast<std::size_t>(nbrParticles));
+
+    ParticleArray const& particles = static_cast<Species const&>(species).particles();
+    for (uint32 iPart = 0; iPart < nbrParticles; ++iPart)
+    {
+        if (selector.pick(particles[iPart], layout))
+        {
+            EXPECT_TRUE(std::binary_search(candidates.begin(), candidates.end(), iPart));
+        }
+    }
+
+    // the particles may change through the non-const accessor
+    species.particles();
+    EXPECT_FALSE(species.hasCellIndex());
+}
+
+
+
+
+TEST_F(SpeciesSortTest, particlesVersionOnlyChangesWithTheParticles)
+{
+    Species const& constSpecies = species;
+    uint64 version              = constSpecies.particlesVersion();
+
+    constSpecies.particles();
+    species.indexParticleCells(layout);
+    EXPECT_EQ(version, constSpecies.particlesVersion());
+
+    species.sortParticles(layout);
+    EXPECT_NE(version, constSpecies.particlesVersion());
+
+    version = constSpecies.particlesVersion();
+    species.particles();
+    EXPECT_NE(version, constSpecies.particlesVersion());
+}
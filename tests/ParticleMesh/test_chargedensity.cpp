@@ -0,0 +1,173 @@
+
+#include <array>
+#include <memory>
+#include <random>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "core/Interpolator/interpolator.h"
+#include "core/Interpolator/particlemesh.h"
+#include "data/Plasmas/species.h"
+#include "data/grid/gridlayout.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+
+
+// the particles are deposited by chunks into private moments, which are then
+// summed. We use enough particles to have several chunks, the last one being
+// incomplete, and check that the moments do not depend on the number of
+// threads and are those of a serial deposition, up to round-off errors.
+class ChargeDensityTest : public ::testing::Test
+{
+public:
+    static const uint32 nbrParticles = 40000;
+
+    GridLayout layout;
+    Species species;
+
+    ChargeDensityTest()
+        : layout{{{0.1, 0., 0.}}, {{80, 0, 0}}, 1, "yee", Point{0., 0., 0.}, 1}
+        , species{layout, 1., nullptr, "protons"}
+    {
+        uint32 start = layout.physicalStartIndex(QtyCentering::primal, Direction::X);
+        uint32 end   = layout.physicalEndIndex(QtyCentering::primal, Direction::X);
+
+        std::mt19937 generator{42};
+        std::uniform_real_distribution<double> velocity{-2., 2.};
+        std::uniform_real_distribution<double> weight{0.5, 1.5};
+        std::uniform_real_distribution<float> offset{0.f, 1.f};
+        std::uniform_int_distribution<int32> node{static_cast<int32>(start),
+                                                  static_cast<int32>(end) - 1};
+
+        ParticleArray& particles = species.particles();
+
+        for (uint32 iPart = 0; iPart < nbrParticles; ++iPart)
+        {
+            particles.push_back(Particle{weight(generator),
+                                         1.,
+                                         {{node(generator), 0, 0}},
+                                         {{offset(generator), 0.f, 0.f}},
+                                         {{velocity(generator), velocity(generator),
+                                           velocity(generator)}}});
+        }
+    }
+
+
+    std::array<std::vector<double>, 4> moments() const
+    {
+        std::array<Field const*, 4> fields{
+            {&species.rho(), &species.flux(0), &species.flux(1), &species.flux(2)}};
+
+        std::array<std::vector<double>, 4> values;
+        for (uint32 iMoment = 0; iMoment < 4; ++iMoment)
+            values[iMoment].assign(fields[iMoment]->begin(), fields[iMoment]->end());
+
+        return values;
+    }
+};
+
+
+
+TEST_F(ChargeDensityTest, chunkedDepositionMatchesSerialDeposition)
+{
+    Interpolator<1> interpolator;
+    ParticleArray& particles = species.particles();
+
+    species.resetMoments();
+    for (uint32 iPart = 0; iPart < nbrParticles; ++iPart)
+    {
+        interpolator(particles, iPart, layout.odx(), species.rho(), species.flux(0),
+                     species.flux(1), species.flux(2), Direction::X);
+    }
+    std::array<std::vector<double>, 4> expected = moments();
+
+    computeChargeDensityAndFlux(interpolator, species, layout, particles);
+    std::array<std::vector<double>, 4> actual = moments();
+
+    for (uint32 iMoment = 0; iMoment < 4; ++iMoment)
+    {
+        EXPECT_THAT(actual[iMoment],
+                    ::testing::Pointwise(::testing::DoubleNear(1e-10), expected[iMoment]));
+    }
+}
+
+
+
+TEST_F(ChargeDensityTest, depositsOfAPhaseAddUp)
+{
+    Interpolator<1> interpolator;
+    ParticleArray& particles = species.particles();
+
+    computeChargeDensityAndFlux(interpolator, species, layout, particles);
+    std::array<std::vector<double>, 4> expected = moments();
+
+    uint32 half = nbrParticles / 2;
+    ParticleArray firstHalf;
+    ParticleArray secondHalf;
+    firstHalf.assign(particles, 0, half);
+    secondHalf.assign(particles, half, nbrParticles - half);
+
+    species.startDeposit();
+    depositChargeDensityAndFlux(interpolator, species, layout, firstHalf);
+    depositChargeDensityAndFlux(interpolator, species, layout, secondHalf);
+    species.finishDeposit();
+    std::array<std::vector<double>, 4> actual = moments();
+
+    for (uint32 iMoment = 0; iMoment < 4; ++iMoment)
+    {
+        EXPECT_THAT(actual[iMoment],
+                    ::testing::Pointwise(::testing::DoubleNear(1e-10), expected[iMoment]));
+    }
+}
+
+
+
+#ifdef _OPENMP
+TEST_F(ChargeDensityTest, depositionDoesNotDependOnTheNumberOfThreads)
+{
+    Interpolator<1> interpolator;
+    int nbrThreads = omp_get_max_threads();
+
+    omp_set_num_threads(1);
+    computeChargeDensityAndFlux(interpolator, species, layout, species.particles());
+    std::array<std::vector<double>, 4> expected = moments();
+
+    omp_set_num_threads(4);
+    computeChargeDensityAndFlux(interpolator, species, layout, species.particles());
+    std::array<std::vector<double>, 4> actual = moments();
+
+    omp_set_num_threads(nbrThreads);
+
+    for (uint32 iMoment = 0; iMoment < 4; ++iMoment)
+    {
+        EXPECT_THAT(actual[iMoment], ::testing::ContainerEq(expected[iMoment]));
+    }
+}
+#endif
+
+
+
+TEST_F(ChargeDensityTest, interleavedMomentsAreTheSpeciesMoments)
+{
+    Interpolator<1> interpolator;
+
+    computeChargeDensityAndFlux(interpolator, species, layout, species.particles());
+    std::array<std::vector<double>, 4> expected = moments();
+
+    DepositBuffer buffer;
+    computeInterleavedMoments(interpolator, layout, species.particles(), buffer);
+    std::vector<double> const& interleaved = buffer.moments();
+
+    ASSERT_EQ(4 * expected[0].size(), interleaved.size());
+
+    for (uint32 iMoment = 0; iMoment < 4; ++iMoment)
+    {
+        for (uint32 iNode = 0; iNode < expected[iMoment].size(); ++iNode)
+            EXPECT_EQ(expected[iMoment][iNode], interleaved[4 * iNode + iMoment]);
+    }
+}
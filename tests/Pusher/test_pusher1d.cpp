@@ -28,6 +28,9 @@ void print(Push1dParams const& inputs);
 
 std::unique_ptr<BoundaryCondition> createBoundary(GridLayout const& layout);
 
+void moveParticles(Pusher& pusher, ParticleArray& particles, double mass, VecField const& E,
+                   VecField const& B, uint32 order, BoundaryCondition& bc);
+
 void allocEBVecFields(GridLayout const& layout, std::shared_ptr<VecField>& E_out,
                       std::shared_ptr<VecField>& B_out);
 
@@ -161,10 +164,8 @@ public:
 
         // we compute the time step
 
-        // We need an interpolator
-        std::unique_ptr<Interpolator> interpolator{new Interpolator{layout.order()}};
-
-        std::vector<Particle> particArray{partic};
+        ParticleArray particArray;
+        particArray.push_back(partic);
 
         std::unique_ptr<BoundaryCondition> bc{createBoundary(layout)};
 
@@ -178,9 +179,9 @@ public:
             readFieldsOnTheMesh(inputs, layout, Bfields, ik);
             readFieldsOnTheMesh(inputs, layout, Efields, ik);
 
-            pusher->move(particArray, particArray, mass, Efields, Bfields, *interpolator, *bc);
+            moveParticles(*pusher, particArray, mass, Efields, Bfields, layout.order(), *bc);
 
-            Particle const& iPart = particArray[0];
+            Particle const iPart = particArray[0];
 
             double posx = (iPart.icell[0] + static_cast<double>(iPart.delta[0])) * layout.dx();
 
@@ -222,6 +223,22 @@ std::unique_ptr<BoundaryCondition> createBoundary(GridLayout const& layout)
 }
 
 
+
+// the interpolation order of a test case is only known at runtime
+void moveParticles(Pusher& pusher, ParticleArray& particles, double mass, VecField const& E,
+                   VecField const& B, uint32 order, BoundaryCondition& bc)
+{
+    switch (order)
+    {
+        case 1: pusher.move(particles, particles, mass, E, B, Interpolator<1>{}, bc); break;
+        case 2: pusher.move(particles, particles, mass, E, B, Interpolator<2>{}, bc); break;
+        case 3: pusher.move(particles, particles, mass, E, B, Interpolator<3>{}, bc); break;
+        case 4: pusher.move(particles, particles, mass, E, B, Interpolator<4>{}, bc); break;
+        default: throw std::runtime_error("wrong interpolation order");
+    }
+}
+
+
 void allocEBVecFields(GridLayout const& layout, std::shared_ptr<VecField>& E_out,
                       std::shared_ptr<VecField>& B_out)
 {
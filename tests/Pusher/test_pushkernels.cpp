@@ -0,0 +1,117 @@
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include "core/pusher/pushkernels.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+
+
+// the vectorized kernels must reproduce the scalar kernels exactly. We use a
+// number of particles that is not a multiple of the SIMD width so that the
+// scalar tail of the vectorized kernels is tested as well.
+class PushKernelsTest : public ::testing::TestWithParam<SimdLevel>
+{
+public:
+    static const uint32 nbrParticles = 37;
+
+    std::vector<double> charge;
+    std::array<std::vector<double>, 3> E, B, v;
+    std::vector<float> delta;
+    std::vector<int32> icell;
+
+    PushKernelsTest()
+        : charge(nbrParticles)
+        , delta(nbrParticles)
+        , icell(nbrParticles)
+    {
+        std::mt19937 generator{42};
+        std::uniform_real_distribution<double> field{-2., 2.};
+        std::uniform_real_distribution<float> offset{0.f, 1.f};
+        std::uniform_int_distribution<int32> node{5, 100};
+
+        for (uint32 iComp = 0; iComp < 3; ++iComp)
+        {
+            E[iComp].resize(nbrParticles);
+            B[iComp].resize(nbrParticles);
+            v[iComp].resize(nbrParticles);
+        }
+
+        for (uint32 iPart = 0; iPart < nbrParticles; ++iPart)
+        {
+            charge[iPart] = field(generator);
+            delta[iPart]  = offset(generator);
+            icell[iPart]  = node(generator);
+
+            for (uint32 iComp = 0; iComp < 3; ++iComp)
+            {
+                E[iComp][iPart] = field(generator);
+                B[iComp][iPart] = field(generator);
+                v[iComp][iPart] = field(generator);
+            }
+        }
+    }
+
+
+    void push(BorisKernel kernel, std::array<std::vector<double>, 3>& vOut)
+    {
+        for (uint32 iComp = 0; iComp < 3; ++iComp)
+            vOut[iComp].resize(nbrParticles);
+
+        kernel(nbrParticles, 0.05, charge.data(), {{E[0].data(), E[1].data(), E[2].data()}},
+               {{B[0].data(), B[1].data(), B[2].data()}},
+               {{v[0].data(), v[1].data(), v[2].data()}},
+               {{vOut[0].data(), vOut[1].data(), vOut[2].data()}});
+    }
+};
+
+
+
+TEST_P(PushKernelsTest, advancePositionMatchesScalarKernel)
+{
+    SimdLevel level = GetParam();
+    if (level > detectedSimdLevel())
+        return;
+
+    std::vector<float> expectedDelta(nbrParticles), actualDelta(nbrParticles);
+    std::vector<int32> expectedIcell(nbrParticles), actualIcell(nbrParticles);
+
+    // a large displacement so that particles change cell, in both directions
+    double dto2dl = 1.7;
+
+    advancePositionKernel(SimdLevel::scalar)(nbrParticles, dto2dl, delta.data(), v[0].data(),
+                                             icell.data(), expectedDelta.data(),
+                                             expectedIcell.data());
+    advancePositionKernel(level)(nbrParticles, dto2dl, delta.data(), v[0].data(), icell.data(),
+                                 actualDelta.data(), actualIcell.data());
+
+    EXPECT_THAT(actualDelta, ::testing::ContainerEq(expectedDelta));
+    EXPECT_THAT(actualIcell, ::testing::ContainerEq(expectedIcell));
+}
+
+
+
+TEST_P(PushKernelsTest, borisMatchesScalarKernel)
+{
+    SimdLevel level = GetParam();
+    if (level > detectedSimdLevel())
+        return;
+
+    std::array<std::vector<double>, 3> expectedV, actualV;
+
+    push(borisKernel(SimdLevel::scalar), expectedV);
+    push(borisKernel(level), actualV);
+
+    for (uint32 iComp = 0; iComp < 3; ++iComp)
+    {
+        EXPECT_THAT(actualV[iComp], ::testing::ContainerEq(expectedV[iComp]));
+    }
+}
+
+
+
+INSTANTIATE_TEST_CASE_P(PushKernelsTests, PushKernelsTest,
+                        ::testing::Values(SimdLevel::scalar, SimdLevel::avx2, SimdLevel::avx512));
@@ -0,0 +1,273 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/BoundaryConditions/domainboundarycondition.h"
+#include "core/Solver/solver.h"
+#include "data/Electromag/electromag.h"
+#include "data/Electromag/electromaginitializer.h"
+#include "data/Plasmas/electrons.h"
+#include "data/Plasmas/ions.h"
+#include "data/Plasmas/ionsinitializer.h"
+#include "data/grid/gridlayout.h"
+#include "initializer/initmodel/uniform/uniform_model.h"
+#include "initializer/solverinitializer.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+
+
+/**
+ * @brief HybridRun gathers what PatchData gives to the Solver, on a periodic
+ * domain, with the fields and the particles of a UniformModel
+ */
+struct HybridRun
+{
+    Electromag EMfields;
+    Ions ions;
+    Electrons electrons;
+    DomainBoundaryCondition boundaryCondition;
+    Solver solver;
+
+    static std::vector<DomainBoundaryCondition::BoundaryInfo> periodicBoundaries()
+    {
+        std::vector<DomainBoundaryCondition::BoundaryInfo> boundaries(2);
+
+        boundaries[0].first  = Edge::Xmin;
+        boundaries[1].first  = Edge::Xmax;
+        boundaries[0].second = BoundaryType::Periodic;
+        boundaries[1].second = BoundaryType::Periodic;
+
+        return boundaries;
+    }
+
+    HybridRun(GridLayout const& layout, UniformModel const& model, double dt,
+              std::unique_ptr<IonsInitializer> ionsInitializer,
+              std::unique_ptr<SolverInitializer> solverInitializer)
+        : EMfields{std::unique_ptr<ElectromagInitializer>{
+              new ElectromagInitializer{layout, model.electricFunction(),
+                                        model.magneticFunction(), "_EField", "_BField"}}}
+        , ions{layout, std::move(ionsInitializer)}
+        , electrons{layout, 0.2}
+        , boundaryCondition{layout, periodicBoundaries()}
+        , solver{layout, dt, std::move(solverInitializer)}
+    {
+        ions.loadParticles();
+        solver.init(ions, boundaryCondition);
+    }
+
+    void solveStep() { solver.solveStep(EMfields, ions, electrons, boundaryCondition); }
+};
+
+
+
+
+// a periodic uniform plasma of two identical proton species in a uniform B,
+// on cells wide enough for the time step to resolve the whistlers of the grid
+// scale, which the single push of the moment extrapolation scheme needs
+class SolverTest : public ::testing::Test
+{
+public:
+    static const uint32 nbrCells = 64;
+    static const uint32 nbrSpecies = 2;
+
+    double const dt = 0.01;
+
+    GridLayout layout;
+    UniformModel model;
+
+    SolverTest()
+        : layout{{{0.5, 0., 0.}}, {{nbrCells, 0, 0}}, 1, "yee", Point{0., 0., 0.}, 2}
+        , model{layout}
+    {
+        model.setB0(1., 0., 0.);
+        model.setE0(0., 0., 0.);
+        model.setNbrSpecies(nbrSpecies);
+
+        for (uint32 iSpe = 0; iSpe < nbrSpecies; ++iSpe)
+        {
+            model.setV0(0., 0., 0., iSpe);
+            model.setBeta(1., iSpe);
+            model.setAnisotropy(1., iSpe);
+            model.setBasis(Basis::Cartesian, iSpe);
+            model.setNbrParticlesPerCell(100, iSpe);
+            model.setMass(1., iSpe);
+            model.setCharges(1., iSpe);
+            model.setDensity(0.5, iSpe);
+        }
+    }
+
+    // the particles of the model, with the masses given to the pushers
+    std::unique_ptr<IonsInitializer> ionsInitializer(std::vector<double> const& masses,
+                                                     std::vector<uint32> const& pushIntervals)
+    {
+        std::unique_ptr<IonsInitializer> initializer{new IonsInitializer{}};
+
+        initializer->particleInitializers = model.particleInitializers();
+        initializer->masses               = masses;
+        initializer->pushIntervals        = pushIntervals;
+        initializer->nbrSpecies           = nbrSpecies;
+
+        for (uint32 iSpe = 0; iSpe < nbrSpecies; ++iSpe)
+            initializer->names.push_back("protons" + std::to_string(iSpe));
+
+        return initializer;
+    }
+
+    std::unique_ptr<SolverInitializer> solverInitializer(std::string const& solverType,
+                                                         uint32 fieldSubcycles)
+    {
+        std::unique_ptr<SolverInitializer> initializer{new SolverInitializer{}};
+
+        initializer->pusherType         = "modifiedBoris";
+        initializer->interpolationOrder = 2;
+        initializer->sortEvery          = 0;
+        initializer->sortThreshold      = 0.;
+        initializer->fieldSubcycles     = fieldSubcycles;
+        initializer->predictorChunkSize = 131072;
+        initializer->solverType         = solverType;
+        initializer->fieldSolve         = "explicit";
+
+        return initializer;
+    }
+
+    // largest difference between the nodes of two fields, infinite if one of
+    // them is not finite
+    static double maxDifference(Field const& field, Field const& reference)
+    {
+        double difference = 0.;
+
+        for (uint32 iNode = 0; iNode < field.size(); ++iNode)
+        {
+            if (!std::isfinite(field(iNode)))
+                return std::numeric_limits<double>::infinity();
+
+            difference = std::max(difference, std::abs(field(iNode) - reference(iNode)));
+        }
+
+        return difference;
+    }
+
+    // displacements in cells along X of the particles, which keep their order
+    // in a periodic domain
+    static std::vector<double> displacements(ParticleArray const& before,
+                                             ParticleArray const& after)
+    {
+        std::vector<double> moves(before.size());
+
+        for (uint32 iPart = 0; iPart < before.size(); ++iPart)
+        {
+            double move = (after.icell(0)[iPart] - before.icell(0)[iPart])
+                          + (after.delta(0)[iPart] - before.delta(0)[iPart]);
+
+            if (move > nbrCells / 2.)
+                move -= nbrCells;
+            else if (move < -(nbrCells / 2.))
+                move += nbrCells;
+
+            moves[iPart] = move;
+        }
+
+        return moves;
+    }
+};
+
+const uint32 SolverTest::nbrCells;
+const uint32 SolverTest::nbrSpecies;
+
+
+
+TEST_F(SolverTest, slowSpeciesIsPushedOncePerIntervalWithItsOwnTimeStep)
+{
+    // the species are too heavy for the fields to change their velocities
+    // over a few steps, their displacements only depend on the push time step
+    HybridRun run{layout, model, dt, ionsInitializer({1.e8, 1.e8}, {1, 2}),
+                  solverInitializer("PPC", 1)};
+
+    Ions const& ions = run.ions;
+    ASSERT_EQ(2u, ions.species(1).pushInterval());
+
+    ParticleArray fast = ions.species(0).particles();
+    ParticleArray slow = ions.species(1).particles();
+    ASSERT_EQ(fast.size(), slow.size());
+
+    for (uint32 step = 1; step <= 4; ++step)
+    {
+        run.solveStep();
+
+        std::vector<double> fastMoves = displacements(fast, ions.species(0).particles());
+        std::vector<double> slowMoves = displacements(slow, ions.species(1).particles());
+
+        // pushed over two steps at the first step of each interval, then left
+        // where it is
+        double slowFactor = step % 2 == 1 ? 2. : 0.;
+
+        for (uint32 iPart = 0; iPart < fast.size(); ++iPart)
+            ASSERT_NEAR(slowFactor * fastMoves[iPart], slowMoves[iPart], 1.e-5);
+
+        fast = ions.species(0).particles();
+        slow = ions.species(1).particles();
+    }
+}
+
+
+
+TEST_F(SolverTest, momentExtrapolationStaysCloseToPPC)
+{
+    HybridRun ppc{layout, model, dt, ionsInitializer({1., 1.}, {1, 1}),
+                  solverInitializer("PPC", 1)};
+    HybridRun extrapolation{layout, model, dt, ionsInitializer({1., 1.}, {1, 1}),
+                            solverInitializer("momentExtrapolation", 1)};
+
+    for (uint32 step = 0; step < 50; ++step)
+    {
+        ppc.solveStep();
+        extrapolation.solveStep();
+    }
+
+    // the fluctuations of B and E reach about 0.1 and 0.2
+    for (uint32 iComp = 0; iComp < NBR_COMPO; ++iComp)
+    {
+        EXPECT_LT(maxDifference(extrapolation.EMfields.getBi(iComp), ppc.EMfields.getBi(iComp)),
+                  1.e-2);
+        EXPECT_LT(maxDifference(extrapolation.EMfields.getEi(iComp), ppc.EMfields.getEi(iComp)),
+                  5.e-2);
+    }
+    EXPECT_LT(maxDifference(extrapolation.ions.rho(), ppc.ions.rho()), 5.e-2);
+}
+
+
+
+TEST_F(SolverTest, subcycledFieldsStayCloseToTheUnsubcycledOnes)
+{
+    for (uint32 fieldSubcycles : {2u, 4u})
+    {
+        HybridRun reference{layout, model, dt, ionsInitializer({1., 1.}, {1, 1}),
+                            solverInitializer("PPC", 1)};
+        HybridRun subcycled{layout, model, dt, ionsInitializer({1., 1.}, {1, 1}),
+                            solverInitializer("PPC", fieldSubcycles)};
+
+        for (uint32 step = 0; step < 50; ++step)
+        {
+            reference.solveStep();
+            subcycled.solveStep();
+        }
+
+        // the fluctuations of B and E reach about 0.1 and 0.2
+        for (uint32 iComp = 0; iComp < NBR_COMPO; ++iComp)
+        {
+            EXPECT_LT(maxDifference(subcycled.EMfields.getBi(iComp),
+                                    reference.EMfields.getBi(iComp)),
+                      1.e-2);
+            EXPECT_LT(maxDifference(subcycled.EMfields.getEi(iComp),
+                                    reference.EMfields.getEi(iComp)),
+                      5.e-2);
+        }
+        EXPECT_LT(maxDifference(subcycled.ions.rho(), reference.ions.rho()), 1.e-3);
+    }
+}
@@ -1,6 +1,7 @@
 
 
 
+#include "core/pusher/pusher.h"
 #include "data/Plasmas/ionsinitializer.h"
 #include "data/Plasmas/particleinitializer.h"
 #include "data/Plasmas/particles.h"
@@ -108,7 +109,7 @@ TEST(AsciiInitializerTest, numberOfLoadedParticlesOK)
 
     for (std::size_t i = 0; i < partInits.size(); ++i)
     {
-        std::vector<Particle> particles;
+        ParticleArray particles;
         partInits[i]->loadParticles(particles);
         ASSERT_EQ(nbrPartPerCell * nbCellsTot, particles.size());
     }
@@ -149,6 +150,36 @@ TEST(AsciiInitializerTest, SolverInitializerHasInterpolationOrdersOK)
 
 
 
+TEST(AsciiInitializerTest, SolverInitializerHasNoFieldSubcyclingByDefault)
+{
+    std::unique_ptr<SimulationInitializerFactory> factory{new AsciiInitializerFactory{"phare.ini"}};
+    std::unique_ptr<SolverInitializer> solverInit = factory->createSolverInitializer();
+
+    ASSERT_EQ(1u, solverInit->fieldSubcycles);
+}
+
+
+
+TEST(AsciiInitializerTest, SolverInitializerPredictorChunksAreWholePusherChunks)
+{
+    std::unique_ptr<SimulationInitializerFactory> factory{new AsciiInitializerFactory{"phare.ini"}};
+    std::unique_ptr<SolverInitializer> solverInit = factory->createSolverInitializer();
+
+    ASSERT_EQ(0u, solverInit->predictorChunkSize % Pusher::chunkSize);
+}
+
+
+
+TEST(AsciiInitializerTest, SolverInitializerUsesPPCByDefault)
+{
+    std::unique_ptr<SimulationInitializerFactory> factory{new AsciiInitializerFactory{"phare.ini"}};
+    std::unique_ptr<SolverInitializer> solverInit = factory->createSolverInitializer();
+
+    ASSERT_EQ("PPC", solverInit->solverType);
+}
+
+
+
 
 TEST(AsciiInitializerTest, timeStepIsOK)
 {
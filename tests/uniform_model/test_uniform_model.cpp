@@ -47,22 +47,20 @@ public:
     void setBasis(Basis basis) { model.setBasis(basis, 0); }
 
 
-    std::array<double, 3> get_vth(std::vector<Particle>& particles)
+    std::array<double, 3> get_vth(ParticleArray& particles)
     {
         std::array<double, 3> vth;
 
         for (auto comp = 0u; comp < 3; ++comp)
         {
-            auto vmean = std::accumulate(std::begin(particles), std::end(particles), 0.,
-                                         [comp](double currentMean, Particle const& p) {
-                                             return currentMean + p.v[comp];
-                                         })
-                         / particles.size();
+            std::vector<double> const& v = particles.v(comp);
+
+            auto vmean = std::accumulate(std::begin(v), std::end(v), 0.) / particles.size();
 
 
-            double sqv = std::accumulate(std::begin(particles), std::end(particles), 0.,
-                                         [comp](double val, Particle& p) {
-                                             return val + p.v[comp] * p.v[comp];
+            double sqv = std::accumulate(std::begin(v), std::end(v), 0.,
+                                         [](double val, double vPart) {
+                                             return val + vPart * vPart;
                                          })
                          / particles.size();
 
@@ -103,7 +101,7 @@ TEST_F(TestUniformParticleLoading, anisotropicVth)
     auto expectedVthPara = std::sqrt(traceP / (1. + 2 * aniso));
     auto expectedVthPerp = std::sqrt(aniso * traceP / (1. + 2 * aniso));
 
-    std::vector<Particle> particles;
+    ParticleArray particles;
 
     initializer->loadParticles(particles);
     std::cout << particles[0].v[0] << "\n";
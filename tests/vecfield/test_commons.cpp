@@ -59,25 +59,5 @@ bool isShapeEqual(Field const& expected, Field const& actual);
 
 bool isShapeEqual(Field const& expected, Field const& actual)
 {
-    bool shapeEqual = true;
-
-    std::vector<uint32> expected_shape = expected.shape();
-    std::vector<uint32> actual_shape   = actual.shape();
-
-    if (actual_shape.empty())
-        shapeEqual = false;
-
-    if (expected_shape.size() != actual_shape.size())
-        shapeEqual = false;
-
-    if (shapeEqual)
-    {
-        for (uint32 icompo = 0; icompo < expected_shape.size(); ++icompo)
-        {
-            if (expected_shape[icompo] != actual_shape[icompo])
-                shapeEqual = false;
-        }
-    }
-
-    return shapeEqual;
+    return expected.shape() == actual.shape();
 }
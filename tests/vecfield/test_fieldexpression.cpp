@@ -0,0 +1,122 @@
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "data/Field/fieldexpression.h"
+#include "data/vecfield/vecfieldexpression.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+
+
+// expressions must give exactly the values of the node by node formulas, with
+// the operations done in the same order
+class FieldExpressionTest : public ::testing::Test
+{
+public:
+    AllocSizeT allocSize{40, 1, 1};
+
+    VecField vft1{allocSize, allocSize, allocSize,
+                  {{HybridQuantity::Ex, HybridQuantity::Ey, HybridQuantity::Ez}}, "vft1"};
+    VecField vft2{allocSize, allocSize, allocSize,
+                  {{HybridQuantity::Ex, HybridQuantity::Ey, HybridQuantity::Ez}}, "vft2"};
+    VecField result{allocSize, allocSize, allocSize,
+                    {{HybridQuantity::Ex, HybridQuantity::Ey, HybridQuantity::Ez}}, "result"};
+
+    FieldExpressionTest()
+    {
+        std::mt19937 generator{7};
+        std::uniform_real_distribution<double> values{-3., 3.};
+
+        for (uint32 iComp = 0; iComp < 3; ++iComp)
+        {
+            for (double& value : vft1.component(iComp))
+                value = values(generator);
+            for (double& value : vft2.component(iComp))
+                value = values(generator);
+        }
+    }
+};
+
+
+
+
+TEST_F(FieldExpressionTest, fieldExpressionMatchesNodeByNodeFormula)
+{
+    Field const& f1 = vft1.component(VecField::VecX);
+    Field const& f2 = vft2.component(VecField::VecX);
+    Field& actual   = result.component(VecField::VecX);
+
+    double dt = 0.3, delta = 0.1;
+    actual    = f1 + (f2 - f1) / dt * delta;
+
+    std::vector<double> expected(f1.size());
+    for (uint32 i = 0; i < f1.size(); ++i)
+        expected[i] = f1(i) + (f2(i) - f1(i)) / dt * delta;
+
+    EXPECT_THAT(std::vector<double>(actual.begin(), actual.end()),
+                ::testing::ContainerEq(expected));
+}
+
+
+
+
+TEST_F(FieldExpressionTest, fieldCanAppearInItsOwnExpression)
+{
+    Field& f1       = vft1.component(VecField::VecY);
+    Field const& f2 = vft2.component(VecField::VecY);
+
+    std::vector<double> expected(f1.size());
+    for (uint32 i = 0; i < f1.size(); ++i)
+        expected[i] = 2. * (f1(i) - f2(i));
+
+    f1 = 2. * (f1 - f2);
+
+    EXPECT_THAT(std::vector<double>(f1.begin(), f1.end()), ::testing::ContainerEq(expected));
+}
+
+
+
+
+TEST_F(FieldExpressionTest, fieldExpressionOfDifferentSizeThrows)
+{
+    Field other{AllocSizeT{10, 1, 1}, HybridQuantity::Ex, "other"};
+
+    EXPECT_THROW(other = vft1.component(VecField::VecX) * 2., std::runtime_error);
+}
+
+
+
+
+TEST_F(FieldExpressionTest, operandsOfDifferentSizesThrow)
+{
+    Field other{AllocSizeT{41, 1, 1}, HybridQuantity::Ex, "other"};
+    Field& actual = result.component(VecField::VecX);
+
+    EXPECT_THROW(actual = vft1.component(VecField::VecX) + other, std::runtime_error);
+    EXPECT_THROW(actual = 2. * other - vft1.component(VecField::VecX), std::runtime_error);
+}
+
+
+
+
+TEST_F(FieldExpressionTest, vecFieldExpressionIsEvaluatedOnAllComponents)
+{
+    result = (vft1 + vft2) * 0.5;
+
+    for (uint32 iComp = 0; iComp < 3; ++iComp)
+    {
+        Field const& f1     = vft1.component(iComp);
+        Field const& f2     = vft2.component(iComp);
+        Field const& actual = result.component(iComp);
+
+        std::vector<double> expected(f1.size());
+        for (uint32 i = 0; i < f1.size(); ++i)
+            expected[i] = (f1(i) + f2(i)) * 0.5;
+
+        EXPECT_THAT(std::vector<double>(actual.begin(), actual.end()),
+                    ::testing::ContainerEq(expected));
+    }
+}